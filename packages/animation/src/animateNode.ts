@@ -0,0 +1,270 @@
+/**
+ * animateNode.ts — Native node animations.
+ *
+ * Runs an animation on a node prop inside the C++ AnimationTicker, so
+ * frames never cross into JS. Completions of every native animation in
+ * a frame arrive in one call to a batch dispatcher, installed on first
+ * use, which routes them to the per-animation onFinish handlers here.
+ *
+ * Sequences, parallels, staggers, loops and delays of node animations
+ * are described as a NodeAnimationSpec graph and handed to the ticker
+ * whole by animateComposite(), so steps start on the frame the previous
+ * one ends instead of waiting for a round trip through JS.
+ */
+
+import type { AnimationHandle } from "./animate";
+
+// ---------------------------------------------------------------------------
+// Native API
+// ---------------------------------------------------------------------------
+
+declare function __animateNode(
+  nodeId: number,
+  prop: string,
+  driverType: NativeDriverType,
+  config: NativeAnimationConfig & {
+    onFinish?: (completed: boolean) => void;
+  },
+): number;
+declare function __animateComposite(
+  spec: NodeAnimationSpec,
+  onFinish?: (completed: boolean) => void,
+): number;
+declare function __animateCancel(id: number): void;
+declare function __animateSetBatchDispatcher(
+  dispatch: (events: (number | boolean)[]) => void,
+): void;
+
+export type NativeDriverType = "timing" | "spring" | "decay";
+
+/** Config passed through to __animateNode. */
+export interface NativeAnimationConfig {
+  /** A number, components [x, y, …], or a color string for colors. */
+  toValue?: number | number[] | string;
+  fromValue?: number | number[] | string;
+  duration?: number;
+  /** Name, "cubic-bezier(…)", [x1, y1, x2, y2] or keyframes. */
+  easing?:
+    | string
+    | number[]
+    | { keyframes: [number, number, string?][] };
+  tension?: number;
+  friction?: number;
+  mass?: number;
+  velocity?: number;
+  rate?: number;
+  /** Color props: mix premultiplied sRGB (default) or linear light. */
+  colorSpace?: "premultiplied" | "linear";
+}
+
+/** A node animation graph, as accepted by __animateComposite. */
+export type NodeAnimationSpec =
+  | {
+      type: "animation";
+      node: number;
+      prop: string;
+      driver: NativeDriverType;
+      config: NativeAnimationConfig;
+    }
+  | { type: "sequence" | "parallel"; children: NodeAnimationSpec[] }
+  | { type: "stagger"; delay: number; children: NodeAnimationSpec[] }
+  | { type: "loop"; count?: number; child: NodeAnimationSpec }
+  | { type: "delay"; duration: number };
+
+type NodeRef = number | { cppNodeId?: number };
+
+const hasCppAnimation =
+  typeof (globalThis as any).__animateNode === "function";
+const hasCppComposite =
+  typeof (globalThis as any).__animateComposite === "function";
+
+function resolveNodeId(node: NodeRef): number | undefined {
+  return typeof node === "number" ? node : node.cppNodeId;
+}
+
+// ---------------------------------------------------------------------------
+// Batched completion dispatch
+// ---------------------------------------------------------------------------
+
+// The C++ ticker reports every animation that ended in a frame in one
+// flat [id, finished, id, finished, ...] array.
+const finishHandlers = new Map<number, (completed: boolean) => void>();
+let batchDispatcherInstalled = false;
+
+function installBatchDispatcher(): void {
+  if (batchDispatcherInstalled) return;
+  if (typeof (globalThis as any).__animateSetBatchDispatcher !== "function") {
+    return;
+  }
+  batchDispatcherInstalled = true;
+  __animateSetBatchDispatcher((events) => {
+    for (let i = 0; i + 1 < events.length; i += 2) {
+      const id = events[i] as number;
+      const handler = finishHandlers.get(id);
+      if (handler) {
+        finishHandlers.delete(id);
+        handler(events[i + 1] === true);
+      }
+    }
+  });
+}
+
+// ---------------------------------------------------------------------------
+// animateNode
+// ---------------------------------------------------------------------------
+
+/**
+ * Animate a node prop on the native ticker.
+ *
+ * @param node       The node (its `cppNodeId`) or a native node id.
+ * @param prop       An animatable prop ("opacity", "x", "position", ...).
+ *                   "position" and "translate" take [x, y], "scale"
+ *                   [sx, sy] or one number for both, "transform"
+ *                   [tx, ty, sx, sy, rotation]; a missing component
+ *                   keeps its current value. "backgroundColor",
+ *                   "borderColor" and "color" take color strings.
+ * @param driverType "timing" | "spring" | "decay".
+ * @param config     Driver settings, as accepted by __animateNode.
+ * @param onDone     Optional callback when the animation ends.
+ * @returns An AnimationHandle, or null when the native ticker is missing
+ *          or rejected the animation.
+ *
+ * @example
+ * ```ts
+ * animateNode(view.node, "opacity", "timing", { toValue: 1, duration: 200 })
+ *   ?.onFinish((completed) => console.log('faded in', completed));
+ * ```
+ */
+export function animateNode(
+  node: NodeRef,
+  prop: string,
+  driverType: NativeDriverType,
+  config: NativeAnimationConfig,
+  onDone?: (completed: boolean) => void,
+): AnimationHandle | null {
+  if (!hasCppAnimation) return null;
+  const nodeId = resolveNodeId(node);
+  if (!nodeId) return null;
+
+  return startNative(
+    (onFinish) =>
+      __animateNode(
+        nodeId,
+        prop,
+        driverType,
+        onFinish ? { ...config, onFinish } : config,
+      ),
+    onDone,
+  );
+}
+
+// ---------------------------------------------------------------------------
+// Node animation graphs
+// ---------------------------------------------------------------------------
+
+/** One node prop animation, as a step of a graph. */
+export function nodeAnimation(
+  node: NodeRef,
+  prop: string,
+  driver: NativeDriverType,
+  config: NativeAnimationConfig,
+): NodeAnimationSpec {
+  // A missing node id makes the ticker reject the graph
+  const nodeId = resolveNodeId(node) ?? 0;
+  return { type: "animation", node: nodeId, prop, driver, config };
+}
+
+/** Run steps one after another. */
+export function nodeSequence(steps: NodeAnimationSpec[]): NodeAnimationSpec {
+  return { type: "sequence", children: steps };
+}
+
+/** Run steps together; ends with the longest. */
+export function nodeParallel(steps: NodeAnimationSpec[]): NodeAnimationSpec {
+  return { type: "parallel", children: steps };
+}
+
+/** Run steps together, each starting `delay` ms after the previous one. */
+export function nodeStagger(
+  delay: number,
+  steps: NodeAnimationSpec[],
+): NodeAnimationSpec {
+  return { type: "stagger", delay, children: steps };
+}
+
+/** Repeat a step `count` times, or forever when omitted. */
+export function nodeLoop(
+  step: NodeAnimationSpec,
+  count = -1,
+): NodeAnimationSpec {
+  return { type: "loop", count, child: step };
+}
+
+/** Wait `duration` ms. */
+export function nodeDelay(duration: number): NodeAnimationSpec {
+  return { type: "delay", duration };
+}
+
+/**
+ * Run a node animation graph on the native ticker.
+ *
+ * @param spec   The graph, built with nodeAnimation / nodeSequence / ...
+ * @param onDone Optional callback, called once when the whole graph ends.
+ * @returns An AnimationHandle whose cancel() stops every running step, or
+ *          null when the native ticker is missing or rejected the graph.
+ *
+ * @example
+ * ```ts
+ * animateComposite(
+ *   nodeSequence([
+ *     nodeAnimation(card.node, "opacity", "timing", { toValue: 1, duration: 150 }),
+ *     nodeStagger(40, rows.map((row) =>
+ *       nodeAnimation(row.node, "y", "spring", { toValue: 0 }))),
+ *   ]),
+ * )?.onFinish((completed) => console.log('shown', completed));
+ * ```
+ */
+export function animateComposite(
+  spec: NodeAnimationSpec,
+  onDone?: (completed: boolean) => void,
+): AnimationHandle | null {
+  if (!hasCppComposite) return null;
+  return startNative((onFinish) => __animateComposite(spec, onFinish), onDone);
+}
+
+// ---------------------------------------------------------------------------
+// Handles
+// ---------------------------------------------------------------------------
+
+// Start a native animation or graph and wrap its id in a handle. `start`
+// gets a per-animation onFinish only when no batch dispatcher is present.
+function startNative(
+  start: (onFinish?: (completed: boolean) => void) => number,
+  onDone?: (completed: boolean) => void,
+): AnimationHandle | null {
+  const finishCallbacks: ((completed: boolean) => void)[] = [];
+  if (onDone) finishCallbacks.push(onDone);
+
+  function notifyDone(completed: boolean) {
+    for (let i = 0; i < finishCallbacks.length; i++) {
+      finishCallbacks[i](completed);
+    }
+  }
+
+  // Without a dispatcher, fall back to a per-animation native onFinish
+  installBatchDispatcher();
+  const id = start(batchDispatcherInstalled ? undefined : notifyDone);
+  if (id < 0) return null;
+  if (batchDispatcherInstalled) finishHandlers.set(id, notifyDone);
+
+  const handle: AnimationHandle = {
+    // The ticker reports the cancellation through the dispatcher
+    cancel: () => __animateCancel(id),
+    onFinish(cb: (completed: boolean) => void): AnimationHandle {
+      finishCallbacks.push(cb);
+      return handle;
+    },
+  };
+
+  return handle;
+}
@@ -3,6 +3,9 @@
  *
  * All combinators use the AnimationHandle.onFinish() callback pattern
  * to avoid Hermes fiber/Promise crashes.
+ *
+ * Graphs made only of node animations should go through
+ * animateComposite() instead, which runs every step on the native ticker.
  */
 
 import type { AnimationHandle } from "./animate";
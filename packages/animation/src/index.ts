@@ -18,6 +18,23 @@
 // Core
 export { animate } from "./animate";
 export type { AnimationHandle } from "./animate";
+export {
+  animateNode,
+  animateComposite,
+  nodeAnimation,
+  nodeSequence,
+  nodeParallel,
+  nodeStagger,
+  nodeLoop,
+  nodeDelay,
+} from "./animateNode";
+export { valueGraph, Graph } from "./valueGraph";
+export type { GraphExpr, GraphOutput, ValueGraphHandle } from "./valueGraph";
+export type {
+  NativeDriverType,
+  NativeAnimationConfig,
+  NodeAnimationSpec,
+} from "./animateNode";
 
 // Drivers
 export { withTiming } from "./drivers/timing";
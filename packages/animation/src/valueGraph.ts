@@ -0,0 +1,196 @@
+/**
+ * valueGraph.ts — Native derived values.
+ *
+ * Describes node props as expressions over live native values (scroll
+ * offsets, native animations, shared values, other props). The graph is
+ * compiled once by the C++ ValueGraphRunner and evaluated every frame
+ * after the scroll and animation ticks — no JS runs per frame.
+ *
+ * @example
+ * ```ts
+ * // Header fades out over the first 120pt of scroll, and hides while
+ * // scrolling down (diffClamp)
+ * const y = Graph.scroll(scroll.engineId, "y");
+ * const graph = valueGraph([
+ *   { node: header.node, prop: "opacity",
+ *     value: Graph.interpolate(y, [0, 120], [1, 0], "clamp") },
+ *   { node: header.node, prop: "y",
+ *     value: Graph.multiply(Graph.diffClamp(y, 0, 56), -1) },
+ * ]);
+ * graph?.remove();
+ * ```
+ */
+
+// ---------------------------------------------------------------------------
+// Native API
+// ---------------------------------------------------------------------------
+
+declare function __valueGraphCreate(outputs: NativeGraphOutput[]): number;
+declare function __valueGraphRemove(graphId: number): void;
+
+const hasValueGraph =
+  typeof (globalThis as any).__valueGraphCreate === "function";
+
+// ---------------------------------------------------------------------------
+// Expressions
+// ---------------------------------------------------------------------------
+
+/** A graph expression; a bare number is a constant. */
+export type GraphExpr =
+  | number
+  | { op: "const"; value: number }
+  | {
+      op: "scroll";
+      engine: number;
+      axis: "x" | "y" | "velocityX" | "velocityY";
+    }
+  | { op: "animation"; id: number }
+  | { op: "shared"; slot: number }
+  | { op: "prop"; node: number; prop: string }
+  | {
+      op:
+        | "add"
+        | "sub"
+        | "multiply"
+        | "divide"
+        | "min"
+        | "max"
+        | "modulo"
+        | "greaterThan"
+        | "lessThan"
+        | "cond";
+      args: GraphExpr[];
+    }
+  | {
+      op: "interpolate";
+      input: GraphExpr;
+      inputRange: number[];
+      outputRange: number[];
+      extrapolate?: "extend" | "clamp" | "identity";
+    }
+  | { op: "clamp" | "diffClamp"; input: GraphExpr; min: GraphExpr; max: GraphExpr };
+
+type NodeRef = number | { cppNodeId?: number } | { node: { cppNodeId?: number } };
+
+function nodeIdOf(node: NodeRef): number {
+  if (typeof node === "number") return node;
+  const target = "node" in node ? node.node : node;
+  return target.cppNodeId ?? 0;
+}
+
+/** Expression builders. */
+export const Graph = {
+  scroll: (
+    engine: number,
+    axis: "x" | "y" | "velocityX" | "velocityY" = "y",
+  ): GraphExpr => ({ op: "scroll", engine, axis }),
+  /** A native animation's value; holds the last one once it ends. */
+  animation: (id: number): GraphExpr => ({ op: "animation", id }),
+  /** A shared value slot (SharedValues.slot + index). */
+  shared: (slot: number): GraphExpr => ({ op: "shared", slot }),
+  prop: (node: NodeRef, prop: string): GraphExpr => ({
+    op: "prop",
+    node: nodeIdOf(node),
+    prop,
+  }),
+
+  add: (...args: GraphExpr[]): GraphExpr => ({ op: "add", args }),
+  sub: (a: GraphExpr, b: GraphExpr): GraphExpr => ({ op: "sub", args: [a, b] }),
+  multiply: (...args: GraphExpr[]): GraphExpr => ({ op: "multiply", args }),
+  divide: (a: GraphExpr, b: GraphExpr): GraphExpr => ({
+    op: "divide",
+    args: [a, b],
+  }),
+  min: (...args: GraphExpr[]): GraphExpr => ({ op: "min", args }),
+  max: (...args: GraphExpr[]): GraphExpr => ({ op: "max", args }),
+  /** Result takes the sign of `b`. */
+  modulo: (a: GraphExpr, b: GraphExpr): GraphExpr => ({
+    op: "modulo",
+    args: [a, b],
+  }),
+  greaterThan: (a: GraphExpr, b: GraphExpr): GraphExpr => ({
+    op: "greaterThan",
+    args: [a, b],
+  }),
+  lessThan: (a: GraphExpr, b: GraphExpr): GraphExpr => ({
+    op: "lessThan",
+    args: [a, b],
+  }),
+  /** `whenTrue` if `test` != 0, else `whenFalse`. */
+  cond: (test: GraphExpr, whenTrue: GraphExpr, whenFalse: GraphExpr): GraphExpr => ({
+    op: "cond",
+    args: [test, whenTrue, whenFalse],
+  }),
+
+  interpolate: (
+    input: GraphExpr,
+    inputRange: number[],
+    outputRange: number[],
+    extrapolate: "extend" | "clamp" | "identity" = "extend",
+  ): GraphExpr => ({ op: "interpolate", input, inputRange, outputRange, extrapolate }),
+  clamp: (input: GraphExpr, min: GraphExpr, max: GraphExpr): GraphExpr => ({
+    op: "clamp",
+    input,
+    min,
+    max,
+  }),
+  /** Accumulates input deltas, clamped (collapsing headers). */
+  diffClamp: (input: GraphExpr, min: GraphExpr, max: GraphExpr): GraphExpr => ({
+    op: "diffClamp",
+    input,
+    min,
+    max,
+  }),
+};
+
+// ---------------------------------------------------------------------------
+// valueGraph
+// ---------------------------------------------------------------------------
+
+export interface GraphOutput {
+  /** The node (its `cppNodeId`), a component, or a native node id. */
+  node: NodeRef;
+  /** An animatable prop ("opacity", "x", ...). */
+  prop: string;
+  value: GraphExpr;
+}
+
+interface NativeGraphOutput {
+  node: number;
+  prop: string;
+  value: GraphExpr;
+}
+
+export interface ValueGraphHandle {
+  readonly id: number;
+  /** Stop evaluating; the props keep their last values. */
+  remove(): void;
+}
+
+/**
+ * Drive node props from a native expression graph.
+ *
+ * @returns A handle, or null when the native runner is missing or
+ *          rejected the graph (an unknown node, op or malformed range).
+ */
+export function valueGraph(outputs: GraphOutput[]): ValueGraphHandle | null {
+  if (!hasValueGraph) return null;
+  const native: NativeGraphOutput[] = [];
+  for (const out of outputs) {
+    const node = nodeIdOf(out.node);
+    if (!node) return null;
+    native.push({ node, prop: out.prop, value: out.value });
+  }
+  const id = __valueGraphCreate(native);
+  if (id < 0) return null;
+
+  let removed = false;
+  return {
+    id,
+    remove() {
+      if (removed) return;
+      removed = true;
+      __valueGraphRemove(id);
+    },
+  };
+}
@@ -14,6 +14,9 @@
  * ```
  */
 
+import type { SkiaNode } from "@zilol-native/nodes";
+import { SharedValues, GestureSlot } from "./SharedValues";
+
 // JSI declarations (registered by C++ TouchDispatcher)
 declare function __gestureAttach(nodeId: number, gestureType: string): number;
 declare function __gestureSetCallback(
@@ -26,6 +29,11 @@ declare function __gestureSetConfig(
   key: string,
   value: number,
 ): void;
+declare function __gestureDrive(
+  gestureId: number,
+  nodeId: number,
+  config?: PanDriveConfig,
+): boolean;
 
 // ---------------------------------------------------------------------------
 // Gesture event types
@@ -49,6 +57,31 @@ export interface GestureEvent {
 
 export type GestureCallback = (event: GestureEvent) => void;
 
+/** How a pan drives a node natively. See PanGesture.drive(). */
+export interface PanDriveConfig {
+  /** Which layout axes follow the finger. Default: "both". */
+  axis?: "x" | "y" | "both";
+  minX?: number;
+  maxX?: number;
+  minY?: number;
+  maxY?: number;
+  /** Resist past the bounds instead of clamping. Default: true. */
+  rubberBand?: boolean;
+  /** What happens on release. Default: "spring". */
+  release?: "spring" | "decay" | "none";
+  /** Spring rest point. Default: where the drag began. */
+  restX?: number;
+  restY?: number;
+  /** Spring to the point nearest the projected fling end. */
+  snapX?: number[];
+  snapY?: number[];
+  tension?: number;
+  friction?: number;
+  mass?: number;
+  /** Decay rate per ms. Default: 0.998. */
+  rate?: number;
+}
+
 // ---------------------------------------------------------------------------
 // GestureBuilder base
 // ---------------------------------------------------------------------------
@@ -60,6 +93,8 @@ export class GestureBuilder {
   /** @internal */ _onUpdate?: GestureCallback;
   /** @internal */ _onEnd?: GestureCallback;
   /** @internal */ _config: Record<string, number> = {};
+  /** @internal */ _gestureId = -1;
+  /** @internal */ _shared: SharedValues | null = null;
 
   constructor(type: string) {
     this.gestureType = type;
@@ -80,6 +115,21 @@ export class GestureBuilder {
     return this;
   }
 
+  /**
+   * Shared values the recognizer writes on every event, in the
+   * GestureSlot layout (state, x, y, translation, velocity, scale,
+   * rotation). Reading them needs no onUpdate callback. The caller
+   * releases them; null when shared values are unavailable.
+   */
+  sharedValues(): SharedValues | null {
+    if (this._shared) return this._shared;
+    this._shared = SharedValues.allocate(GestureSlot.count);
+    if (this._shared && this._gestureId >= 0) {
+      this._shared.bindGesture(this._gestureId);
+    }
+    return this._shared;
+  }
+
   /**
    * Attach this gesture to a C++ node, registering callbacks.
    * @internal Called by GestureDetector.
@@ -87,6 +137,8 @@ export class GestureBuilder {
   _attach(cppNodeId: number): void {
     const gid = __gestureAttach(cppNodeId, this.gestureType);
     if (gid < 0) return;
+    this._gestureId = gid;
+    if (this._shared) this._shared.bindGesture(gid);
 
     if (this._onStart) __gestureSetCallback(gid, "onStart", this._onStart);
     if (this._onUpdate) __gestureSetCallback(gid, "onUpdate", this._onUpdate);
@@ -95,7 +147,11 @@ export class GestureBuilder {
     for (const [key, value] of Object.entries(this._config)) {
       __gestureSetConfig(gid, key, value);
     }
+    this._attached();
   }
+
+  /** @internal Hook for subclasses, once the gesture has an id. */
+  _attached(): void {}
 }
 
 // ---------------------------------------------------------------------------
@@ -112,6 +168,49 @@ export class PanGesture extends GestureBuilder {
     this._config.activationThreshold = value;
     return this;
   }
+
+  /**
+   * Velocity estimator used for `velocityX/velocityY`.
+   * "weighted" (default) or "leastSquares" (polynomial fit, smoother fling).
+   */
+  velocityEstimator(value: "weighted" | "leastSquares"): this {
+    this._config.velocityEstimator = value === "leastSquares" ? 1 : 0;
+    return this;
+  }
+
+  /** @internal */ _driveNodeId = 0;
+  /** @internal */ _driveConfig: PanDriveConfig | null = null;
+
+  /**
+   * Move `target`'s layout x/y with the pan translation natively, and
+   * release into a spring or decay — no JS runs per move or on release.
+   * Callbacks still fire. Pass null to stop driving.
+   *
+   * @example
+   * ```ts
+   * const card = View().size(200, 120);
+   * const pan = Gesture.Pan().drive(card, { release: "spring" });
+   * GestureDetector(card, pan);
+   * ```
+   */
+  drive(
+    target: SkiaNode | { node: SkiaNode } | null,
+    config: PanDriveConfig = {},
+  ): this {
+    const node = target && ("node" in target ? target.node : target);
+    this._driveNodeId = node ? ((node as any).cppNodeId ?? 0) : 0;
+    this._driveConfig = this._driveNodeId ? config : null;
+    if (this._gestureId < 0) return this;
+    if (this._driveConfig) this._attached();
+    else __gestureDrive(this._gestureId, 0);
+    return this;
+  }
+
+  /** @internal */
+  _attached(): void {
+    if (!this._driveConfig) return;
+    __gestureDrive(this._gestureId, this._driveNodeId, this._driveConfig);
+  }
 }
 
 export class PinchGesture extends GestureBuilder {
@@ -8,9 +8,10 @@
  *  - Bounce-back spring to boundaries (in C++)
  *  - Snap-to-interval and paging (in C++)
  *  - Scroll events (onScroll, onScrollEnd) via JS callbacks
+ *  - Offset, velocity and phase in shared values, read synchronously
  *
  * All physics runs in C++ — JS only receives onScroll/onScrollEnd
- * callbacks when the offset changes.
+ * callbacks when the offset changes, or reads `sharedValues()`.
  *
  * @example
  * ```ts
@@ -26,17 +27,19 @@
  */
 
 import { createScrollNode } from "@zilol-native/nodes";
-import { effect } from "@zilol-native/runtime";
+import { effect, onCleanup } from "@zilol-native/runtime";
 import type { SkiaNode, BorderRadius, ShadowProps } from "@zilol-native/nodes";
 import { ComponentBase } from "./ComponentBase";
 import { resolveNode } from "./types";
 import type { ComponentChild } from "./types";
+import { SharedValues, ScrollSlot } from "./SharedValues";
 
 // ---------------------------------------------------------------------------
 // C++ scroll engine bridge (JSI globals)
 // ---------------------------------------------------------------------------
 
 declare function __scrollCreate(nodeId: number): number;
+declare function __scrollDestroy(engineId: number): void;
 declare function __scrollTouch(
   engineId: number,
   phase: number,
@@ -58,12 +61,124 @@ declare function __scrollSetConfig(
 ): void;
 declare function __scrollSetCallbacks(
   engineId: number,
-  onScroll: ((x: number, y: number) => void) | null,
+  onScroll:
+    | ((x: number, y: number, velocityX: number, velocityY: number) => void)
+    | null,
   onScrollEnd: ((x: number, y: number) => void) | null,
 ): void;
+declare function __scrollBind(
+  engineId: number,
+  nodeId: number,
+  prop: string,
+  inputRange: number[],
+  outputRange: number[],
+  extrapolate?: "extend" | "clamp" | "identity",
+): number;
+declare function __scrollUnbind(engineId: number, bindingId: number): void;
+declare function __scrollSetStickyHeaders(
+  engineId: number,
+  childIndices: number[],
+): void;
+declare function __scrollSetBatchDispatcher(
+  dispatch: (events: number[]) => void,
+): void;
+
+declare function __scrollSetItemExtents(
+  engineId: number,
+  extents: number | number[],
+  count?: number,
+  leadingOffset?: number,
+): void;
+declare function __scrollSetItemExtent(
+  engineId: number,
+  index: number,
+  extent: number,
+): void;
+declare function __scrollLink(engineId: number, parentEngineId: number): void;
+declare function __scrollSetWindowCallback(
+  engineId: number,
+  overscan: number,
+  callback: (
+    first: number,
+    last: number,
+    entered: [number, number][],
+    left: [number, number][],
+  ) => void,
+): void;
+
+/** Rendered item window of a virtualized ScrollView (inclusive ranges). */
+export interface ScrollWindowChange {
+  first: number;
+  last: number;
+  entered: [number, number][];
+  left: [number, number][];
+}
 
 const hasCppScroll = typeof (globalThis as any).__scrollCreate === "function";
 
+/** Handle to a scroll-linked prop binding created by ScrollView.bind(). */
+export interface ScrollBinding {
+  /** Native binding id; -1 when none was created or after unbind(). */
+  readonly id: number;
+  /** Stop driving the prop. Safe to call more than once. */
+  unbind(): void;
+}
+
+/** Scroll event payload — offset in points, velocity in points/sec. */
+export interface ScrollEvent {
+  x: number;
+  y: number;
+  velocityX: number;
+  velocityY: number;
+}
+
+// ---------------------------------------------------------------------------
+// Batched onScroll dispatch
+// ---------------------------------------------------------------------------
+
+// The C++ ScrollEngineManager coalesces onScroll to one event per engine
+// per frame and delivers all of them in a single call to this dispatcher.
+const scrollHandlers = new Map<number, (event: ScrollEvent) => void>();
+let batchDispatcherInstalled = false;
+
+function installBatchDispatcher(): void {
+  if (batchDispatcherInstalled) return;
+  if (typeof (globalThis as any).__scrollSetBatchDispatcher !== "function") {
+    return;
+  }
+  batchDispatcherInstalled = true;
+  __scrollSetBatchDispatcher((events) => {
+    for (let i = 0; i + 4 < events.length; i += 5) {
+      const handler = scrollHandlers.get(events[i]);
+      if (handler) {
+        handler({
+          x: events[i + 1],
+          y: events[i + 2],
+          velocityX: events[i + 3],
+          velocityY: events[i + 4],
+        });
+      }
+    }
+  });
+}
+
+// ---------------------------------------------------------------------------
+// Nested scrolling
+// ---------------------------------------------------------------------------
+
+// Engine ids are stashed on their nodes so a nested ScrollView can find the
+// nearest enclosing engine. The link is refreshed on every touch start, so
+// re-parenting needs no extra bookkeeping.
+function nearestScrollEngine(node: SkiaNode): number {
+  let current = node.parent;
+  while (current) {
+    const eid = (current as any)._scrollEngineId;
+    if (eid) return eid;
+    current = current.parent;
+  }
+  return 0;
+}
+
 // ---------------------------------------------------------------------------
 // Reactive setter helper
 // ---------------------------------------------------------------------------
@@ -88,6 +203,12 @@ function setProp(node: SkiaNode, key: string, value: unknown): void {
 export class ScrollViewBuilder extends ComponentBase {
   readonly node: SkiaNode;
   private _scrollEngineId: number = 0;
+  private _shared: SharedValues | null = null;
+
+  /** The native ScrollEngine id (0 without one), for value graphs. */
+  get engineId(): number {
+    return this._scrollEngineId;
+  }
 
   constructor(children: ComponentChild[]) {
     super();
@@ -106,7 +227,12 @@ export class ScrollViewBuilder extends ComponentBase {
 
       // Wire touch events → C++ scroll engine
       const eid = this._scrollEngineId;
+      const node = this.node;
+      (node as any)._scrollEngineId = eid;
       this.node.props.onTouchStart = (e: any) => {
+        if (typeof (globalThis as any).__scrollLink === "function") {
+          __scrollLink(eid, nearestScrollEngine(node));
+        }
         __scrollTouch(eid, 0, e.x, e.y, e.timestamp, e.pointerId);
       };
       this.node.props.onTouchMove = (e: any) => {
@@ -115,6 +241,17 @@ export class ScrollViewBuilder extends ComponentBase {
       this.node.props.onTouchEnd = (e: any) => {
         __scrollTouch(eid, 2, e.x, e.y, e.timestamp, e.pointerId);
       };
+
+      // Release the engine (and the JS callbacks it holds) with the scope
+      onCleanup(() => {
+        scrollHandlers.delete(eid);
+        this._shared?.release();
+        this._shared = null;
+        (node as any)._scrollEngineId = 0;
+        if (typeof (globalThis as any).__scrollDestroy === "function") {
+          __scrollDestroy(eid);
+        }
+      });
     }
   }
 
@@ -146,6 +283,46 @@ export class ScrollViewBuilder extends ComponentBase {
     return this;
   }
 
+  /** Scroll both axes together (photo viewers, maps, spreadsheets). */
+  freeScroll(enabled: boolean = true): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetConfig(this._scrollEngineId, "freeScroll", enabled);
+    }
+    return this;
+  }
+
+  /**
+   * Pinch-to-zoom between these scales (free scroll only). The content
+   * scales about the fingers' midpoint and rubber-bands past the limits.
+   */
+  zoomRange(minimumZoomScale: number, maximumZoomScale: number): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetConfig(this._scrollEngineId, "minimumZoomScale", minimumZoomScale);
+      __scrollSetConfig(this._scrollEngineId, "maximumZoomScale", maximumZoomScale);
+    }
+    return this;
+  }
+
+  /** Zoom to this scale about the viewport center, within zoomRange. */
+  zoomScale(scale: number): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetConfig(this._scrollEngineId, "zoomScale", scale);
+    }
+    return this;
+  }
+
+  /**
+   * Pin the children at these indices to the top (or leading edge) while
+   * scrolling, each pushed off by the next. Runs natively per frame.
+   * Call again after the children change.
+   */
+  stickyHeaderIndices(indices: number[]): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetStickyHeaders(this._scrollEngineId, indices);
+    }
+    return this;
+  }
+
   showsScrollIndicator(value: Val<boolean> = true): this {
     setProp(this.node, "showsScrollIndicator", value);
     return this;
@@ -185,6 +362,17 @@ export class ScrollViewBuilder extends ComponentBase {
     return this;
   }
 
+  /**
+   * Fling velocity estimator. "weighted" (default) or "leastSquares"
+   * (polynomial fit over the last 150ms of touch samples).
+   */
+  velocityEstimator(value: "weighted" | "leastSquares"): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetConfig(this._scrollEngineId, "velocityEstimator", value);
+    }
+    return this;
+  }
+
   scrollEnabled(value: Val<boolean> = true): this {
     setProp(this.node, "scrollEnabled", value);
     if (hasCppScroll && this._scrollEngineId) {
@@ -213,18 +401,50 @@ export class ScrollViewBuilder extends ComponentBase {
   // Scroll event callbacks
   // -----------------------------------------------------------------------
 
-  onScroll(handler: (offset: { x: number; y: number }) => void): this {
+  /**
+   * Called at most once per frame with the latest offset and velocity.
+   * Use `scrollEventThrottle` to deliver less often.
+   */
+  onScroll(handler: (event: ScrollEvent) => void): this {
     this.node.setProp("onScroll", handler);
     if (hasCppScroll && this._scrollEngineId) {
+      installBatchDispatcher();
+      scrollHandlers.set(this._scrollEngineId, handler);
       __scrollSetCallbacks(
         this._scrollEngineId,
-        (x, y) => handler({ x, y }),
+        (x, y, velocityX, velocityY) =>
+          handler({ x, y, velocityX, velocityY }),
         null,
       );
     }
     return this;
   }
 
+  /**
+   * Shared values the scroll engine writes every frame, in the ScrollSlot
+   * layout (offsetX, offsetY, velocityX, velocityY, phase). Reading them
+   * needs no onScroll callback. Released with the ScrollView; null when
+   * the native engine or shared values are unavailable.
+   */
+  sharedValues(): SharedValues | null {
+    if (this._shared || !this._scrollEngineId) return this._shared;
+    const shared = SharedValues.allocate(ScrollSlot.count);
+    if (shared && !shared.bindScroll(this._scrollEngineId)) {
+      shared.release();
+      return null;
+    }
+    this._shared = shared;
+    return shared;
+  }
+
+  /** Minimum interval (ms) between onScroll events. Default: 0 (every frame). */
+  scrollEventThrottle(ms: number): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetConfig(this._scrollEngineId, "scrollEventThrottle", ms);
+    }
+    return this;
+  }
+
   onScrollEnd(handler: (offset: { x: number; y: number }) => void): this {
     this.node.setProp("onScrollEnd", handler);
     if (hasCppScroll && this._scrollEngineId) {
@@ -245,6 +465,105 @@ export class ScrollViewBuilder extends ComponentBase {
     return this;
   }
 
+  // -----------------------------------------------------------------------
+  // Scroll-linked props
+  // -----------------------------------------------------------------------
+
+  /**
+   * Drive a node prop from this ScrollView's offset, natively on every
+   * scroll frame (no JS round trip). The offset along the scroll axis is
+   * mapped through inputRange → outputRange.
+   *
+   * @example
+   * ```ts
+   * // Collapsing header: fade out over the first 120pt of scroll
+   * const fade = scroll.bind(header, "opacity", [0, 120], [1, 0], "clamp");
+   * // …
+   * fade.unbind();
+   * ```
+   *
+   * The binding is also dropped natively when its target node is removed
+   * from the tree, and with the ScrollView.
+   */
+  bind(
+    target: SkiaNode | { node: SkiaNode },
+    prop: string,
+    inputRange: number[],
+    outputRange: number[],
+    extrapolate: "extend" | "clamp" | "identity" = "extend",
+  ): ScrollBinding {
+    const node = "node" in target ? target.node : target;
+    const nodeId = (node as any).cppNodeId;
+    const engineId = this._scrollEngineId;
+    let id = -1;
+    if (hasCppScroll && engineId && nodeId) {
+      id = __scrollBind(
+        engineId,
+        nodeId,
+        prop,
+        inputRange,
+        outputRange,
+        extrapolate,
+      );
+    }
+    return {
+      get id() {
+        return id;
+      },
+      unbind: () => {
+        if (id < 0) return;
+        __scrollUnbind(engineId, id);
+        id = -1;
+      },
+    };
+  }
+
+  // -----------------------------------------------------------------------
+  // Virtualization
+  // -----------------------------------------------------------------------
+
+  /**
+   * Let the C++ ScrollEngine compute the visible item window natively.
+   * `handler` runs only when the rendered window (visible + overscan)
+   * changes, with the ranges that entered and left.
+   *
+   * @param itemExtent - Uniform item size, or per-item sizes
+   * @param count - Item count (required when itemExtent is a number)
+   */
+  virtualize(
+    options: {
+      itemExtent: number | number[];
+      count?: number;
+      overscan?: number;
+      leadingOffset?: number;
+    },
+    handler: (change: ScrollWindowChange) => void,
+  ): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetItemExtents(
+        this._scrollEngineId,
+        options.itemExtent,
+        options.count ?? 0,
+        options.leadingOffset ?? 0,
+      );
+      __scrollSetWindowCallback(
+        this._scrollEngineId,
+        options.overscan ?? 5,
+        (first, last, entered, left) =>
+          handler({ first, last, entered, left }),
+      );
+    }
+    return this;
+  }
+
+  /** Update one item's size after it has been measured. */
+  setItemExtent(index: number, extent: number): this {
+    if (hasCppScroll && this._scrollEngineId) {
+      __scrollSetItemExtent(this._scrollEngineId, index, extent);
+    }
+    return this;
+  }
+
   // -----------------------------------------------------------------------
   // Programmatic scrolling
   // -----------------------------------------------------------------------
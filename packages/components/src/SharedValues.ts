@@ -0,0 +1,130 @@
+/**
+ * SharedValues.ts — Native float slots readable synchronously from JS.
+ *
+ * A run of slots in the C++ SharedValueStore. Native writers (scroll
+ * engines, gesture recognizers, animations) store into it as they run,
+ * so reading their latest state is one typed-array read — no callback,
+ * no host call and no per-frame message. JS writes land in the same
+ * slots and are read by native code on its next tick.
+ *
+ * @example
+ * ```ts
+ * const scroll = ScrollView(...).sharedValues();
+ * const y = scroll?.get(ScrollSlot.offsetY) ?? 0;
+ * ```
+ */
+
+// JSI declarations (registered by C++ SharedValueStore)
+// A Float32Array over the native block itself
+declare const __sharedValues: Float32Array;
+declare function __sharedValueAllocate(count: number, initial?: number): number;
+declare function __sharedValueRelease(slot: number): void;
+declare function __sharedValueBindAnimation(animId: number, slot: number): boolean;
+declare function __sharedValueBindScroll(engineId: number, slot: number): boolean;
+declare function __sharedValueBindGesture(gestureId: number, slot: number): boolean;
+
+const hasSharedValues =
+  typeof (globalThis as any).__sharedValueAllocate === "function";
+
+// ---------------------------------------------------------------------------
+// Slot layouts written by native sources
+// ---------------------------------------------------------------------------
+
+/** Offsets within a scroll engine's run (SCROLL_SHARED_SLOTS). */
+export const ScrollSlot = {
+  offsetX: 0,
+  offsetY: 1,
+  velocityX: 2,
+  velocityY: 3,
+  phase: 4,
+  zoomScale: 5,
+  count: 6,
+} as const;
+
+/** Values of the ScrollSlot.phase slot (ScrollPhase). */
+export const ScrollPhaseValue = {
+  idle: 0,
+  dragging: 1,
+  decelerating: 2,
+  bouncing: 3,
+  snapping: 4,
+} as const;
+
+/** Offsets within a gesture recognizer's run (GESTURE_SHARED_SLOTS). */
+export const GestureSlot = {
+  state: 0,
+  x: 1,
+  y: 2,
+  translationX: 3,
+  translationY: 4,
+  velocityX: 5,
+  velocityY: 6,
+  scale: 7,
+  rotation: 8,
+  count: 9,
+} as const;
+
+/** Values of the GestureSlot.state slot (GestureState). */
+export const GestureStateValue = {
+  possible: 0,
+  began: 1,
+  changed: 2,
+  ended: 3,
+  cancelled: 4,
+  failed: 5,
+} as const;
+
+// ---------------------------------------------------------------------------
+// SharedValues
+// ---------------------------------------------------------------------------
+
+export class SharedValues {
+  /** First slot of the run in __sharedValues. */
+  readonly slot: number;
+  readonly length: number;
+  private _released = false;
+
+  private constructor(slot: number, length: number) {
+    this.slot = slot;
+    this.length = length;
+  }
+
+  /** Reserve `count` slots set to `initial`; null if unavailable or full. */
+  static allocate(count: number, initial = 0): SharedValues | null {
+    if (!hasSharedValues) return null;
+    const slot = __sharedValueAllocate(count, initial);
+    return slot < 0 ? null : new SharedValues(slot, count);
+  }
+
+  get(index = 0): number {
+    if (this._released || index < 0 || index >= this.length) return 0;
+    return __sharedValues[this.slot + index];
+  }
+
+  set(value: number, index = 0): void {
+    if (this._released || index < 0 || index >= this.length) return;
+    __sharedValues[this.slot + index] = value;
+  }
+
+  /** Mirror a running native animation's value into slot `index`. */
+  bindAnimation(animId: number, index = 0): boolean {
+    return !this._released && __sharedValueBindAnimation(animId, this.slot + index);
+  }
+
+  /** Have a scroll engine write its ScrollSlot layout here. */
+  bindScroll(engineId: number): boolean {
+    return !this._released && __sharedValueBindScroll(engineId, this.slot);
+  }
+
+  /** Have a gesture recognizer write its GestureSlot layout here. */
+  bindGesture(gestureId: number): boolean {
+    return !this._released && __sharedValueBindGesture(gestureId, this.slot);
+  }
+
+  /** Free the run; its native writers stop writing. */
+  release(): void {
+    if (this._released) return;
+    this._released = true;
+    __sharedValueRelease(this.slot);
+  }
+}
@@ -44,6 +44,7 @@ export { Text, TextBuilder } from "./Text";
 export { Pressable, PressableBuilder } from "./Pressable";
 export { Image, ImageBuilder } from "./Image";
 export { ScrollView, ScrollViewBuilder } from "./ScrollView";
+export type { ScrollBinding } from "./ScrollView";
 export {
   Gesture,
   GestureBuilder,
@@ -52,8 +53,15 @@ export {
   RotationGesture,
   TapGesture,
 } from "./Gesture";
-export type { GestureEvent, GestureCallback } from "./Gesture";
+export type { GestureEvent, GestureCallback, PanDriveConfig } from "./Gesture";
 export { GestureDetector } from "./GestureDetector";
+export {
+  SharedValues,
+  ScrollSlot,
+  ScrollPhaseValue,
+  GestureSlot,
+  GestureStateValue,
+} from "./SharedValues";
 export {
   ActivityIndicator,
   ActivityIndicatorBuilder,
@@ -0,0 +1,177 @@
+// Batched completion delivery: everything that ends in a frame reaches
+// the batch dispatcher in one flat [id, finished, …] call, composition
+// steps stay internal, and a throwing callback never stops the rest.
+
+#include "Check.h"
+#include "animation/AnimationTicker.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+namespace jsi = facebook::jsi;
+
+static jsi::Runtime rt;
+
+using Events = std::vector<std::pair<int, bool>>;
+
+/// A JS batch dispatcher that records every call as (id, finished)
+/// pairs, sorted by id: the order within a frame is unspecified.
+struct DispatchLog {
+    std::vector<Events> calls;
+
+    std::shared_ptr<jsi::Function> dispatcher() {
+        return std::make_shared<jsi::Function>(jsi::Function::createFromHostFunction(
+            rt, jsi::PropNameID::forAscii(rt, "dispatch"), 1,
+            [this](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *args, size_t) {
+                auto events = args[0].asObject(rt).asArray(rt);
+                size_t n = events.size(rt);
+                CHECK(n % 2 == 0);
+                Events call;
+                for (size_t i = 0; i + 1 < n; i += 2) {
+                    call.push_back({static_cast<int>(events.getValueAtIndex(rt, i).asNumber()),
+                                    events.getValueAtIndex(rt, i + 1).getBool()});
+                }
+                std::sort(call.begin(), call.end());
+                calls.push_back(std::move(call));
+                return jsi::Value::undefined();
+            }));
+    }
+};
+
+static std::shared_ptr<jsi::Function> hostFunction(
+    std::function<void(const jsi::Value *)> body) {
+    return std::make_shared<jsi::Function>(jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, "onFinish"), 1,
+        [body](jsi::Runtime &, const jsi::Value &, const jsi::Value *args, size_t) {
+            body(args);
+            return jsi::Value::undefined();
+        }));
+}
+
+static Animation opacityTo(skia::SkiaNode *node, float to, float duration) {
+    Animation anim;
+    anim.node = node;
+    anim.prop = PropId::Opacity;
+    anim.toValue = to;
+    anim.duration = duration;
+    anim.easing = easeLinear;
+    return anim;
+}
+
+TEST(oneDispatcherCallPerFrame) {
+    std::vector<skia::SkiaNode> nodes(40);
+    AnimationTicker ticker;
+    DispatchLog log;
+    ticker.setBatchDispatcher(log.dispatcher());
+
+    std::vector<int> ids;
+    for (auto &node : nodes) ids.push_back(ticker.start(opacityTo(&node, 0, 100)));
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(50, &rt);
+    CHECK(log.calls.empty());
+
+    ticker.tickAll(100, &rt);
+    CHECK(log.calls.size() == 1);
+    CHECK(log.calls[0].size() == ids.size());
+    for (size_t i = 0; i < ids.size() && i < log.calls[0].size(); i++) {
+        CHECK(log.calls[0][i].first == ids[i]);
+        CHECK(log.calls[0][i].second);
+    }
+
+    // Nothing ended: no call
+    ticker.tickAll(116, &rt);
+    CHECK(log.calls.size() == 1);
+    CHECK(!ticker.hasActive());
+}
+
+TEST(cancelledAnimationsReportFalse) {
+    skia::SkiaNode a, b, c;
+    AnimationTicker ticker;
+    DispatchLog log;
+    ticker.setBatchDispatcher(log.dispatcher());
+
+    int ida = ticker.start(opacityTo(&a, 0, 100));
+    int idb = ticker.start(opacityTo(&b, 0, 50));
+    int idc = ticker.start(opacityTo(&c, 0, 200));
+    ticker.tickAll(0, &rt);
+    ticker.cancel(ida);
+    ticker.tickAll(50, &rt); // b ends in the same frame a was cancelled
+    ticker.cancel(idc);
+    ticker.tickAll(66, &rt);
+
+    CHECK(log.calls.size() == 2);
+    CHECK((log.calls[0] == Events{{ida, false}, {idb, true}}));
+    CHECK((log.calls[1] == Events{{idc, false}}));
+}
+
+TEST(compositionStepsAreNotReported) {
+    skia::SkiaNode a, b, solo;
+    AnimationTicker ticker;
+    DispatchLog log;
+    ticker.setBatchDispatcher(log.dispatcher());
+
+    Composition comp;
+    int seq = comp.addGroup(CompositionStep::Sequence);
+    comp.addAnimation(opacityTo(&a, 0, 50), false, seq);
+    comp.addAnimation(opacityTo(&b, 0, 50), false, seq);
+    int graph = ticker.startComposition(std::move(comp));
+    int single = ticker.start(opacityTo(&solo, 0, 100));
+
+    // The first step ends at 50 ms: only the graph may ever be reported
+    for (float t = 0; t <= 100; t += 10) ticker.tickAll(t, &rt);
+    CHECK(log.calls.size() == 1);
+    CHECK((log.calls[0] == Events{{graph, true}, {single, true}}));
+}
+
+TEST(dispatcherRunsBeforeTheOnFinishCallbacks) {
+    skia::SkiaNode a, b;
+    AnimationTicker ticker;
+    std::vector<std::string> order;
+    ticker.setBatchDispatcher(hostFunction([&](const jsi::Value *) { order.push_back("batch"); }));
+
+    Animation anim = opacityTo(&a, 0, 50);
+    anim.onFinishCallback = hostFunction([&](const jsi::Value *args) {
+        order.push_back(args[0].getBool() ? "a:true" : "a:false");
+    });
+    ticker.start(std::move(anim));
+    ticker.start(opacityTo(&b, 0, 50));
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(50, &rt);
+    CHECK((order == std::vector<std::string>{"batch", "a:true"}));
+}
+
+TEST(aThrowingCallbackDoesNotStopTheOthers) {
+    std::vector<skia::SkiaNode> nodes(4);
+    AnimationTicker ticker;
+    std::vector<int> finished;
+
+    for (int i = 0; i < 4; i++) {
+        Animation anim = opacityTo(&nodes[i], 0, 50);
+        anim.onFinishCallback = hostFunction([&, i](const jsi::Value *) {
+            finished.push_back(i);
+            if (i % 2 == 0) throw jsi::JSError(rt, "onFinish failed");
+        });
+        ticker.start(std::move(anim));
+    }
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(50, &rt);
+    std::sort(finished.begin(), finished.end());
+    CHECK((finished == std::vector<int>{0, 1, 2, 3}));
+
+    // A throwing dispatcher still lets the per-animation callbacks run
+    ticker.setBatchDispatcher(hostFunction([](const jsi::Value *) {
+        throw jsi::JSError(rt, "dispatch failed");
+    }));
+    finished.clear();
+    for (int i = 0; i < 2; i++) {
+        Animation anim = opacityTo(&nodes[i], 1, 50);
+        anim.onFinishCallback = hostFunction([&, i](const jsi::Value *) { finished.push_back(i); });
+        ticker.start(std::move(anim));
+    }
+    ticker.tickAll(100, &rt);
+    ticker.tickAll(150, &rt);
+    std::sort(finished.begin(), finished.end());
+    CHECK((finished == std::vector<int>{0, 1}));
+    CHECK(!ticker.hasActive());
+}
+
+ZILOL_TEST_MAIN()
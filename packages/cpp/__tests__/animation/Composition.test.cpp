@@ -0,0 +1,258 @@
+// Composition graphs advanced natively by AnimationTicker: loop,
+// sequence, parallel, stagger and delay timing, cancellation, and a
+// single completion per graph.
+
+#include "Check.h"
+#include "animation/AnimationTicker.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+namespace jsi = facebook::jsi;
+
+static jsi::Runtime rt;
+
+/// A JS onFinish that records every call.
+struct FinishLog {
+    std::vector<bool> calls;
+
+    std::shared_ptr<jsi::Function> callback() {
+        return std::make_shared<jsi::Function>(jsi::Function::createFromHostFunction(
+            rt, jsi::PropNameID::forAscii(rt, "onFinish"), 1,
+            [this](jsi::Runtime &, const jsi::Value &, const jsi::Value *args, size_t) {
+                calls.push_back(args[0].getBool());
+                return jsi::Value::undefined();
+            }));
+    }
+};
+
+static Animation opacityTo(skia::SkiaNode *node, float to, float duration) {
+    Animation anim;
+    anim.node = node;
+    anim.prop = PropId::Opacity;
+    anim.toValue = to;
+    anim.duration = duration;
+    anim.easing = easeLinear;
+    return anim;
+}
+
+TEST(loopWithoutFromReplaysEveryIteration) {
+    skia::SkiaNode node;
+    node.opacity = 1;
+    AnimationTicker ticker;
+    Composition comp;
+    int loop = comp.addLoop(3);
+    comp.addAnimation(opacityTo(&node, 0, 100), false, loop);
+    ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, nullptr);    // first iteration starts from 1
+    ticker.tickAll(50, nullptr);
+    CHECK_NEAR(node.opacity, 0.5, 1e-4);
+    ticker.tickAll(150, nullptr);  // second iteration, 50ms in
+    CHECK_NEAR(node.opacity, 0.5, 1e-4);
+    ticker.tickAll(275, nullptr);  // third iteration, 75ms in
+    CHECK_NEAR(node.opacity, 0.25, 1e-4);
+    ticker.tickAll(400, nullptr);
+    CHECK_NEAR(node.opacity, 0, 1e-4);
+    CHECK(!ticker.hasActive());
+}
+
+TEST(sequenceInLoopKeepsEachLeafsOwnStart) {
+    // Each leaf captures its start the first time it runs: the fade-in
+    // starts from 0 (where the fade-out left it), not from the loop's start
+    skia::SkiaNode node;
+    node.opacity = 1;
+    AnimationTicker ticker;
+    Composition comp;
+    int loop = comp.addLoop(2);
+    int seq = comp.addGroup(CompositionStep::Sequence, loop);
+    comp.addAnimation(opacityTo(&node, 0, 100), false, seq);
+    comp.addAnimation(opacityTo(&node, 0.5, 100), false, seq);
+    ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, nullptr);
+    ticker.tickAll(150, nullptr);  // fade-in, halfway: 0 → 0.5
+    CHECK_NEAR(node.opacity, 0.25, 1e-4);
+    ticker.tickAll(250, nullptr);  // second pass fade-out, halfway: 1 → 0
+    CHECK_NEAR(node.opacity, 0.5, 1e-4);
+    ticker.tickAll(350, nullptr);  // second pass fade-in, halfway
+    CHECK_NEAR(node.opacity, 0.25, 1e-4);
+}
+
+TEST(parallelRunsTogetherAndEndsWithTheLongest) {
+    skia::SkiaNode a, b;
+    AnimationTicker ticker;
+    FinishLog log;
+    Composition comp;
+    int group = comp.addGroup(CompositionStep::Parallel);
+    comp.addAnimation(opacityTo(&a, 0, 100), false, group);
+    comp.addAnimation(opacityTo(&b, 0, 200), false, group);
+    comp.onFinishCallback = log.callback();
+    int id = ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(50, &rt);
+    CHECK_NEAR(a.opacity, 0.5, 1e-4);
+    CHECK_NEAR(b.opacity, 0.75, 1e-4);
+    ticker.tickAll(150, &rt); // a done, b still running
+    CHECK_NEAR(a.opacity, 0, 1e-4);
+    CHECK_NEAR(b.opacity, 0.25, 1e-4);
+    CHECK(log.calls.empty());
+    CHECK(ticker.isComposing(id));
+    ticker.tickAll(200, &rt);
+    CHECK(log.calls == std::vector<bool>{true});
+    CHECK(!ticker.isComposing(id));
+}
+
+TEST(delayHoldsTheNextStep) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    Composition comp;
+    int seq = comp.addGroup(CompositionStep::Sequence);
+    comp.addDelay(100, seq);
+    comp.addAnimation(opacityTo(&node, 0, 100), false, seq);
+    ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, nullptr);
+    ticker.tickAll(90, nullptr);
+    CHECK(node.opacity == 1);
+    // The fade starts at exactly 100 ms, not at the tick that saw the
+    // delay end
+    ticker.tickAll(125, nullptr);
+    CHECK_NEAR(node.opacity, 0.75, 1e-4);
+    ticker.tickAll(200, nullptr);
+    CHECK_NEAR(node.opacity, 0, 1e-4);
+    CHECK(!ticker.hasActive());
+}
+
+TEST(staggerOffsetsEachChildFromTheSpec) {
+    skia::SkiaNodeTree tree;
+    AnimationTicker ticker;
+    registerAnimationHostFunctions(rt, &ticker, &tree);
+    skia::SkiaNode *nodes[3] = {tree.create(), tree.create(), tree.create()};
+
+    // { type: "stagger", delay: 50, children: [fade × 3] }
+    jsi::Array children(rt, 3);
+    for (size_t i = 0; i < 3; i++) {
+        jsi::Object config(rt);
+        config.setProperty(rt, "toValue", 0.0);
+        config.setProperty(rt, "duration", 100.0);
+        config.setProperty(rt, "easing", jsi::String::createFromUtf8(rt, "linear"));
+        jsi::Object fade(rt);
+        fade.setProperty(rt, "type", jsi::String::createFromUtf8(rt, "animation"));
+        fade.setProperty(rt, "node", static_cast<double>(nodes[i]->id));
+        fade.setProperty(rt, "prop", jsi::String::createFromUtf8(rt, "opacity"));
+        fade.setProperty(rt, "driver", jsi::String::createFromUtf8(rt, "timing"));
+        fade.setProperty(rt, "config", std::move(config));
+        children.setValueAtIndex(rt, i, std::move(fade));
+    }
+    jsi::Object spec(rt);
+    spec.setProperty(rt, "type", jsi::String::createFromUtf8(rt, "stagger"));
+    spec.setProperty(rt, "delay", 50.0);
+    spec.setProperty(rt, "children", std::move(children));
+
+    FinishLog log;
+    auto composite = rt.global().getPropertyAsFunction(rt, "__animateComposite");
+    int id = static_cast<int>(composite.call(rt, std::move(spec), *log.callback()).asNumber());
+    CHECK(id > 0);
+
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(75, &rt);
+    CHECK_NEAR(nodes[0]->opacity, 0.25, 1e-4);
+    CHECK_NEAR(nodes[1]->opacity, 0.75, 1e-4);
+    CHECK(nodes[2]->opacity == 1);
+    ticker.tickAll(150, &rt);
+    CHECK_NEAR(nodes[1]->opacity, 0, 1e-4);
+    CHECK_NEAR(nodes[2]->opacity, 0.5, 1e-4);
+    CHECK(log.calls.empty());
+    ticker.tickAll(200, &rt);
+    CHECK(log.calls == std::vector<bool>{true});
+}
+
+TEST(cancelStopsTheGraphAndReportsOnce) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    FinishLog log;
+    Composition comp;
+    int seq = comp.addGroup(CompositionStep::Sequence);
+    comp.addAnimation(opacityTo(&node, 0, 100), false, seq);
+    comp.addAnimation(opacityTo(&node, 1, 100), false, seq);
+    comp.onFinishCallback = log.callback();
+    int id = ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, &rt);
+    ticker.tickAll(50, &rt);
+    ticker.cancel(id);
+    ticker.cancel(id); // already gone
+    CHECK(!ticker.isComposing(id));
+    ticker.tickAll(60, &rt);
+    CHECK(log.calls == std::vector<bool>{false});
+    CHECK_NEAR(node.opacity, 0.5, 1e-4); // left where it stopped
+    for (float t = 100; t <= 400; t += 50) ticker.tickAll(t, &rt);
+    CHECK_NEAR(node.opacity, 0.5, 1e-4);
+    CHECK(log.calls.size() == 1);
+    CHECK(!ticker.hasActive());
+}
+
+TEST(cancellingAStepCancelsItsGraph) {
+    skia::SkiaNode a, b;
+    AnimationTicker ticker;
+    FinishLog log;
+    Composition comp;
+    int group = comp.addGroup(CompositionStep::Parallel);
+    comp.addAnimation(opacityTo(&a, 0, 100), false, group);
+    comp.addAnimation(opacityTo(&b, 0, 100), false, group);
+    comp.onFinishCallback = log.callback();
+    int id = ticker.startComposition(std::move(comp));
+
+    ticker.tickAll(0, &rt);
+    // Steps take the ids after the graph's, in start order
+    ticker.cancel(id + 1);
+    ticker.tickAll(50, &rt);
+    CHECK(log.calls == std::vector<bool>{false});
+    CHECK(a.opacity == 1 && b.opacity == 1);
+    CHECK(!ticker.isComposing(id));
+}
+
+TEST(onFinishFiresExactlyOnceAfterTheLastStep) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    FinishLog log;
+    Composition comp;
+    int loop = comp.addLoop(2);
+    int seq = comp.addGroup(CompositionStep::Sequence, loop);
+    comp.addAnimation(opacityTo(&node, 0, 50), false, seq);
+    comp.addDelay(50, seq);
+    comp.onFinishCallback = log.callback();
+    ticker.startComposition(std::move(comp));
+
+    for (float t = 0; t < 200; t += 10) {
+        ticker.tickAll(t, &rt);
+        CHECK(log.calls.empty());
+    }
+    for (float t = 200; t <= 500; t += 10) ticker.tickAll(t, &rt);
+    CHECK(log.calls == std::vector<bool>{true});
+}
+
+TEST(emptyGraphWithoutCallbackLeavesNothingBehind) {
+    AnimationTicker ticker;
+    Composition comp;
+    int seq = comp.addGroup(CompositionStep::Sequence);
+    comp.addGroup(CompositionStep::Parallel, seq);
+    comp.addLoop(3, seq); // over nothing
+    int id = ticker.startComposition(std::move(comp));
+    CHECK(!ticker.isComposing(id));
+    CHECK(!ticker.hasActive());
+
+    // With a callback the completion still arrives on the next tick
+    FinishLog log;
+    Composition empty;
+    empty.addGroup(CompositionStep::Sequence);
+    empty.onFinishCallback = log.callback();
+    ticker.startComposition(std::move(empty));
+    CHECK(ticker.hasActive());
+    ticker.tickAll(0, &rt);
+    CHECK(log.calls == std::vector<bool>{true});
+    CHECK(!ticker.hasActive());
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,94 @@
+// Easing curves: cubicBezierAt against CSS reference values, keyframe
+// tables, easing strings, and the EasingTableCache sharing and pruning.
+
+#include "Check.h"
+#include "animation/Easing.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+
+// Reference values from bisecting x(s) = t to double precision
+TEST(cubicBezierMatchesCssEase) {
+    // CSS `ease` = cubic-bezier(.25, .1, .25, 1)
+    CHECK_NEAR(cubicBezierAt(0.1f, 0.25f, 0.1f, 0.25f, 1), 0.094796, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.25f, 0.25f, 0.1f, 0.25f, 1), 0.408511, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.5f, 0.25f, 0.1f, 0.25f, 1), 0.802403, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.75f, 0.25f, 0.1f, 0.25f, 1), 0.960459, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.9f, 0.25f, 0.1f, 0.25f, 1), 0.994316, 1e-4);
+    CHECK(cubicBezierAt(0, 0.25f, 0.1f, 0.25f, 1) == 0);
+    CHECK(cubicBezierAt(1, 0.25f, 0.1f, 0.25f, 1) == 1);
+    CHECK(cubicBezierAt(-0.5f, 0.25f, 0.1f, 0.25f, 1) == 0);
+    CHECK(cubicBezierAt(1.5f, 0.25f, 0.1f, 0.25f, 1) == 1);
+}
+
+TEST(cubicBezierOvershootsWithOutOfRangeY) {
+    // easeOutBack-like: y control points above 1 overshoot the target
+    CHECK_NEAR(cubicBezierAt(0.25f, 0.34f, 1.56f, 0.64f, 1), 0.816289, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.5f, 0.34f, 1.56f, 0.64f, 1), 1.087401, 1e-4);
+    CHECK_NEAR(cubicBezierAt(0.75f, 0.34f, 1.56f, 0.64f, 1), 1.059647, 1e-4);
+
+    // Out-of-range x control points are clamped, keeping x(s) monotonic
+    CHECK_NEAR(cubicBezierAt(0.5f, -1, 0, 2, 1), cubicBezierAt(0.5f, 0, 0, 1, 1), 1e-5);
+}
+
+TEST(keyframesHoldOutsideTheirStops) {
+    EasingTableCache cache;
+    auto table = cache.keyframes({{0.2f, 0.1f}, {0.8f, 0.9f}});
+    CHECK_NEAR(table->sample(0), 0.1, 1e-6);
+    CHECK_NEAR(table->sample(0.1f), 0.1, 1e-6);
+    CHECK_NEAR(table->sample(0.5f), 0.5, 1e-3);
+    CHECK_NEAR(table->sample(0.9f), 0.9, 1e-6);
+    CHECK_NEAR(table->sample(1), 0.9, 1e-6);
+}
+
+TEST(keyframesOvershootAndEaseEachSegment) {
+    EasingTableCache cache;
+    auto table = cache.keyframes({{0, 0, easeInQuad}, {0.5f, 1.2f}, {1, 1}});
+    CHECK_NEAR(table->sample(0.25f), 1.2 * 0.25, 1e-3); // (0.5)² of the way
+    CHECK_NEAR(table->sample(0.5f), 1.2, 1e-3);
+    CHECK_NEAR(table->sample(0.75f), 1.1, 1e-3); // linear back down
+    CHECK_NEAR(table->sample(1), 1, 1e-6);
+}
+
+TEST(keyframesSortUnorderedStops) {
+    EasingTableCache cache;
+    auto sorted = cache.keyframes({{0, 0}, {0.5f, 1.2f}, {1, 1}});
+    auto unsorted = cache.keyframes({{1, 1}, {0, 0}, {0.5f, 1.2f}});
+    CHECK(unsorted == sorted);
+    CHECK_NEAR(unsorted->sample(0.25f), 0.6, 1e-3);
+}
+
+TEST(fromStringResolvesNamesAndBeziers) {
+    EasingTableCache cache;
+    auto css = cache.fromString("cubic-bezier(0.25, 0.1, 0.25, 1)");
+    CHECK(css == cache.cubicBezier(0.25f, 0.1f, 0.25f, 1));
+    CHECK(cache.fromString(" cubic-bezier( .25 ,.1, .25,1 ) ") == css);
+    CHECK_NEAR(css->sample(0.5f), 0.802403, 1e-3);
+
+    CHECK(cache.fromString("easeOut") == cache.forFunction(easeOutQuad));
+    // Unknown names and malformed beziers fall back to the default curve
+    CHECK(cache.fromString("wobble") == cache.forFunction(easeInOut));
+    CHECK(cache.fromString("cubic-bezier(0.25, 0.1)") == cache.forFunction(easeInOut));
+}
+
+TEST(cacheSharesTablesForIdenticalCurves) {
+    EasingTableCache cache;
+    auto a = cache.cubicBezier(0.42f, 0, 0.58f, 1);
+    auto b = cache.cubicBezier(0.42f, 0, 0.58f, 1);
+    auto c = cache.cubicBezier(0.42f, 0, 0.58f, 0.9f);
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(cache.forFunction(easeInCubic) == cache.forFunction(easeInCubic));
+    CHECK(cache.size() == 3);
+}
+
+TEST(cachePrunesExpiredTables) {
+    EasingTableCache cache;
+    auto kept = cache.cubicBezier(0.42f, 0, 0.58f, 1);
+    // Tables nobody holds any more are dropped once the cache passes 64
+    for (int i = 0; i < 100; i++) cache.cubicBezier(0.01f * i, 0, 1, 1);
+    CHECK(cache.size() <= 65);
+    CHECK(cache.cubicBezier(0.42f, 0, 0.58f, 1) == kept);
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,131 @@
+// Retargeting running animations with AnimationTicker::retarget.
+
+#include "Check.h"
+#include "animation/AnimationTicker.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+
+static Animation positionSpring(skia::SkiaNode *node, VectorValue to) {
+    Animation anim;
+    anim.node = node;
+    anim.vectorProp = VectorPropId::Position;
+    anim.driverType = DriverType::Spring;
+    anim.fromVector = {node->layout.x, node->layout.y};
+    anim.toVector = to;
+    return anim;
+}
+
+// Component velocity (px/ms) over the step from t0 to t1
+struct Velocity {
+    float x, y;
+};
+
+static Velocity step(AnimationTicker &ticker, skia::SkiaNode &node, float t0, float t1) {
+    float x = node.layout.x, y = node.layout.y;
+    ticker.tickAll(t1, nullptr);
+    return {(node.layout.x - x) / (t1 - t0), (node.layout.y - y) / (t1 - t0)};
+}
+
+TEST(vectorSpringRetargetKeepsComponentVelocity) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    int id = ticker.start(positionSpring(&node, {100, 50}));
+
+    for (float t = 0; t <= 80; t += 16) ticker.tickAll(t, nullptr);
+    ticker.tickAll(99.5f, nullptr);
+    Velocity before = step(ticker, node, 99.5f, 100);
+    CHECK(before.x > 0.1f);
+
+    // Same line, further out: the motion must carry on unchanged
+    Animation next;
+    CHECK(ticker.describe(id, next));
+    next.toVector = {200, 100};
+    CHECK(ticker.retarget(id, next));
+
+    Velocity after = step(ticker, node, 100, 100.5f);
+    CHECK_NEAR(after.x, before.x, 0.02 * before.x);
+    CHECK_NEAR(after.y, before.y, 0.02 * before.x);
+}
+
+TEST(vectorSpringRetargetProjectsVelocityOntoNewPath) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    int id = ticker.start(positionSpring(&node, {100, 0}));
+
+    for (float t = 0; t <= 80; t += 16) ticker.tickAll(t, nullptr);
+    ticker.tickAll(99.5f, nullptr);
+    Velocity before = step(ticker, node, 99.5f, 100);
+    float x = node.layout.x;
+
+    // Turn 90°: the new path is straight down, orthogonal to the motion
+    Animation next;
+    CHECK(ticker.describe(id, next));
+    next.toVector = {x, 100};
+    CHECK(ticker.retarget(id, next));
+
+    Velocity after = step(ticker, node, 100, 100.5f);
+    CHECK(before.x > 0.1f);
+    CHECK_NEAR(after.x, 0, 1e-4);
+    CHECK_NEAR(after.y, 0, 0.02 * before.x);
+}
+
+TEST(retargetHonorsExplicitVelocity) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    int id = ticker.start(positionSpring(&node, {100, 0}));
+
+    for (float t = 0; t <= 80; t += 16) ticker.tickAll(t, nullptr);
+    ticker.tickAll(99.5f, nullptr);
+    Velocity before = step(ticker, node, 99.5f, 100);
+
+    Animation next;
+    CHECK(ticker.describe(id, next));
+    next.toVector = {200, 0};
+    next.springVelocity = 0;
+    CHECK(ticker.retarget(id, next, true));
+
+    // From rest, the spring has barely moved half a millisecond in
+    Velocity after = step(ticker, node, 100, 100.5f);
+    CHECK(before.x > 0.1f);
+    CHECK(after.x < 0.1f * before.x);
+}
+
+TEST(transformRetargetKeepsRotationMoving) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    Animation anim;
+    anim.node = &node;
+    anim.vectorProp = VectorPropId::Transform;
+    anim.driverType = DriverType::Timing;
+    anim.duration = 100;
+    anim.easing = easeLinear;
+    anim.fromVector = readVectorProp(&node, VectorPropId::Transform);
+    anim.toVector = {40, 20, 3, 0.5f, 90};
+    int id = ticker.start(anim);
+
+    ticker.tickAll(0, nullptr);
+    int dirty = node.dirtyCount;
+    ticker.tickAll(50, nullptr);
+    // Every component lands in the same write
+    CHECK(node.dirtyCount == dirty + 1);
+    CHECK_NEAR(node.translateX, 20, 1e-4);
+    CHECK_NEAR(node.translateY, 10, 1e-4);
+    CHECK_NEAR(node.scaleX, 2, 1e-4);
+    CHECK_NEAR(node.scaleY, 0.75, 1e-4);
+    CHECK_NEAR(node.rotationAngle, 45, 1e-4);
+
+    // Re-aim the rotation only; the rest keeps its target
+    Animation next;
+    CHECK(ticker.describe(id, next));
+    next.toVector = {40, 20, 3, 0.5f, 180};
+    CHECK(ticker.retarget(id, next));
+    for (float t = 50; t <= 400; t += 16) ticker.tickAll(t, nullptr);
+    CHECK_NEAR(node.translateX, 40, 1e-3);
+    CHECK_NEAR(node.translateY, 20, 1e-3);
+    CHECK_NEAR(node.scaleX, 3, 1e-3);
+    CHECK_NEAR(node.scaleY, 0.5, 1e-3);
+    CHECK_NEAR(node.rotationAngle, 180, 1e-3);
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,190 @@
+// SharedValueStore: run allocation, writer binding and release, and the
+// Float32Array view JS reads the block through.
+
+#include "Check.h"
+#include "animation/SharedValues.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+using namespace zilol::gestures;
+namespace jsi = facebook::jsi;
+
+struct Fixture {
+    skia::SkiaNodeTree tree;
+    AnimationTicker ticker;
+    ScrollEngineManager scroll;
+    TouchDispatcher touch;
+    SharedValueStore store{&ticker, &scroll, &touch};
+    skia::SkiaNode *root = tree.create(skia::NodeType::Scroll);
+
+    Fixture() {
+        root->layout.width = 400;
+        root->layout.height = 800;
+        root->touchable = true;
+        tree.setRoot(root);
+        touch.setNodeTree(&tree);
+    }
+
+    int startAnimation(float to) {
+        Animation anim;
+        anim.node = tree.create();
+        anim.prop = PropId::Opacity;
+        anim.fromValue = 0;
+        anim.toValue = to;
+        anim.duration = 100;
+        anim.easing = easeLinear;
+        return ticker.start(anim);
+    }
+};
+
+TEST(allocateTakesTheFirstGapThatFits) {
+    Fixture f;
+    CHECK(f.store.allocate(4) == 0);
+    CHECK(f.store.allocate(2, 7) == 4);
+    CHECK(f.store.read(4) == 7 && f.store.read(5) == 7);
+
+    CHECK(f.store.release(0));
+    CHECK(!f.store.release(0));
+    CHECK(f.store.allocate(3) == 0); // back into the freed run
+    CHECK(f.store.allocate(2) == 6); // the 1-slot gap at 3 is too small
+
+    CHECK(f.store.allocate(0) == -1);
+    CHECK(f.store.allocate(SHARED_VALUE_CAPACITY + 1) == -1);
+    CHECK(f.store.allocate(SHARED_VALUE_CAPACITY - 8) == 8);
+    CHECK(f.store.allocate(1) == 3);
+    CHECK(f.store.allocate(1) == -1); // full
+
+    CHECK(f.store.contains(8, SHARED_VALUE_CAPACITY - 8));
+    CHECK(!f.store.contains(7, 2));
+    CHECK(!f.store.write(-1, 1));
+}
+
+TEST(releaseZeroesTheRunAndUnbindsItsWriters) {
+    Fixture f;
+    int id = f.startAnimation(100);
+    int slot = f.store.allocate(1 + SCROLL_SHARED_SLOTS + GESTURE_SHARED_SLOTS);
+    auto *engine = f.scroll.create(f.root);
+    int gestureId = f.touch.attachGesture(f.root->id, "pan");
+
+    CHECK(f.store.bindAnimation(id, slot));
+    CHECK(f.store.bindScroll(engine->id, slot + 1));
+    CHECK(f.store.bindGesture(gestureId, slot + 1 + SCROLL_SHARED_SLOTS));
+    CHECK(f.ticker.valueSink(id) == f.store.data() + slot);
+    CHECK(engine->sharedSlots == f.store.data() + slot + 1);
+    CHECK(f.touch.gestureSharedSlots(gestureId) == f.store.data() + slot + 1 + SCROLL_SHARED_SLOTS);
+
+    f.ticker.tickAll(0, nullptr);
+    f.ticker.tickAll(50, nullptr);
+    CHECK_NEAR(f.store.read(slot), 50, 1e-4);
+
+    CHECK(f.store.release(slot));
+    CHECK(f.ticker.valueSink(id) == nullptr);
+    CHECK(engine->sharedSlots == nullptr);
+    CHECK(f.touch.gestureSharedSlots(gestureId) == nullptr);
+    f.ticker.tickAll(75, nullptr);
+    CHECK(f.store.read(slot) == 0);
+}
+
+TEST(bindingsNeedAWholeRun) {
+    Fixture f;
+    int id = f.startAnimation(1);
+    auto *engine = f.scroll.create(f.root);
+    int small = f.store.allocate(2);
+    CHECK(!f.store.bindScroll(engine->id, small));         // needs 5 slots
+    CHECK(!f.store.bindAnimation(id, small + 2));          // unallocated
+    CHECK(!f.store.bindAnimation(id + 100, small));        // no such animation
+    CHECK(!f.store.bindGesture(99, small));
+    CHECK(engine->sharedSlots == nullptr);
+}
+
+TEST(rebindingMovesTheWriterAndReleaseLeavesTheNewOne) {
+    Fixture f;
+    int id = f.startAnimation(100);
+    auto *engine = f.scroll.create(f.root);
+    int a = f.store.allocate(SCROLL_SHARED_SLOTS + 1);
+    int b = f.store.allocate(SCROLL_SHARED_SLOTS + 1);
+
+    CHECK(f.store.bindAnimation(id, a));
+    CHECK(f.store.bindScroll(engine->id, a + 1));
+    CHECK(f.store.bindAnimation(id, b));
+    CHECK(f.store.bindScroll(engine->id, b + 1));
+
+    // Freeing the old run must not stop writers that moved on
+    CHECK(f.store.release(a));
+    CHECK(f.ticker.valueSink(id) == f.store.data() + b);
+    CHECK(engine->sharedSlots == f.store.data() + b + 1);
+
+    CHECK(f.store.release(b));
+    CHECK(f.ticker.valueSink(id) == nullptr);
+    CHECK(engine->sharedSlots == nullptr);
+
+    // A destroyed engine's binding is forgotten; its id may be reused
+    int c = f.store.allocate(SCROLL_SHARED_SLOTS);
+    auto *other = f.scroll.create(f.tree.create(skia::NodeType::Scroll));
+    CHECK(f.store.bindScroll(other->id, c));
+    f.store.onScrollRemoved(other->id);
+    CHECK(f.store.release(c));
+    CHECK(other->sharedSlots == f.store.data() + c); // left alone
+}
+
+TEST(phaseAndGestureStateSlotsFollowTransitions) {
+    Fixture f;
+    jsi::Runtime rt;
+    auto *engine = f.scroll.create(f.root);
+    int scrollSlot = f.store.allocate(SCROLL_SHARED_SLOTS);
+    CHECK(f.store.bindScroll(engine->id, scrollSlot));
+
+    // Drag begin and end land in the phase slot without a tick
+    engine->onTouchBegan(1, 200, 400, 0);
+    CHECK(f.store.read(scrollSlot + 4) == static_cast<float>(ScrollPhase::Dragging));
+    engine->onTouchCancelled(1);
+    CHECK(f.store.read(scrollSlot + 4) == static_cast<float>(ScrollPhase::Idle));
+
+    int gestureId = f.touch.attachGesture(f.root->id, "pan");
+    int gestureSlot = f.store.allocate(GESTURE_SHARED_SLOTS);
+    CHECK(f.store.bindGesture(gestureId, gestureSlot));
+    auto state = [&] { return static_cast<GestureState>(f.store.read(gestureSlot)); };
+
+    f.touch.dispatchTouch(0, 100, 100, 1, rt);
+    CHECK(state() == GestureState::Possible);
+    f.touch.dispatchTouch(1, 100, 160, 1, rt);
+    CHECK(state() == GestureState::Changed);
+    CHECK_NEAR(f.store.read(gestureSlot + 4), 60, 1e-4); // translationY
+    f.touch.dispatchTouch(3, 100, 170, 1, rt);
+    CHECK(state() == GestureState::Cancelled);
+}
+
+TEST(jsReadsAndWritesTheBlockThroughAFloat32Array) {
+    Fixture f;
+    jsi::Runtime rt;
+    // Stand-in constructor: the view is the buffer it was built over
+    rt.global().setProperty(rt, "Float32Array",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "Float32Array"), 1,
+            [](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *args, size_t) {
+                return jsi::Value(rt, args[0]);
+            }));
+    registerSharedValueHostFunctions(rt, &f.store);
+
+    auto view = rt.global().getPropertyAsObject(rt, "__sharedValues");
+    CHECK(view.isArrayBuffer(rt));
+    auto buffer = view.getArrayBuffer(rt);
+    CHECK(buffer.size(rt) == SHARED_VALUE_CAPACITY * sizeof(float));
+    CHECK(buffer.data(rt) == reinterpret_cast<uint8_t *>(f.store.data()));
+
+    auto allocate = rt.global().getPropertyAsFunction(rt, "__sharedValueAllocate");
+    auto release = rt.global().getPropertyAsFunction(rt, "__sharedValueRelease");
+    int slot = static_cast<int>(allocate.call(rt, 3, 1.5).asNumber());
+    CHECK(slot == 0);
+
+    auto *floats = reinterpret_cast<float *>(buffer.data(rt));
+    CHECK(floats[slot + 2] == 1.5f);
+    floats[slot + 1] = 42; // a JS write
+    CHECK(f.store.read(slot + 1) == 42);
+
+    release.call(rt, slot);
+    CHECK(floats[slot + 1] == 0);
+    CHECK(allocate.call(rt, jsi::Value::undefined()).asNumber() == -1);
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,142 @@
+// SpringSolution: the closed form against a fine RK4 integration of
+// m·x'' + c·x' + k·x = 0 in every damping regime, its initial
+// conditions, the near-critical switch, and the settle time it reports.
+
+#include "Check.h"
+#include "animation/Spring.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+
+struct State {
+    double x, v;
+};
+
+// Reference: RK4 at 10 µs steps, in double
+static State integrate(double x0, double v0, double k, double c, double m, double t) {
+    const double h = 1e-5;
+    State s{x0, v0};
+    auto accel = [&](double x, double v) { return -(k * x + c * v) / m; };
+    int steps = static_cast<int>(t / h + 0.5);
+    for (int i = 0; i < steps; i++) {
+        double k1x = s.v, k1v = accel(s.x, s.v);
+        double k2x = s.v + 0.5 * h * k1v, k2v = accel(s.x + 0.5 * h * k1x, s.v + 0.5 * h * k1v);
+        double k3x = s.v + 0.5 * h * k2v, k3v = accel(s.x + 0.5 * h * k2x, s.v + 0.5 * h * k2v);
+        double k4x = s.v + h * k3v, k4v = accel(s.x + h * k3x, s.v + h * k3v);
+        s.x += h / 6 * (k1x + 2 * k2x + 2 * k3x + k4x);
+        s.v += h / 6 * (k1v + 2 * k2v + 2 * k3v + k4v);
+    }
+    return s;
+}
+
+// Closed form at several times vs the reference, within float precision
+// of the start values (px, px/s)
+static void checkAgainstReference(float x0, float v0, float k, float c, float m) {
+    auto s = SpringSolution::solve(x0, v0, k, c, m);
+    for (double t : {0.01, 0.05, 0.1, 0.25, 0.5, 1.0}) {
+        State ref = integrate(x0, v0, k, c, m, t);
+        float x = 0, v = 0;
+        s.evaluate(static_cast<float>(t), x, v);
+        CHECK_NEAR(x, ref.x, 1e-3 * (std::abs(x0) + std::abs(v0) * 0.1 + 1));
+        CHECK_NEAR(v, ref.v, 1e-3 * (std::abs(x0) * 10 + std::abs(v0) + 1));
+    }
+}
+
+TEST(underdampedMatchesIntegration) {
+    auto s = SpringSolution::solve(100, 0, 100, 10, 1); // ζ = 0.5
+    CHECK(s.regime == SpringRegime::Under);
+    checkAgainstReference(100, 0, 100, 10, 1);
+    checkAgainstReference(-40, 800, 170, 12, 2);
+}
+
+TEST(criticallyDampedMatchesIntegration) {
+    auto s = SpringSolution::solve(100, 0, 100, 20, 1); // ζ = 1
+    CHECK(s.regime == SpringRegime::Critical);
+    checkAgainstReference(100, 0, 100, 20, 1);
+    checkAgainstReference(0, -500, 100, 20, 1);
+}
+
+TEST(overdampedMatchesIntegration) {
+    auto s = SpringSolution::solve(100, 0, 100, 40, 1); // ζ = 2
+    CHECK(s.regime == SpringRegime::Over);
+    checkAgainstReference(100, 0, 100, 40, 1);
+    checkAgainstReference(30, 600, 50, 60, 1.5f);
+}
+
+TEST(startsAtTheInitialConditions) {
+    const float frictions[] = {5, 20, 60}; // under, critical, over at k = 100
+    for (float c : frictions) {
+        auto s = SpringSolution::solve(-75, 420, 100, c, 1);
+        float x = 0, v = 0;
+        s.evaluate(0, x, v);
+        CHECK_NEAR(x, -75, 1e-3);
+        CHECK_NEAR(v, 420, 1e-2);
+    }
+}
+
+TEST(nearCriticalUsesTheCriticalForm) {
+    // |ζ − 1| < 1e-4 on either side takes the critical solution
+    for (float c : {20.0f * (1 - 5e-5f), 20.0f * (1 + 5e-5f)}) {
+        auto s = SpringSolution::solve(100, 0, 100, c, 1);
+        CHECK(s.regime == SpringRegime::Critical);
+        checkAgainstReference(100, 0, 100, c, 1);
+    }
+
+    // Just outside the band the under/over forms stay well conditioned
+    // and agree with the critical one
+    auto under = SpringSolution::solve(100, 0, 100, 20.0f * (1 - 2e-4f), 1);
+    auto over = SpringSolution::solve(100, 0, 100, 20.0f * (1 + 2e-4f), 1);
+    auto critical = SpringSolution::solve(100, 0, 100, 20, 1);
+    CHECK(under.regime == SpringRegime::Under);
+    CHECK(over.regime == SpringRegime::Over);
+    for (float t : {0.05f, 0.2f, 0.5f, 1.0f}) {
+        float xc = 0, vc = 0, xu = 0, vu = 0, xo = 0, vo = 0;
+        critical.evaluate(t, xc, vc);
+        under.evaluate(t, xu, vu);
+        over.evaluate(t, xo, vo);
+        CHECK_NEAR(xu, xc, 0.05);
+        CHECK_NEAR(xo, xc, 0.05);
+        CHECK_NEAR(vu, vc, 0.5);
+        CHECK_NEAR(vo, vc, 0.5);
+    }
+    // No jump in settle time across the band (the over-damped bound
+    // decays with the slow root, 2% below the critical rate here)
+    CHECK_NEAR(under.settleMs, critical.settleMs, 5);
+    CHECK_NEAR(over.settleMs, critical.settleMs, 25);
+}
+
+// At and after settleMs the spring stays inside 0.5 px / 10 px/s; the
+// last sample outside it is no more than `slackMs` earlier
+static void checkSettle(float x0, float v0, float k, float c, float m, float slackMs) {
+    auto s = SpringSolution::solve(x0, v0, k, c, m);
+    CHECK(s.settleMs > 0 && s.settleMs < SPRING_MAX_SETTLE_MS);
+    float lastMoving = 0;
+    for (float ms = 0; ms <= s.settleMs + 2000; ms += 0.5f) {
+        float x = 0, v = 0;
+        s.evaluate(ms * 0.001f, x, v);
+        bool resting = std::abs(x) < SPRING_REST_DISPLACEMENT &&
+                       std::abs(v) < SPRING_REST_VELOCITY;
+        if (!resting) lastMoving = ms;
+    }
+    CHECK(lastMoving < s.settleMs);
+    CHECK(s.settleMs - lastMoving <= slackMs);
+}
+
+TEST(settleTimeMeetsTheRestThresholds) {
+    // Under: the envelope touches the motion once per half period
+    checkSettle(100, 0, 100, 10, 1, 200);
+    checkSettle(0, 2000, 300, 8, 1, 100);
+    // The default spring, ζ ≈ 0.997: the near-critical bound keeps it tight
+    checkSettle(100, 0, 170, 26, 1, 10);
+    checkSettle(100, 0, 100, 20, 1, 5); // critical
+    checkSettle(100, 0, 100, 40, 1, 5); // over
+}
+
+TEST(undampedSpringCapsTheSettleTime) {
+    auto s = SpringSolution::solve(100, 0, 100, 0, 1);
+    CHECK(s.settleMs == SPRING_MAX_SETTLE_MS);
+    auto resting = SpringSolution::solve(0.1f, 0, 100, 20, 1);
+    CHECK(resting.settleMs <= 100); // already inside the thresholds
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,123 @@
+// AnimationTimeline: recording, headless replay and scrubbing.
+
+#include "Check.h"
+#include "animation/AnimationTimeline.h"
+
+#include <sstream>
+#include <string>
+
+using namespace zilol;
+using namespace zilol::animation;
+
+static constexpr double FRAME_MS = 1000.0 / 60.0;
+
+static Animation timing(skia::SkiaNode *node, PropId prop, float to, float duration) {
+    Animation anim;
+    anim.node = node;
+    anim.prop = prop;
+    anim.fromValue = readNodeProp(node, prop);
+    anim.toValue = to;
+    anim.duration = duration;
+    anim.easing = easeLinear;
+    return anim;
+}
+
+static Animation spring(skia::SkiaNode *node, PropId prop, float to) {
+    Animation anim;
+    anim.node = node;
+    anim.prop = prop;
+    anim.driverType = DriverType::Spring;
+    anim.toValue = to;
+    return anim;
+}
+
+static TimelineFrame sample(const AnimationTicker &ticker, double timestamp) {
+    TimelineFrame frame;
+    frame.timestamp = timestamp;
+    ticker.forEachValue([&](int id, float value) { frame.animations.push_back({id, value}); });
+    return frame;
+}
+
+TEST(replayReproducesRecordedFrames) {
+    skia::SkiaNode node;
+    node.id = 7;
+    AnimationTicker ticker;
+    AnimationTimelineRecorder recorder(&ticker, nullptr);
+
+    int fade = ticker.start(timing(&node, PropId::Opacity, 0, 300));
+    recorder.start(); // snapshots the fade already running
+    int slide = ticker.start(spring(&node, PropId::X, 120));
+    Animation move;
+    move.node = &node;
+    move.vectorProp = VectorPropId::Position;
+    move.driverType = DriverType::Spring;
+    move.toVector = {40, 80};
+    int position = ticker.start(move);
+
+    std::vector<TimelineFrame> live;
+    for (int i = 0; i < 40; i++) {
+        double t = i * FRAME_MS;
+        if (i == 10) {
+            // Retarget mid-flight and cancel one animation
+            Animation next;
+            CHECK(ticker.describe(slide, next));
+            next.toValue = -60;
+            CHECK(ticker.retarget(slide, next));
+            ticker.cancel(fade);
+        }
+        ticker.tickAll(static_cast<float>(t), nullptr);
+        recorder.onFrame(t);
+        live.push_back(sample(ticker, t));
+    }
+    recorder.stop();
+    CHECK(position > 0);
+
+    AnimationTimelinePlayer player(recorder.bytes());
+    CHECK(player.valid());
+    auto replayed = player.replay();
+    CHECK(replayed.size() == live.size());
+    for (size_t f = 0; f < std::min(replayed.size(), live.size()); f++) {
+        CHECK(replayed[f].timestamp == live[f].timestamp);
+        CHECK(replayed[f].animations.size() == live[f].animations.size());
+        for (size_t a = 0; a < std::min(replayed[f].animations.size(),
+                                        live[f].animations.size()); a++) {
+            CHECK(replayed[f].animations[a].first == live[f].animations[a].first);
+            CHECK(replayed[f].animations[a].second == live[f].animations[a].second);
+        }
+    }
+
+    std::ostringstream csv;
+    AnimationTimelinePlayer::writeCsv(replayed, csv);
+    std::string text = csv.str();
+    size_t rows = 0;
+    for (char c : text) rows += c == '\n';
+    size_t expected = 1;
+    for (auto &f : replayed) expected += f.animations.size();
+    CHECK(rows == expected);
+    CHECK(text.rfind("timestamp,kind,id,value,", 0) == 0);
+}
+
+TEST(resumeAfterScrubContinuesWherePaused) {
+    skia::SkiaNode node;
+    AnimationTicker ticker;
+    AnimationTimelineSession session(&ticker, nullptr);
+    ticker.start(timing(&node, PropId::Opacity, 0, 100));
+
+    for (double t : {0.0, 40.0}) {
+        CHECK(session.beginFrame(t));
+        ticker.tickAll(static_cast<float>(t), nullptr);
+    }
+    CHECK_NEAR(node.opacity, 0.6, 1e-4);
+
+    session.scrubbing = true;
+    for (double t = 56; t <= 5000; t += 16) CHECK(!session.beginFrame(t));
+    session.scrubbing = false;
+
+    // One frame after the pause (40 → 56), not 5 seconds
+    CHECK(session.beginFrame(5016));
+    ticker.tickAll(5016, nullptr);
+    CHECK_NEAR(node.opacity, 0.44, 1e-4);
+    CHECK(ticker.hasActive());
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,240 @@
+// ValueGraph: compiling JS expressions into instructions, and evaluating
+// them into node props.
+
+#include "Check.h"
+#include "animation/ValueGraph.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+namespace jsi = facebook::jsi;
+
+static jsi::Runtime rt;
+
+static jsi::Value str(const char *s) { return jsi::String::createFromUtf8(rt, s); }
+
+static jsi::Array numbers(std::initializer_list<double> values) {
+    jsi::Array arr(rt, values.size());
+    size_t i = 0;
+    for (double v : values) arr.setValueAtIndex(rt, i++, v);
+    return arr;
+}
+
+/// { op, args: [operands…] }
+template <typename... Operands>
+static jsi::Value op(const char *name, Operands &&...operands) {
+    jsi::Object obj(rt);
+    obj.setProperty(rt, "op", str(name));
+    jsi::Array args(rt, sizeof...(Operands));
+    size_t i = 0;
+    (args.setValueAtIndex(rt, i++, std::forward<Operands>(operands)), ...);
+    obj.setProperty(rt, "args", std::move(args));
+    return obj;
+}
+
+static jsi::Value shared(double slot) {
+    jsi::Object obj(rt);
+    obj.setProperty(rt, "op", str("shared"));
+    obj.setProperty(rt, "slot", slot);
+    return obj;
+}
+
+static jsi::Value diffClamp(jsi::Value input, double min, double max) {
+    jsi::Object obj(rt);
+    obj.setProperty(rt, "op", str("diffClamp"));
+    obj.setProperty(rt, "input", std::move(input));
+    obj.setProperty(rt, "min", min);
+    obj.setProperty(rt, "max", max);
+    return obj;
+}
+
+static jsi::Value interpolate(jsi::Value input, jsi::Array inputRange, jsi::Array outputRange) {
+    jsi::Object obj(rt);
+    obj.setProperty(rt, "op", str("interpolate"));
+    obj.setProperty(rt, "input", std::move(input));
+    obj.setProperty(rt, "inputRange", std::move(inputRange));
+    obj.setProperty(rt, "outputRange", std::move(outputRange));
+    obj.setProperty(rt, "extrapolate", str("clamp"));
+    return obj;
+}
+
+struct Fixture {
+    skia::SkiaNodeTree tree;
+    AnimationTicker ticker;
+    SharedValueStore store{&ticker, nullptr, nullptr};
+    ValueGraphRunner runner{nullptr, &ticker};
+    skia::SkiaNode *node = tree.create();
+
+    Fixture() { runner.setSharedValues(&store); }
+
+    /// Compile `expr` into node.layout.x; the register, or -1.
+    int compile(const jsi::Value &expr, ValueGraph &graph) {
+        int reg = compileGraphExpression(rt, &tree, expr, graph);
+        if (reg >= 0) graph.outputs.push_back({node, PropId::X, reg});
+        return reg;
+    }
+
+    /// Value of `expr` on its first evaluation (NaN if malformed).
+    float eval(const jsi::Value &expr) {
+        ValueGraph graph;
+        if (compile(expr, graph) < 0) return std::nanf("");
+        int id = runner.add(std::move(graph));
+        runner.remove(id);
+        return node->layout.x;
+    }
+};
+
+TEST(variadicOpsFoldLeft) {
+    Fixture f;
+    ValueGraph graph;
+    int reg = f.compile(op("add", 1, 2, 3, 4), graph);
+    // Four constants, then ((1 + 2) + 3) + 4
+    CHECK(reg == 6);
+    CHECK(graph.code.size() == 7);
+    CHECK(graph.code[4].op == GraphOp::Add && graph.code[4].a == 0 && graph.code[4].b == 1);
+    CHECK(graph.code[5].a == 4 && graph.code[5].b == 2);
+    CHECK(graph.code[6].a == 5 && graph.code[6].b == 3);
+    f.runner.add(std::move(graph));
+    CHECK_NEAR(f.node->layout.x, 10, 0);
+
+    CHECK_NEAR(f.eval(op("multiply", 2, 3, 4)), 24, 0);
+    CHECK_NEAR(f.eval(op("min", 5, -2, 3)), -2, 0);
+    CHECK_NEAR(f.eval(op("max", 5, -2, 9, 3)), 9, 0);
+    CHECK_NEAR(f.eval(op("sub", op("add", 10, 5), 4)), 11, 0);
+    CHECK_NEAR(f.eval(op("divide", 1, 0)), 0, 0);
+    CHECK_NEAR(f.eval(op("cond", op("greaterThan", 3, 2), 7, 8)), 7, 0);
+    CHECK_NEAR(f.eval(op("cond", op("lessThan", 3, 2), 7, 8)), 8, 0);
+}
+
+TEST(moduloTakesTheSignOfTheDivisor) {
+    Fixture f;
+    CHECK_NEAR(f.eval(op("modulo", 7, 3)), 1, 1e-6);
+    CHECK_NEAR(f.eval(op("modulo", -7, 3)), 2, 1e-6);
+    CHECK_NEAR(f.eval(op("modulo", 7, -3)), -2, 1e-6);
+    CHECK_NEAR(f.eval(op("modulo", -7, -3)), -1, 1e-6);
+    CHECK_NEAR(f.eval(op("modulo", -6, 3)), 0, 0);
+    CHECK_NEAR(f.eval(op("modulo", -0.5, 360)), 359.5, 1e-4);
+    CHECK_NEAR(f.eval(op("modulo", 5, 0)), 0, 0);
+}
+
+TEST(diffClampAccumulatesClampedDeltas) {
+    Fixture f;
+    int slot = f.store.allocate(1, 20);
+    ValueGraph graph;
+    CHECK(f.compile(diffClamp(shared(slot), 0, 50), graph) >= 0);
+
+    // The first input counts in full, as a delta from 0
+    f.runner.add(std::move(graph));
+    CHECK_NEAR(f.node->layout.x, 20, 0);
+
+    const float inputs[] = {30, 100, 90, 20, 35, -40, -30};
+    const float expected[] = {30, 50, 40, 0, 15, 0, 10};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        f.store.write(slot, inputs[i]);
+        f.runner.evaluateAll();
+        CHECK_NEAR(f.node->layout.x, expected[i], 1e-5);
+    }
+}
+
+TEST(interpolateClampsToTheOutputRange) {
+    Fixture f;
+    int slot = f.store.allocate(1);
+    ValueGraph graph;
+    CHECK(f.compile(interpolate(shared(slot), numbers({0, 100}), numbers({1, 0})), graph) >= 0);
+    f.runner.add(std::move(graph));
+    CHECK_NEAR(f.node->layout.x, 1, 1e-6);
+    f.store.write(slot, 25);
+    f.runner.evaluateAll();
+    CHECK_NEAR(f.node->layout.x, 0.75, 1e-6);
+    f.store.write(slot, 400);
+    f.runner.evaluateAll();
+    CHECK_NEAR(f.node->layout.x, 0, 1e-6);
+}
+
+TEST(malformedExpressionsCompileToMinusOne) {
+    Fixture f;
+    auto rejects = [&](const jsi::Value &expr) {
+        ValueGraph graph;
+        return compileGraphExpression(rt, &f.tree, expr, graph) == -1;
+    };
+    CHECK(rejects(str("1")));
+    CHECK(rejects(jsi::Value::undefined()));
+    CHECK(rejects(jsi::Value(jsi::Object(rt)))); // no op
+    CHECK(rejects(op("bogus", 1, 2)));
+    CHECK(rejects(op("add", 1)));                // one operand
+    CHECK(rejects(op("sub", 1, 2, 3)));          // only variadic ops chain
+    CHECK(rejects(op("modulo", 1)));
+    CHECK(rejects(op("cond", 1, 2)));
+    CHECK(rejects(op("add", 1, op("bogus"))));   // a bad operand anywhere
+    CHECK(rejects(shared(-1)));
+    CHECK(rejects(shared(SHARED_VALUE_CAPACITY)));
+    CHECK(rejects(interpolate(1, numbers({0}), numbers({1}))));
+    CHECK(rejects(interpolate(1, numbers({0, 1, 2}), numbers({1, 0}))));
+
+    jsi::Object noArgs(rt);
+    noArgs.setProperty(rt, "op", str("add"));
+    CHECK(rejects(jsi::Value(std::move(noArgs))));
+
+    jsi::Object clampNoMax(rt);
+    clampNoMax.setProperty(rt, "op", str("clamp"));
+    clampNoMax.setProperty(rt, "input", 1);
+    clampNoMax.setProperty(rt, "min", 0);
+    CHECK(rejects(jsi::Value(std::move(clampNoMax))));
+
+    jsi::Object missingNode(rt);
+    missingNode.setProperty(rt, "op", str("prop"));
+    missingNode.setProperty(rt, "node", 999);
+    missingNode.setProperty(rt, "prop", str("opacity"));
+    CHECK(rejects(jsi::Value(std::move(missingNode))));
+
+    jsi::Object unknownProp(rt);
+    unknownProp.setProperty(rt, "op", str("prop"));
+    unknownProp.setProperty(rt, "node", f.node->id);
+    unknownProp.setProperty(rt, "prop", str("colour"));
+    CHECK(rejects(jsi::Value(std::move(unknownProp))));
+
+    // An output into an unknown prop rejects the whole graph
+    registerValueGraphHostFunctions(rt, &f.runner, &f.tree);
+    jsi::Object out(rt);
+    out.setProperty(rt, "node", f.node->id);
+    out.setProperty(rt, "prop", str("colour"));
+    out.setProperty(rt, "value", 1);
+    jsi::Array outputs(rt, 1);
+    outputs.setValueAtIndex(rt, 0, std::move(out));
+    auto create = rt.global().getPropertyAsFunction(rt, "__valueGraphCreate");
+    CHECK(create.call(rt, std::move(outputs)).asNumber() == -1);
+    CHECK(f.runner.empty());
+}
+
+TEST(hostFunctionsCreateAndRemoveGraphs) {
+    Fixture f;
+    registerValueGraphHostFunctions(rt, &f.runner, &f.tree);
+    auto create = rt.global().getPropertyAsFunction(rt, "__valueGraphCreate");
+    auto remove = rt.global().getPropertyAsFunction(rt, "__valueGraphRemove");
+
+    auto outputs = [&](jsi::Value value) {
+        jsi::Object out(rt);
+        out.setProperty(rt, "node", f.node->id);
+        out.setProperty(rt, "prop", str("opacity"));
+        out.setProperty(rt, "value", std::move(value));
+        jsi::Array list(rt, 1);
+        list.setValueAtIndex(rt, 0, std::move(out));
+        return list;
+    };
+
+    CHECK(create.call(rt, outputs(op("bogus"))).asNumber() == -1);
+    CHECK(create.call(rt, 5).asNumber() == -1);
+    CHECK(f.runner.empty());
+
+    int slot = f.store.allocate(1, 0.25f);
+    int id = static_cast<int>(create.call(rt, outputs(shared(slot))).asNumber());
+    CHECK(id > 0);
+    CHECK_NEAR(f.node->opacity, 0.25, 1e-6);
+
+    remove.call(rt, id);
+    CHECK(f.runner.empty());
+    f.store.write(slot, 0.5f);
+    f.runner.evaluateAll();
+    CHECK_NEAR(f.node->opacity, 0.25, 1e-6);
+}
+
+ZILOL_TEST_MAIN()
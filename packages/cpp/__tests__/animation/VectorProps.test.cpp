@@ -0,0 +1,136 @@
+// Vector props: colors parsed once and interpolated as premultiplied
+// RGBA (sRGB or linear light), scale and the full transform, each
+// written to the node in one call.
+
+#include "Check.h"
+#include "animation/AnimationTicker.h"
+
+using namespace zilol;
+using namespace zilol::animation;
+namespace jsi = facebook::jsi;
+
+static jsi::Runtime rt;
+
+static uint32_t channel(uint32_t argb, int shift) { return (argb >> shift) & 0xFF; }
+
+struct Scene {
+    skia::SkiaNodeTree tree;
+    AnimationTicker ticker;
+    skia::SkiaNode *node = tree.create();
+
+    Scene() { registerAnimationHostFunctions(rt, &ticker, &tree); }
+
+    /// __animateNode(node, prop, "timing", { toValue, duration: 100,
+    /// easing: "linear", ...extra })
+    int animate(const char *prop, jsi::Value to, jsi::Object config = jsi::Object(rt)) {
+        config.setProperty(rt, "toValue", std::move(to));
+        config.setProperty(rt, "duration", 100.0);
+        config.setProperty(rt, "easing", jsi::String::createFromUtf8(rt, "linear"));
+        auto animateNode = rt.global().getPropertyAsFunction(rt, "__animateNode");
+        return static_cast<int>(animateNode.call(rt, static_cast<double>(node->id),
+                                                 jsi::String::createFromUtf8(rt, prop),
+                                                 jsi::String::createFromUtf8(rt, "timing"),
+                                                 std::move(config)).asNumber());
+    }
+};
+
+TEST(colorComponentsRoundTrip) {
+    for (uint32_t argb : {0xFF000000u, 0xFFFFFFFFu, 0x80FF8000u, 0xFF336699u, 0x40102030u}) {
+        for (ColorSpace space : {ColorSpace::Premultiplied, ColorSpace::Linear}) {
+            float c[4];
+            colorToComponents(argb, space, c);
+            uint32_t back = componentsToColor(c, space);
+            for (int shift : {0, 8, 16, 24}) {
+                CHECK(std::abs(int(channel(back, shift)) - int(channel(argb, shift))) <= 1);
+            }
+        }
+    }
+    float clear[4] = {0, 0, 0, 0};
+    CHECK(componentsToColor(clear, ColorSpace::Premultiplied) == 0);
+}
+
+TEST(colorParsesOnceAndInterpolatesPremultiplied) {
+    Scene s;
+    s.node->backgroundColor = 0xFFFF0000; // red
+    int id = s.animate("backgroundColor", jsi::String::createFromUtf8(rt, "#0000ff"));
+    CHECK(id > 0);
+
+    s.ticker.tickAll(0, &rt);
+    int dirty = s.node->dirtyCount;
+    s.ticker.tickAll(50, &rt);
+    CHECK(s.node->dirtyCount == dirty + 1);
+    uint32_t mid = s.node->backgroundColor;
+    CHECK(channel(mid, 24) == 0xFF);
+    CHECK(channel(mid, 16) == 128 && channel(mid, 0) == 128 && channel(mid, 8) == 0);
+
+    s.ticker.tickAll(100, &rt);
+    CHECK(s.node->backgroundColor == 0xFF0000FF);
+}
+
+TEST(fadingToTransparentKeepsTheHue) {
+    Scene s;
+    s.node->color = 0xFFFFFFFF;
+    s.animate("color", jsi::String::createFromUtf8(rt, "transparent"));
+    s.ticker.tickAll(0, &rt);
+    s.ticker.tickAll(75, &rt);
+    // Premultiplied: still white at a quarter alpha, not a dark grey
+    uint32_t c = s.node->color;
+    CHECK(std::abs(int(channel(c, 24)) - 64) <= 1);
+    CHECK(channel(c, 16) == 0xFF && channel(c, 8) == 0xFF && channel(c, 0) == 0xFF);
+}
+
+TEST(linearColorSpaceMixesInLinearLight) {
+    Scene s;
+    s.node->borderColor = 0xFF000000;
+    jsi::Object config(rt);
+    config.setProperty(rt, "colorSpace", jsi::String::createFromUtf8(rt, "linear"));
+    s.animate("borderColor", jsi::String::createFromUtf8(rt, "#ffffff"), std::move(config));
+    s.ticker.tickAll(0, &rt);
+    s.ticker.tickAll(50, &rt);
+    // Half of white's light is sRGB 188, not 128
+    uint32_t c = s.node->borderColor;
+    CHECK(std::abs(int(channel(c, 16)) - 188) <= 1);
+    CHECK(channel(c, 16) == channel(c, 8) && channel(c, 8) == channel(c, 0));
+    CHECK(withColorSpace(VectorPropId::BorderColor, ColorSpace::Linear) ==
+          VectorPropId::BorderColorLinear);
+}
+
+TEST(uniformScaleSetsBothAxes) {
+    Scene s;
+    s.animate("scale", jsi::Value(3.0));
+    s.ticker.tickAll(0, &rt);
+    s.ticker.tickAll(50, &rt);
+    CHECK_NEAR(s.node->scaleX, 2, 1e-4);
+    CHECK_NEAR(s.node->scaleY, 2, 1e-4);
+    s.ticker.tickAll(100, &rt);
+
+    jsi::Array xy(rt, 2);
+    xy.setValueAtIndex(rt, 0, 1.0);
+    xy.setValueAtIndex(rt, 1, 0.5);
+    s.animate("scale", std::move(xy)); // from the current 3 × 3
+    s.ticker.tickAll(100, &rt);
+    s.ticker.tickAll(150, &rt);
+    CHECK_NEAR(s.node->scaleX, 2, 1e-4);
+    CHECK_NEAR(s.node->scaleY, 1.75, 1e-4);
+    s.ticker.tickAll(200, &rt);
+    CHECK_NEAR(s.node->scaleX, 1, 1e-4);
+    CHECK_NEAR(s.node->scaleY, 0.5, 1e-4);
+}
+
+TEST(transformMovesEveryComponentTogether) {
+    Scene s;
+    jsi::Array to(rt, 5);
+    double values[] = {30, -10, 2, 2, 90};
+    for (size_t i = 0; i < 5; i++) to.setValueAtIndex(rt, i, values[i]);
+    s.animate("transform", std::move(to));
+    s.ticker.tickAll(0, &rt);
+    s.ticker.tickAll(50, &rt);
+    CHECK_NEAR(s.node->translateX, 15, 1e-4);
+    CHECK_NEAR(s.node->translateY, -5, 1e-4);
+    CHECK_NEAR(s.node->scaleX, 1.5, 1e-4);
+    CHECK_NEAR(s.node->scaleY, 1.5, 1e-4);
+    CHECK_NEAR(s.node->rotationAngle, 45, 1e-4);
+    CHECK(s.node->layout.x == 0 && s.node->layout.y == 0);
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,50 @@
+// Per-frame cost of 1,000 concurrent timing animations by easing kind:
+// a built-in polynomial (batched direct evaluation) against curves read
+// from an EasingTable — the same polynomial sampled, a CSS
+// cubic-bezier, and a keyframe track.
+
+#include "Bench.h"
+#include "animation/AnimationTicker.h"
+
+#include <vector>
+
+using namespace zilol;
+using namespace zilol::animation;
+
+static constexpr int ANIMATIONS = 1000;
+static constexpr int FRAMES = 1000;
+static constexpr int RUNS = 5;
+
+static double tickUs(EasingFn easing, EasingTableRef table) {
+    std::vector<skia::SkiaNode> nodes(ANIMATIONS);
+    AnimationTicker ticker;
+    for (int i = 0; i < ANIMATIONS; i++) {
+        Animation anim;
+        anim.node = &nodes[i];
+        anim.prop = PropId::Opacity;
+        anim.fromValue = 0;
+        anim.toValue = 1;
+        anim.duration = 1e9f; // never finishes inside the run
+        anim.startTime = 0;
+        anim.easing = easing;
+        anim.easingTable = table;
+        ticker.start(std::move(anim));
+    }
+    return test::bestOfUs(RUNS, FRAMES, [&](int run, int frame) {
+        ticker.tickAll(run * 20000.0 + frame * 16.0, nullptr);
+    });
+}
+
+int main() {
+    auto &cache = EasingTableCache::shared();
+    printf("%d timing animations, best of %d runs of %d frames (us/frame)\n",
+           ANIMATIONS, RUNS, FRAMES);
+    printf("  easeInOut, direct        %6.2f\n", tickUs(easeInOut, nullptr));
+    printf("  easeInOut, table         %6.2f\n", tickUs(easeInOut, cache.forFunction(easeInOut)));
+    printf("  cubic-bezier, table      %6.2f\n",
+           tickUs(easeInOut, cache.cubicBezier(0.34f, 1.56f, 0.64f, 1.0f)));
+    printf("  keyframes (4), table     %6.2f\n",
+           tickUs(easeInOut, cache.keyframes({{0, 0, easeLinear}, {0.3f, 0.8f, easeOutQuad},
+                                              {0.7f, 0.6f, easeLinear}, {1, 1, easeInQuad}})));
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Per-frame cost of 1,000 concurrent animations per driver: the SoA
+// driver lanes against the layout they replaced — one heap-allocated
+// Animation per id in an unordered_map, ticked through a driver switch
+// (kept here as the reference). Both sides run the same math and the
+// same PropId writes, so the difference is storage and loop shape.
+// "lane" times a lane's tick alone, without the ticker's bookkeeping.
+
+#include "Bench.h"
+#include "animation/AnimationTicker.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace zilol;
+using namespace zilol::animation;
+
+static constexpr int ANIMATIONS = 1000;
+static constexpr int FRAMES = 1000;
+static constexpr int RUNS = 5;
+
+// The per-animation object before the lanes, with its string prop name
+// and callback pointer still inline
+struct MapAnimation {
+    int id = 0;
+    skia::SkiaNode *node = nullptr;
+    std::string prop;
+    PropId propId = PropId::Unknown;
+    DriverType driverType = DriverType::Timing;
+    float fromValue = 0, toValue = 0, currentValue = 0;
+    float startTime = -1;
+    bool finished = false;
+    float duration = 0;
+    EasingFn easing = easeInOut;
+    SpringSolution solution;
+    float velocity = 0; // Spring: current; Decay: initial
+    float logRate = 0, distance = 0;
+    std::shared_ptr<facebook::jsi::Function> onFinishCallback;
+
+    void tick(float timestamp) {
+        if (startTime < 0) startTime = timestamp;
+        float elapsed = timestamp - startTime;
+        switch (driverType) {
+            case DriverType::Timing: {
+                float t = std::min(elapsed / duration, 1.0f);
+                currentValue = fromValue + (toValue - fromValue) * easing(t);
+                finished = t >= 1.0f;
+                break;
+            }
+            case DriverType::Spring: {
+                float x = 0, dx = 0;
+                solution.evaluate(elapsed * 0.001f, x, dx);
+                finished = elapsed >= solution.settleMs;
+                currentValue = finished ? toValue : toValue + x;
+                velocity = finished ? 0.0f : dx * 0.001f;
+                break;
+            }
+            case DriverType::Decay: {
+                float friction = std::exp(logRate * elapsed);
+                currentValue = fromValue + distance * (1.0f - friction);
+                finished = std::abs(velocity * friction) < 0.05f;
+                break;
+            }
+        }
+        writeNodeProp(node, propId, currentValue);
+    }
+};
+
+// Frames 1.6 ms apart, so every run stays inside the springs' 10 s cap
+static float frameTime(int run, int frame) {
+    return (run * FRAMES + frame) * 1.6f;
+}
+
+static Animation animationFor(DriverType driver, skia::SkiaNode *node) {
+    Animation anim;
+    anim.node = node;
+    anim.prop = PropId::Y;
+    anim.driverType = driver;
+    anim.fromValue = 0;
+    anim.toValue = 100;
+    anim.duration = 1e9f; // nothing finishes inside the runs
+    anim.springFriction = 0.05f;
+    anim.decayVelocity = 1;
+    anim.decayRate = 0.9999f;
+    return anim;
+}
+
+static double lanesUs(DriverType driver) {
+    std::vector<skia::SkiaNode> nodes(ANIMATIONS);
+    AnimationTicker ticker;
+    for (int i = 0; i < ANIMATIONS; i++) ticker.start(animationFor(driver, &nodes[i]));
+    return test::bestOfUs(RUNS, FRAMES, [&](int run, int frame) {
+        ticker.tickAll(frameTime(run, frame), nullptr);
+    });
+}
+
+template <typename Lane>
+static double laneTickUs(DriverType driver) {
+    std::vector<skia::SkiaNode> nodes(ANIMATIONS);
+    Lane lane;
+    for (int i = 0; i < ANIMATIONS; i++) lane.push(animationFor(driver, &nodes[i]));
+    size_t finished = 0;
+    double us = test::bestOfUs(RUNS, FRAMES, [&](int run, int frame) {
+        finished += lane.tick(frameTime(run, frame));
+    });
+    if (finished) printf("unexpected finish\n"); // keeps the loops live
+    return us;
+}
+
+static double mapUs(DriverType driver) {
+    std::vector<skia::SkiaNode> nodes(ANIMATIONS);
+    std::unordered_map<int, std::unique_ptr<MapAnimation>> animations;
+    for (int i = 0; i < ANIMATIONS; i++) {
+        Animation anim = animationFor(driver, &nodes[i]);
+        auto a = std::make_unique<MapAnimation>();
+        a->id = i + 1;
+        a->node = anim.node;
+        a->prop = propName(anim.prop);
+        a->propId = anim.prop;
+        a->driverType = driver;
+        a->fromValue = anim.fromValue;
+        a->toValue = anim.toValue;
+        a->duration = anim.duration;
+        a->solution = SpringSolution::solve(anim.fromValue - anim.toValue, 0,
+                                            anim.springTension, anim.springFriction,
+                                            anim.springMass);
+        a->velocity = anim.decayVelocity;
+        a->logRate = std::log(anim.decayRate);
+        a->distance = anim.decayVelocity / (1.0f - anim.decayRate);
+        animations[a->id] = std::move(a);
+    }
+    return test::bestOfUs(RUNS, FRAMES, [&](int run, int frame) {
+        float timestamp = frameTime(run, frame);
+        for (auto &entry : animations) entry.second->tick(timestamp);
+    });
+}
+
+int main() {
+    printf("%d animations per driver, best of %d runs of %d frames (us/frame)\n",
+           ANIMATIONS, RUNS, FRAMES);
+    const struct {
+        const char *name;
+        DriverType driver;
+        double (*lane)(DriverType);
+    } drivers[] = {
+        {"timing", DriverType::Timing, laneTickUs<TimingLane>},
+        {"spring", DriverType::Spring, laneTickUs<SpringLane>},
+        {"decay", DriverType::Decay, laneTickUs<DecayLane>},
+    };
+    for (auto &d : drivers) {
+        printf("  %-7s ticker %7.2f (lane %7.2f)   map of Animation %7.2f\n",
+               d.name, lanesUs(d.driver), d.lane(d.driver), mapUs(d.driver));
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+// ContentExtentIndex: max extents under duplicate edges, and the scroll
+// manager's tree hooks keeping each engine's index in step when a child
+// moves between containers. Removing a subtree also drops the scroll
+// bindings that target nodes inside it.
+
+#include "Check.h"
+#include "gestures/ScrollEngine.h"
+
+using namespace zilol;
+using namespace zilol::gestures;
+
+TEST(maxExtentSurvivesDuplicateEdges) {
+    ContentExtentIndex index;
+    CHECK(index.maxRight() == 0 && index.maxBottom() == 0);
+    index.set(1, 100, 500);
+    index.set(2, 100, 500); // same edges: the multiset keeps both
+    index.set(3, 50, 200);
+    index.remove(1);
+    CHECK(index.maxRight() == 100 && index.maxBottom() == 500);
+
+    index.set(2, 80, 300); // update moves the entry, not a copy
+    CHECK(index.maxRight() == 80 && index.maxBottom() == 300);
+    index.remove(2);
+    index.remove(2);
+    CHECK(index.maxRight() == 50 && index.maxBottom() == 200);
+
+    index.set(3, -10, -10); // content entirely before the origin
+    CHECK(index.maxRight() == 0 && index.maxBottom() == 0);
+    CHECK(index.contains(3) && !index.contains(2));
+}
+
+struct Scene {
+    skia::SkiaNodeTree tree;
+    ScrollEngineManager mgr;
+    skia::SkiaNode *a = scroll();
+    skia::SkiaNode *b = scroll();
+
+    skia::SkiaNode *scroll() {
+        auto *node = tree.create(skia::NodeType::Scroll);
+        node->layout.width = 100;
+        node->layout.height = 100;
+        return node;
+    }
+
+    skia::SkiaNode *child(float height) {
+        auto *node = tree.create();
+        node->layout.width = 100;
+        node->layout.height = height;
+        return node;
+    }
+
+    void append(skia::SkiaNode *parent, skia::SkiaNode *node) {
+        tree.appendChild(parent, node);
+        mgr.onChildInserted(parent, node);
+    }
+
+    void remove(skia::SkiaNode *parent, skia::SkiaNode *node) {
+        tree.removeChild(parent, node);
+        mgr.onChildRemoved(parent, node);
+    }
+
+    float contentH(skia::SkiaNode *node) {
+        auto *engine = mgr.findByNode(node);
+        engine->updateBoundsFromNode();
+        return engine->contentH;
+    }
+};
+
+TEST(reparentWithoutRemoveMovesTheExtent) {
+    Scene s;
+    s.mgr.create(s.a);
+    s.mgr.create(s.b);
+    auto *tall = s.child(900);
+    auto *shortChild = s.child(300);
+    s.append(s.a, tall);
+    s.append(s.a, shortChild);
+    CHECK(s.contentH(s.a) == 900);
+
+    // The renderer re-inserts under the new parent without a remove
+    s.a->children.erase(s.a->children.begin());
+    s.append(s.b, tall);
+    CHECK(s.contentH(s.a) == 300);
+    CHECK(s.contentH(s.b) == 900);
+
+    // A remove from the old parent after the move leaves the new one alone
+    s.mgr.onChildRemoved(s.a, tall);
+    CHECK(s.contentH(s.b) == 900);
+
+    // Layout changes land in the current owner only
+    tall->layout.height = 1200;
+    s.mgr.onLayoutChanged(tall);
+    CHECK(s.contentH(s.a) == 300);
+    CHECK(s.contentH(s.b) == 1200);
+
+    s.remove(s.b, tall);
+    CHECK(s.contentH(s.b) == 0);
+    tall->layout.height = 2000;
+    s.mgr.onLayoutChanged(tall); // detached: no engine owns it
+    CHECK(s.contentH(s.a) == 300 && s.contentH(s.b) == 0);
+}
+
+TEST(reparentIntoAPlainViewDropsTheExtent) {
+    Scene s;
+    s.mgr.create(s.a);
+    auto *view = s.tree.create();
+    auto *item = s.child(600);
+    s.append(s.a, item);
+    CHECK(s.contentH(s.a) == 600);
+    s.append(view, item);
+    CHECK(s.contentH(s.a) == 0);
+}
+
+TEST(engineBoundLaterSeedsFromItsChildren) {
+    Scene s;
+    auto *item = s.child(700);
+    s.append(s.a, item); // no engine yet
+    auto *engine = s.mgr.create(s.a);
+    CHECK(engine->extents.contains(item->id));
+    CHECK(s.contentH(s.a) == 700);
+
+    s.mgr.create(s.b);
+    s.append(s.b, item);
+    CHECK(s.contentH(s.a) == 0);
+    CHECK(s.contentH(s.b) == 700);
+
+    // Removing the engine forgets its children; a later move is a plain insert
+    s.mgr.remove(s.mgr.findByNode(s.b)->id);
+    s.append(s.a, item);
+    CHECK(s.contentH(s.a) == 700);
+}
+
+TEST(removingASubtreeDropsItsBindings) {
+    Scene s;
+    auto *engine = s.mgr.create(s.a);
+    auto *header = s.tree.create();
+    auto *title = s.tree.create();
+    auto *footer = s.tree.create();
+    s.append(s.b, header);
+    s.append(header, title);
+    s.append(s.b, footer);
+
+    auto bind = [&](skia::SkiaNode *node) {
+        ScrollBinding binding;
+        binding.id = s.mgr.nextBindingId();
+        binding.node = node;
+        binding.prop = animation::PropId::Opacity;
+        binding.inputRange = {0, 100};
+        binding.outputRange = {1, 0};
+        engine->addBinding(binding);
+        return binding.id;
+    };
+    bind(title);
+    int footerBinding = bind(footer);
+    CHECK(engine->bindings.size() == 2);
+
+    // The title goes with its parent; the footer's binding stays
+    s.remove(s.b, header);
+    CHECK(engine->bindings.size() == 1);
+    CHECK(engine->bindings[0].id == footerBinding);
+
+    engine->removeBinding(footerBinding);
+    CHECK(engine->bindings.empty());
+}
+
+ZILOL_TEST_MAIN()
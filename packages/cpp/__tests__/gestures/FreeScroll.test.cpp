@@ -0,0 +1,202 @@
+// Free scroll: both axes fling and bounce independently, and a second
+// pointer pinches to zoom about the fingers' midpoint, rubber-banding
+// past the zoom limits and springing back on release.
+
+#include "Check.h"
+#include "gestures/TouchDispatcher.h"
+
+using namespace zilol;
+using namespace zilol::gestures;
+
+// A 400 x 400 free-scrolling viewport over 2000 x 2000 content, with a
+// touchable 100 x 100 tile at content (300, 300)
+struct Scene {
+    skia::SkiaNodeTree tree;
+    ScrollEngineManager mgr;
+    skia::SkiaNode *root = tree.create();
+    skia::SkiaNode *scroll = tree.create(skia::NodeType::Scroll);
+    skia::SkiaNode *content = tree.create();
+    skia::SkiaNode *tile = tree.create();
+    ScrollEngine *engine = nullptr;
+    double now = 0;
+
+    Scene() {
+        root->layout.width = scroll->layout.width = 400;
+        root->layout.height = scroll->layout.height = 400;
+        content->layout.width = content->layout.height = 2000;
+        tile->layout.x = tile->layout.y = 300;
+        tile->layout.width = tile->layout.height = 100;
+        tile->touchable = true;
+        tree.appendChild(root, scroll);
+        tree.appendChild(scroll, content);
+        tree.appendChild(content, tile);
+        tree.setRoot(root);
+        tree.layoutAbsolute(root);
+        engine = mgr.create(scroll);
+        engine->touchResampling = false;
+        engine->freeScroll = true;
+        engine->minZoom = 1;
+        engine->maxZoom = 4;
+    }
+
+    /// Drag one pointer from (x0, y0) by (dx, dy) over `frames` frames
+    /// and release it.
+    void fling(float x0, float y0, float dx, float dy, int frames = 6) {
+        CHECK(engine->onTouchBegan(1, x0, y0, now));
+        for (int i = 1; i <= frames; i++) {
+            now += 16;
+            engine->onTouchMoved(1, x0 + dx * i / frames, y0 + dy * i / frames, now);
+        }
+        engine->onTouchEnded(1, now);
+    }
+
+    /// Tick until idle; returns the frames it took.
+    int settle() {
+        int frames = 0;
+        while (engine->phase != ScrollPhase::Idle && frames < 1000) {
+            now += 16;
+            mgr.tickAll(now);
+            frames++;
+        }
+        return frames;
+    }
+
+    void pinch(float x0, float y0, float x1, float y1) {
+        engine->onTouchMoved(1, x0, y0, now);
+        engine->onTouchMoved(2, x1, y1, now);
+    }
+};
+
+TEST(bouncingAxisDoesNotBrakeTheOtherFling) {
+    // Same horizontal fling, once in bounds and once pulled past the top
+    Scene inBounds, pulled;
+    inBounds.engine->scrollTo(0, 800, false);
+    inBounds.fling(300, 100, -240, 120);
+    pulled.fling(300, 100, -240, 120);
+    CHECK(pulled.engine->offsetY < 0);
+    CHECK(pulled.engine->phase == ScrollPhase::Bouncing);
+    CHECK(inBounds.engine->phase == ScrollPhase::Decelerating);
+    CHECK_NEAR(pulled.engine->velocityX, inBounds.engine->velocityX, 1e-3);
+
+    inBounds.settle();
+    pulled.settle();
+    CHECK(pulled.engine->offsetY == 0);
+    CHECK(inBounds.engine->offsetX > 600);
+    CHECK_NEAR(pulled.engine->offsetX, inBounds.engine->offsetX, 1);
+}
+
+TEST(flingPastOneEdgeSpringsOnlyThatAxis) {
+    Scene s;
+    s.engine->scrollTo(1500, 100, false);
+    s.fling(300, 300, -60, -60, 3); // fast along both axes
+    for (int i = 0; i < 200 && s.engine->offsetX <= 1600; i++) {
+        s.now += 16;
+        s.mgr.tickAll(s.now);
+    }
+    CHECK(s.engine->offsetX > 1600); // past the right edge
+    CHECK(s.engine->phase == ScrollPhase::Bouncing);
+    float vy = s.engine->velocityY;
+    CHECK(vy > 0);
+
+    // Y keeps its exponential deceleration while X springs back
+    s.now += 16;
+    s.mgr.tickAll(s.now);
+    CHECK_NEAR(s.engine->velocityY, vy * std::pow(s.engine->decelerationRate, 16.0f), 1e-2);
+    s.settle();
+    CHECK(s.engine->offsetX == 1600);
+    CHECK(s.engine->offsetY > 100);
+}
+
+TEST(pinchZoomsAboutTheFocalPoint) {
+    Scene s;
+    CHECK(s.engine->onTouchBegan(1, 100, 100, 0));
+    CHECK(s.engine->onTouchBegan(2, 300, 300, 0));
+    CHECK(!s.engine->onTouchBegan(3, 200, 50, 0)); // a third finger is ignored
+    s.pinch(0, 0, 400, 400);
+    // Twice the distance about the same midpoint: content (200, 200)
+    // stays under (200, 200)
+    CHECK_NEAR(s.engine->zoomScale, 2, 1e-4);
+    CHECK_NEAR(s.engine->offsetX, 200, 1e-2);
+    CHECK_NEAR(s.engine->offsetY, 200, 1e-2);
+    CHECK(s.scroll->zoomScale == s.engine->zoomScale);
+    CHECK(s.scroll->scrollX == s.engine->offsetX);
+
+    // Moving both fingers pans
+    s.pinch(-50, -100, 350, 300);
+    CHECK_NEAR(s.engine->zoomScale, 2, 1e-4);
+    CHECK_NEAR(s.engine->offsetX, 250, 1e-2);
+    CHECK_NEAR(s.engine->offsetY, 300, 1e-2);
+
+    // Touches map back through the zoom and the offset
+    TouchDispatcher dispatcher;
+    dispatcher.setNodeTree(&s.tree);
+    dispatcher.setScrollManager(&s.mgr);
+    CHECK(dispatcher.hitTest(360, 360) == s.tile);  // content (305, 330)
+    CHECK(dispatcher.hitTest(340, 360) == nullptr); // content (295, 330)
+}
+
+TEST(zoomRubberBandsAndSpringsBackAboutTheFingers) {
+    Scene s;
+    s.engine->maxZoom = 2;
+    s.engine->scrollTo(600, 600, false);
+    CHECK(s.engine->onTouchBegan(1, 150, 200, 0));
+    CHECK(s.engine->onTouchBegan(2, 250, 200, 0));
+    s.pinch(0, 200, 400, 200); // 4×, past the 2× limit
+    float zoom = s.engine->zoomScale;
+    CHECK(zoom > 2 && zoom < 4);
+    float contentX = (s.engine->offsetX + 200) / zoom;
+
+    s.engine->onTouchEnded(2, 16);
+    s.engine->onTouchEnded(1, 16);
+    CHECK(s.engine->phase == ScrollPhase::Bouncing);
+    s.settle();
+    CHECK_NEAR(s.engine->zoomScale, 2, 1e-3);
+    CHECK_NEAR((s.engine->offsetX + 200) / s.engine->zoomScale, contentX, 0.5);
+
+    // Pinching in past the minimum springs back to it
+    CHECK(s.engine->onTouchBegan(1, 0, 200, 1000));
+    CHECK(s.engine->onTouchBegan(2, 400, 200, 1000));
+    s.pinch(100, 200, 300, 200); // half the distance: exactly the minimum
+    CHECK_NEAR(s.engine->zoomScale, 1, 1e-3);
+    s.pinch(195, 200, 205, 200);
+    CHECK(s.engine->zoomScale < 1);
+    s.engine->onTouchCancelled(2);
+    s.settle();
+    CHECK_NEAR(s.engine->zoomScale, 1, 1e-3);
+    CHECK(s.engine->offsetX >= 0 && s.engine->offsetX <= 1600);
+}
+
+TEST(liftingOneFingerContinuesAsADrag) {
+    Scene s;
+    CHECK(s.engine->onTouchBegan(1, 100, 100, 0));
+    CHECK(s.engine->onTouchBegan(2, 300, 300, 0));
+    s.pinch(0, 0, 400, 400);
+    float offsetX = s.engine->offsetX;
+
+    s.engine->onTouchEnded(1, 16); // the first finger lifts
+    CHECK(s.engine->phase == ScrollPhase::Dragging);
+    s.engine->onTouchMoved(2, 350, 400, 32);
+    CHECK_NEAR(s.engine->offsetX, offsetX + 50, 1e-2);
+    CHECK_NEAR(s.engine->zoomScale, 2, 1e-4);
+    s.engine->onTouchEnded(2, 48);
+    s.settle();
+    CHECK(s.engine->phase == ScrollPhase::Idle);
+}
+
+TEST(zoomNeedsFreeScrollAndALimitRange) {
+    Scene s;
+    s.engine->maxZoom = 1;
+    CHECK(s.engine->onTouchBegan(1, 100, 100, 0));
+    CHECK(s.engine->onTouchBegan(2, 300, 300, 0)); // restarts the drag
+    s.engine->onTouchMoved(1, 0, 0, 16);
+    s.engine->onTouchMoved(2, 400, 400, 16);
+    CHECK(s.engine->zoomScale == 1);
+    s.engine->onTouchEnded(2, 32);
+
+    s.engine->maxZoom = 3;
+    s.engine->zoomTo(5);
+    CHECK(s.engine->zoomScale == 3);
+    CHECK(s.engine->phase == ScrollPhase::Idle);
+}
+
+ZILOL_TEST_MAIN()
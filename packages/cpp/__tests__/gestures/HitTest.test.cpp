@@ -0,0 +1,240 @@
+// TouchDispatcher hit testing: the HitTestIndex query must return what the
+// reference tree walk returns, including after incremental tree changes.
+
+#include "Check.h"
+#include "gestures/TouchDispatcher.h"
+
+using namespace zilol;
+using namespace zilol::gestures;
+using skia::NodeType;
+using skia::SkiaNode;
+
+// root
+// ├── header              touchable
+// ├── list (Scroll)       sticky headers at children 0 and 11
+// │   ├── stickyA         touchable
+// │   ├── row 0..9        even rows touchable, each with a touchable button
+// │   ├── stickyB         touchable
+// │   ├── carousel (Scroll, horizontal)
+// │   │   └── tile 0..7   touchable
+// │   └── row 10..14
+// └── overlay             touchable, front-most
+struct Fixture {
+    skia::SkiaNodeTree tree;
+    ScrollEngineManager mgr;
+    TouchDispatcher dispatcher;
+    SkiaNode *root = nullptr, *list = nullptr, *carousel = nullptr;
+    ScrollEngine *listEngine = nullptr, *carouselEngine = nullptr;
+    std::vector<SkiaNode *> rows;
+
+    Fixture() {
+        root = node(nullptr, NodeType::View, 0, 0, 400, 800, false);
+        node(root, NodeType::View, 0, 0, 400, 60, true);
+        list = node(root, NodeType::Scroll, 0, 60, 400, 700, false);
+        node(list, NodeType::View, 0, 0, 400, 40, true);
+        for (int i = 0; i < 10; i++) addRow(40 + i * 120.0f, i % 2 == 0);
+        node(list, NodeType::View, 0, 1240, 400, 40, true);
+        carousel = node(list, NodeType::Scroll, 0, 1280, 400, 200, false);
+        carousel->horizontal = true;
+        for (int j = 0; j < 8; j++) node(carousel, NodeType::View, j * 150.0f, 0, 140, 200, true);
+        for (int i = 10; i < 15; i++) addRow(1480 + (i - 10) * 120.0f, i % 2 == 0);
+        node(root, NodeType::View, 0, 700, 400, 100, true);
+
+        tree.setRoot(root);
+        tree.layoutAbsolute(root);
+        listEngine = engineFor(list);
+        carouselEngine = engineFor(carousel);
+        listEngine->setStickyHeaders({0, 11});
+
+        dispatcher.setNodeTree(&tree);
+        dispatcher.setScrollManager(&mgr);
+    }
+
+    SkiaNode *node(SkiaNode *parent, NodeType type, float x, float y,
+                   float w, float h, bool touchable) {
+        auto *n = tree.create(type);
+        n->layout.x = x;
+        n->layout.y = y;
+        n->layout.width = w;
+        n->layout.height = h;
+        n->touchable = touchable;
+        if (parent) tree.appendChild(parent, n);
+        return n;
+    }
+
+    void addRow(float y, bool touchable) {
+        auto *row = node(list, NodeType::View, 0, y, 400, 120, touchable);
+        node(row, NodeType::View, 300, 20, 80, 80, true);
+        rows.push_back(row);
+    }
+
+    ScrollEngine *engineFor(SkiaNode *scroll) {
+        auto *engine = mgr.create(scroll);
+        for (auto *child : scroll->children) mgr.onChildInserted(scroll, child);
+        return engine;
+    }
+
+    /// Append through the same path as __nodeAppendChild.
+    void append(SkiaNode *parent, SkiaNode *child) {
+        tree.appendChild(parent, child);
+        tree.layoutAbsolute(root);
+        mgr.onChildInserted(parent, child);
+        dispatcher.onNodeChildChanged(parent, child);
+    }
+
+    void remove(SkiaNode *parent, SkiaNode *child) {
+        tree.removeChild(parent, child);
+        mgr.onChildRemoved(parent, child);
+        dispatcher.onNodeChildChanged(parent, child);
+    }
+
+    /// Points where the index and the walk disagree; `hits` counts targets.
+    int mismatches(int &hits) {
+        int bad = 0;
+        hits = 0;
+        for (float y = -5; y <= 805; y += 7) {
+            for (float x = -5; x <= 405; x += 7) {
+                auto *indexed = dispatcher.hitTest(x, y);
+                auto *walked = dispatcher.hitTestNode(root, x, y);
+                if (indexed != walked) bad++;
+                if (walked) hits++;
+            }
+        }
+        return bad;
+    }
+};
+
+TEST(indexMatchesWalkOnNestedScrollWithStickyHeaders) {
+    Fixture f;
+    f.listEngine->scrollTo(0, 700, false);   // stickyA pinned
+    f.carouselEngine->scrollTo(300, 0, false);
+    int hits = 0;
+    CHECK(f.mismatches(hits) == 0);
+    CHECK(hits > 1000);
+
+    f.listEngine->scrollTo(0, 1100, false);  // stickyB pushing stickyA off
+    CHECK(f.mismatches(hits) == 0);
+}
+
+TEST(indexFollowsChildInsertAndRemove) {
+    Fixture f;
+    f.listEngine->scrollTo(0, 1100, false);
+    int hits = 0;
+    CHECK(f.mismatches(hits) == 0); // every space built
+
+    // New tile at the carousel's end, scrolled into view
+    auto *tile = f.node(nullptr, NodeType::View, 1200, 0, 140, 200, true);
+    f.append(f.carousel, tile);
+    f.carouselEngine->scrollTo(1000, 0, false);
+    CHECK(f.mismatches(hits) == 0);
+
+    // A row leaves the list
+    f.remove(f.list, f.rows[9]);
+    CHECK(f.mismatches(hits) == 0);
+
+    // A button moves into the carousel without a remove first, to a
+    // content rect that overlaps the carousel on screen
+    auto *button = f.rows[8]->children[0];
+    f.tree.removeChild(f.rows[8], button);
+    button->layout.x = 100;
+    f.append(f.carousel, button);
+    CHECK(f.mismatches(hits) == 0);
+
+    // The whole carousel, with its own space, leaves the list
+    f.remove(f.list, f.carousel);
+    f.listEngine->scrollTo(0, 900, false);
+    CHECK(f.mismatches(hits) == 0);
+    CHECK(hits > 1000);
+}
+
+TEST(subtreesMovingBetweenSpacesStayIndexed) {
+    Fixture f;
+    f.listEngine->scrollTo(0, 1100, false);
+    int hits = 0;
+    CHECK(f.mismatches(hits) == 0); // every space built
+
+    // The carousel, with its own space, moves out to the top space and
+    // back; a row moves into the carousel and back out
+    f.remove(f.list, f.carousel);
+    f.append(f.root, f.carousel);
+    CHECK(f.mismatches(hits) == 0);
+    f.remove(f.root, f.carousel);
+    f.append(f.list, f.carousel);
+    CHECK(f.mismatches(hits) == 0);
+
+    auto *row = f.rows[10];
+    f.remove(f.list, row);
+    row->layout.x = 300;
+    row->layout.y = 0;
+    f.append(f.carousel, row);
+    CHECK(f.mismatches(hits) == 0);
+    f.remove(f.carousel, row);
+    row->layout.x = 0;
+    row->layout.y = 1480;
+    f.append(f.list, row);
+    CHECK(f.mismatches(hits) == 0);
+    CHECK(hits > 1000);
+}
+
+TEST(onlyTouchabilityAndGeometryPropsReachTheIndex) {
+    CHECK(hitPropEffect("touchable") == HitPropEffect::Target);
+    CHECK(hitPropEffect("width") == HitPropEffect::Geometry);
+    CHECK(hitPropEffect("marginTop") == HitPropEffect::Geometry);
+    CHECK(hitPropEffect("translateX") == HitPropEffect::Geometry);
+    CHECK(hitPropEffect("backgroundColor") == HitPropEffect::None);
+    CHECK(hitPropEffect("text") == HitPropEffect::None);
+    CHECK(hitPropEffect("opacity") == HitPropEffect::None);
+
+    Fixture f;
+    int hits = 0;
+    CHECK(f.mismatches(hits) == 0);
+    f.rows[0]->touchable = false;
+    f.rows[1]->touchable = true;
+    f.dispatcher.onNodePropChanged(f.rows[0], "touchable");
+    f.dispatcher.onNodePropChanged(f.rows[1], "touchable");
+    CHECK(f.mismatches(hits) == 0);
+
+    // Geometry keys re-bucket the node from its current layout
+    f.rows[2]->layout.absoluteX += 40;
+    f.dispatcher.onNodePropChanged(f.rows[2], "left");
+    CHECK(f.mismatches(hits) == 0);
+}
+
+TEST(indexFollowsPanDriveAndItsRelease) {
+    Fixture f;
+    int hits = 0;
+    CHECK(f.mismatches(hits) == 0);
+
+    auto *overlay = f.root->children.back();
+    auto *badge = f.node(nullptr, NodeType::View, 10, 10, 50, 50, true);
+    f.append(overlay, badge);
+
+    // Wired as TouchDispatcher::setPanDrive wires it
+    animation::AnimationTicker ticker;
+    PanDrive drive;
+    drive.node = overlay;
+    drive.onMoved = [&](SkiaNode *n) { f.dispatcher.onNodeLayoutChanged(n); };
+
+    GestureEvent e;
+    drive.onGesture(GestureState::Began, e, &ticker);
+    e.translationY = -400;
+    drive.onGesture(GestureState::Changed, e, &ticker);
+    CHECK_NEAR(overlay->layout.absoluteY, 300, 1e-4);
+    CHECK_NEAR(badge->layout.absoluteY, 310, 1e-4);
+    CHECK(f.dispatcher.hitTest(30, 330) == badge);
+    CHECK(f.dispatcher.hitTest(200, 350) == overlay);
+    CHECK(f.mismatches(hits) == 0);
+
+    // Springs back to where the drag began
+    drive.onGesture(GestureState::Ended, e, &ticker);
+    for (float t = 0; t < 3000 && ticker.hasActive(); t += 16) {
+        ticker.tickAll(t, nullptr);
+        drive.onFrame(&ticker);
+    }
+    CHECK(!ticker.hasActive());
+    CHECK_NEAR(badge->layout.absoluteY, 710, 0.01);
+    CHECK(f.dispatcher.hitTest(30, 730) == badge);
+    CHECK(f.mismatches(hits) == 0);
+}
+
+ZILOL_TEST_MAIN()
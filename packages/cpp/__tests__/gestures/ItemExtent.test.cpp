@@ -0,0 +1,215 @@
+// ItemExtentIndex: Fenwick prefix sums and lower-bound search against a
+// linear scan, and the virtualized window ScrollEngine derives from them
+// at the edges of a list.
+
+#include "Check.h"
+#include "gestures/ScrollEngine.h"
+
+#include <vector>
+
+using namespace zilol;
+using namespace zilol::gestures;
+
+/// Extents 10, 25, 40, 10, 25, 40, ... (not all equal, none zero)
+static std::vector<float> mixedExtents(int n) {
+    std::vector<float> extents;
+    for (int i = 0; i < n; i++) extents.push_back(10.0f + 15.0f * (i % 3));
+    return extents;
+}
+
+static float linearOffsetOf(const std::vector<float> &extents, int index) {
+    float sum = 0;
+    for (int i = 0; i < index && i < (int)extents.size(); i++) sum += extents[i];
+    return sum;
+}
+
+static int linearIndexAt(const std::vector<float> &extents, float offset) {
+    if (extents.empty()) return -1;
+    float start = 0;
+    for (int i = 0; i < (int)extents.size(); i++) {
+        if (offset < start + extents[i]) return i;
+        start += extents[i];
+    }
+    return (int)extents.size() - 1;
+}
+
+TEST(prefixSumsAndSearchMatchALinearScan) {
+    // Sizes around powers of two exercise the tree's partial top level
+    for (int n : {1, 2, 3, 7, 8, 9, 16, 17, 33}) {
+        auto extents = mixedExtents(n);
+        ItemExtentIndex index;
+        index.assign(extents);
+        CHECK(index.count() == n);
+        CHECK_NEAR(index.total(), linearOffsetOf(extents, n), 1e-3);
+        for (int i = 0; i <= n + 1; i++) {
+            CHECK_NEAR(index.offsetOf(i), linearOffsetOf(extents, i), 1e-3);
+        }
+        for (float offset = -5; offset <= index.total() + 5; offset += 2.5f) {
+            CHECK(index.indexAt(offset) == linearIndexAt(extents, offset));
+        }
+    }
+}
+
+TEST(itemBoundariesBelongToTheNextItem) {
+    ItemExtentIndex index;
+    index.assign(4, 50);
+    CHECK(index.indexAt(0) == 0);
+    CHECK(index.indexAt(49.9f) == 0);
+    CHECK(index.indexAt(50) == 1);
+    CHECK(index.indexAt(150) == 3);
+    CHECK(index.indexAt(200) == 3); // the end clamps to the last item
+    CHECK(index.indexAt(1e6f) == 3);
+}
+
+TEST(setExtentUpdatesLaterOffsets) {
+    auto extents = mixedExtents(13);
+    ItemExtentIndex index;
+    index.assign(extents);
+    index.setExtent(5, 100);
+    index.setExtent(0, 1);
+    index.setExtent(12, 60);
+    index.setExtent(-1, 999); // out of range: ignored
+    index.setExtent(13, 999);
+    extents[5] = 100;
+    extents[0] = 1;
+    extents[12] = 60;
+    CHECK_NEAR(index.total(), linearOffsetOf(extents, 13), 1e-3);
+    for (int i = 0; i <= 13; i++) {
+        CHECK_NEAR(index.offsetOf(i), linearOffsetOf(extents, i), 1e-3);
+    }
+    for (float offset = 0; offset <= index.total(); offset += 3) {
+        CHECK(index.indexAt(offset) == linearIndexAt(extents, offset));
+    }
+}
+
+TEST(emptyIndex) {
+    ItemExtentIndex index;
+    CHECK(index.indexAt(0) == -1);
+    index.assign(3, 10);
+    index.assign(0, 10);
+    CHECK(index.count() == 0 && index.total() == 0);
+    CHECK(index.offsetOf(2) == 0);
+    CHECK(index.indexAt(5) == -1);
+    index.assign(-4, 10);
+    CHECK(index.count() == 0);
+}
+
+// ── Visible window ──
+
+struct List {
+    skia::SkiaNodeTree tree;
+    ScrollEngineManager mgr;
+    ScrollEngine *engine = mgr.create(tree.create(skia::NodeType::Scroll));
+    int changes = 0;
+    std::vector<IndexRange> entered, left;
+
+    List() {
+        engine->overscan = 0;
+        engine->updateBounds(100, 100, 100, 0);
+        engine->onWindowChangeCallback = [this](IndexRange, const std::vector<IndexRange> &in,
+                                                const std::vector<IndexRange> &out) {
+            changes++;
+            entered = in;
+            left = out;
+        };
+    }
+
+    IndexRange windowAt(float offset) {
+        engine->offsetY = offset;
+        engine->updateRenderedWindow();
+        mgr.flushScrollEvents(0);
+        return engine->renderedWindow;
+    }
+};
+
+static bool is(IndexRange r, int first, int last) { return r.first == first && r.last == last; }
+
+TEST(emptyListHasAnEmptyWindow) {
+    List list;
+    CHECK(list.windowAt(0).empty());
+    CHECK(list.changes == 0); // empty to empty is not a change
+
+    list.engine->items.assign(10, 50);
+    CHECK(is(list.windowAt(0), 0, 2));
+    list.engine->items.assign(0, 50);
+    CHECK(list.windowAt(0).empty());
+    CHECK(list.changes == 2);
+    CHECK(list.entered.empty());
+    CHECK(list.left.size() == 1 && is(list.left[0], 0, 2));
+}
+
+TEST(leadingOffsetShiftsTheWindow) {
+    List list;
+    list.engine->items.assign(10, 50);
+    list.engine->itemsLeadingOffset = 200;
+
+    // The header fills the viewport; the window still starts at item 0
+    CHECK(is(list.windowAt(0), 0, 0));
+    CHECK(is(list.windowAt(150), 0, 1));  // items start at 200
+    CHECK(is(list.windowAt(250), 1, 3));
+    CHECK(list.entered.size() == 1 && is(list.entered[0], 2, 3));
+    CHECK(list.left.size() == 1 && is(list.left[0], 0, 0));
+
+    list.engine->updateBoundsFromNode();
+    CHECK(list.engine->contentH == 700); // header + 10 items
+}
+
+TEST(lastItemStaysInTheWindowAtTheEnd) {
+    List list;
+    list.engine->items.assign(10, 50);
+    list.engine->itemsLeadingOffset = 200;
+    list.engine->overscan = 5;
+    CHECK(is(list.windowAt(600), 3, 9)); // max offset: 700 - 100
+    CHECK(is(list.windowAt(650), 4, 9)); // bounced past the end: clamps to the last
+    list.engine->overscan = 0;
+    CHECK(is(list.windowAt(600), 8, 9));
+}
+
+TEST(windowChangesWaitForTheFlush) {
+    List list;
+    list.engine->node->layout.width = 100;
+    list.engine->node->layout.height = 100;
+    list.engine->items.assign(100, 50);
+    list.windowAt(0);
+    CHECK(list.changes == 1);
+
+    // Moves within a frame coalesce into one change against the last
+    // window reported
+    list.engine->offsetY = 100;
+    list.engine->updateRenderedWindow();
+    list.engine->offsetY = 200;
+    list.engine->updateRenderedWindow();
+    CHECK(list.changes == 1);
+    list.mgr.flushScrollEvents(0);
+    CHECK(list.changes == 2);
+    CHECK(list.entered.size() == 1 && is(list.entered[0], 4, 6));
+    CHECK(list.left.size() == 1 && is(list.left[0], 0, 2));
+}
+
+TEST(windowCallbackMayDestroyItsEngine) {
+    List list;
+    auto *engine = list.engine;
+    engine->node->layout.width = 100;
+    engine->node->layout.height = 100;
+    engine->items.assign(100, 50);
+    list.windowAt(0);
+
+    int id = engine->id;
+    engine->onWindowChangeCallback = [&](IndexRange, const std::vector<IndexRange> &,
+                                         const std::vector<IndexRange> &) {
+        list.changes++;
+        list.mgr.remove(id); // the list unmounts itself
+    };
+    engine->scrollTo(0, 2000, true);
+    for (double t = 16; t < 1000 && list.mgr.get(id); t += 16) {
+        list.mgr.tickAll(t);
+        CHECK(list.changes == 1); // never from inside the tick
+        list.mgr.flushScrollEvents(t);
+    }
+    CHECK(list.changes == 2);
+    CHECK(list.mgr.get(id) == nullptr);
+    list.mgr.tickAll(2000);
+    list.mgr.flushScrollEvents(2000);
+}
+
+ZILOL_TEST_MAIN()
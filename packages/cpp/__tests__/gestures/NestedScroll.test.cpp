@@ -0,0 +1,93 @@
+// Nested ScrollEngines: removing an engine while a touch is forwarded
+// through the chain leaves neither a dangling parent nor a pointer that
+// ancestors keep ignoring.
+
+#include "Check.h"
+#include "gestures/ScrollEngine.h"
+
+using namespace zilol;
+using namespace zilol::gestures;
+
+// A vertical outer list holding a horizontal carousel, both scrollable
+struct Scene {
+    skia::SkiaNodeTree tree;
+    ScrollEngineManager mgr;
+    skia::SkiaNode *outerNode = scroll(false, 400, 2000);
+    skia::SkiaNode *innerNode = scroll(true, 2000, 200);
+    ScrollEngine *outer = nullptr;
+    ScrollEngine *inner = nullptr;
+
+    Scene() {
+        tree.appendChild(outerNode, innerNode);
+        outer = mgr.create(outerNode);
+        inner = mgr.create(innerNode);
+        outer->touchResampling = false;
+        inner->touchResampling = false;
+        inner->linkParent(outer);
+    }
+
+    // Scroll container sized 400 x 400 (or 400 x 200 when horizontal)
+    // with one child of the given content size
+    skia::SkiaNode *scroll(bool horizontal, float contentW, float contentH) {
+        auto *node = tree.create(skia::NodeType::Scroll);
+        node->horizontal = horizontal;
+        node->layout.width = 400;
+        node->layout.height = horizontal ? 200 : 400;
+        auto *content = tree.create();
+        content->layout.width = contentW;
+        content->layout.height = contentH;
+        tree.appendChild(node, content);
+        return node;
+    }
+};
+
+TEST(removingTheParentMidCrossAxisDragEndsTheChildDrag) {
+    Scene s;
+    CHECK(s.inner->onTouchBegan(1, 200, 100, 0));
+    s.inner->onTouchMoved(1, 202, 60, 16); // vertical: handed to the outer list
+    CHECK(s.outer->phase == ScrollPhase::Dragging);
+    CHECK(s.outer->offsetY > 0);
+
+    s.mgr.remove(s.outer->id);
+    CHECK(s.inner->parent == nullptr);
+    CHECK(s.inner->phase == ScrollPhase::Idle);
+
+    // The rest of the touch must not reach the destroyed engine
+    s.inner->onTouchMoved(1, 204, 20, 32);
+    s.inner->onTouchEnded(1, 48);
+    s.inner->onTouchCancelled(1);
+    CHECK(s.inner->phase == ScrollPhase::Idle);
+    CHECK(s.inner->offsetX == 0);
+
+    // The next touch drives the carousel on its own
+    CHECK(s.inner->onTouchBegan(1, 200, 100, 100));
+    s.inner->onTouchMoved(1, 150, 100, 116);
+    CHECK(s.inner->offsetX > 0);
+    s.inner->onTouchEnded(1, 132);
+}
+
+TEST(removingTheParentMidCancelEndsTheChildDrag) {
+    Scene s;
+    CHECK(s.inner->onTouchBegan(1, 200, 100, 0));
+    s.inner->onTouchMoved(1, 202, 60, 16);
+    s.mgr.remove(s.outer->id);
+    s.inner->onTouchCancelled(1);
+    CHECK(s.inner->phase == ScrollPhase::Idle);
+}
+
+TEST(removingTheChildMidDragReleasesTheParentPointer) {
+    Scene s;
+    CHECK(s.inner->onTouchBegan(1, 200, 100, 0));
+    s.inner->onTouchMoved(1, 150, 102, 16); // horizontal: the carousel's own
+    CHECK(s.inner->phase == ScrollPhase::Dragging);
+
+    s.mgr.remove(s.inner->id);
+    CHECK(s.outer->nestedChildren.empty());
+
+    // The outer list accepts the same pointer id on the next touch
+    CHECK(s.outer->onTouchBegan(1, 200, 300, 100));
+    s.outer->onTouchMoved(1, 200, 250, 116);
+    CHECK(s.outer->offsetY > 0);
+}
+
+ZILOL_TEST_MAIN()
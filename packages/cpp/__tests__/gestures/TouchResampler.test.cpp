@@ -0,0 +1,86 @@
+// TouchResampler: interpolation inside the buffered samples, and the
+// clamps on extrapolating past the newest one.
+
+#include "Check.h"
+#include "gestures/TouchResampler.h"
+
+using namespace zilol::gestures;
+
+TEST(interpolatesBetweenBracketingSamples) {
+    TouchResampler r;
+    float x = 0, y = 0;
+    CHECK(!r.sampleAt(0, x, y));
+
+    r.addSample(100, 0, 0);
+    CHECK(r.sampleAt(200, x, y) && x == 0 && y == 0); // one sample: held
+    r.addSample(108, 8, -16);
+    r.addSample(116, 24, -32);
+    CHECK(r.sampleAt(104, x, y));
+    CHECK_NEAR(x, 4, 1e-5);
+    CHECK_NEAR(y, -8, 1e-5);
+    CHECK(r.sampleAt(112, x, y));
+    CHECK_NEAR(x, 16, 1e-5);
+    CHECK_NEAR(y, -24, 1e-5);
+    CHECK(r.sampleAt(116, x, y) && x == 24);
+}
+
+TEST(beforeTheOldestSampleClampsToIt) {
+    TouchResampler r;
+    float x = 0, y = 0;
+    for (int i = 0; i < 6; i++) r.addSample(100 + 8 * i, 10.0f * i, 0);
+    CHECK(r.size() == 4); // the two oldest were overwritten
+    CHECK(r.sampleAt(0, x, y));
+    CHECK_NEAR(x, 20, 1e-5);
+}
+
+TEST(extrapolationStopsAtHalfTheSampleInterval) {
+    TouchResampler r;
+    float x = 0, y = 0;
+    r.addSample(100, 0, 0);
+    r.addSample(108, 8, 0); // 1 px/ms, 8 ms apart
+    CHECK(r.sampleAt(102, x, y));
+    CHECK_NEAR(x, 2, 1e-5);
+    CHECK(r.sampleAt(111, x, y));
+    CHECK_NEAR(x, 11, 1e-5);
+    CHECK(r.sampleAt(150, x, y));
+    CHECK_NEAR(x, 12, 1e-5); // 108 + 4 ms
+}
+
+TEST(extrapolationStopsAtTheCallersHorizon) {
+    TouchResampler r;
+    float x = 0, y = 0;
+    r.addSample(100, 0, 0);
+    r.addSample(118, 18, 0); // half the interval is 9 ms
+    CHECK(r.sampleAt(150, x, y));
+    CHECK_NEAR(x, 18 + TOUCH_MAX_PREDICTION_MS, 1e-5);
+    CHECK(r.sampleAt(150, x, y, 3));
+    CHECK_NEAR(x, 21, 1e-5);
+    CHECK(r.sampleAt(150, x, y, 0));
+    CHECK_NEAR(x, 18, 1e-5);
+}
+
+TEST(pairsTooCloseOrTooFarApartAreNotExtrapolated) {
+    TouchResampler close, far;
+    float x = 0, y = 0;
+    close.addSample(100, 0, 0);
+    close.addSample(101, 5, 0);
+    CHECK(close.sampleAt(110, x, y) && x == 5);
+    far.addSample(100, 0, 0);
+    far.addSample(130, 30, 0);
+    CHECK(far.sampleAt(140, x, y) && x == 30);
+}
+
+TEST(sameTimestampKeepsTheLatestPosition) {
+    TouchResampler r;
+    float x = 0, y = 0;
+    r.addSample(100, 0, 0);
+    r.addSample(108, 8, 0);
+    r.addSample(108, 10, 2);
+    r.addSample(104, 99, 99); // older: dropped
+    CHECK(r.size() == 2);
+    CHECK(r.sampleAt(108, x, y) && x == 10 && y == 2);
+    r.reset();
+    CHECK(!r.sampleAt(108, x, y));
+}
+
+ZILOL_TEST_MAIN()
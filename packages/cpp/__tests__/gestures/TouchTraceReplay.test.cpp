@@ -0,0 +1,165 @@
+// Replays recorded touch traces headlessly against the scene in their
+// header and checks the scroll physics they produced on device.
+
+#include "Check.h"
+#include "gestures/TouchTrace.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace zilol;
+using namespace zilol::gestures;
+namespace jsi = facebook::jsi;
+
+static TouchTrace loadTrace(const char *name) {
+    TouchTrace trace;
+    std::ifstream in(std::string(ZILOL_TEST_DATA_DIR) + "/" + name);
+    CHECK(in.good());
+    CHECK(trace.read(in));
+    return trace;
+}
+
+TEST(sceneHeaderRestoresEngine) {
+    auto trace = loadTrace("paging-flick.trace");
+    CHECK_NEAR(trace.scene.frameRate, 60, 0.01);
+    CHECK(trace.scene.nodes.size() == 12);
+    CHECK(trace.scene.engines.size() == 1);
+
+    TouchTraceStage stage(trace.scene);
+    CHECK(stage.root() && stage.root()->id == 1);
+    auto *engine = stage.engineFor(2);
+    CHECK(engine != nullptr);
+    if (!engine) return;
+    CHECK(engine->pagingEnabled);
+    CHECK(!engine->horizontal);
+    CHECK_NEAR(engine->viewportH, 844, 0);
+    CHECK_NEAR(engine->contentH, 8440, 0);
+    CHECK(stage.node(2)->children.size() == 10);
+}
+
+TEST(pagingFlickSettlesOnNextPage) {
+    auto trace = loadTrace("paging-flick.trace");
+    TouchTraceStage stage(trace.scene);
+    jsi::Runtime rt;
+    TouchTraceReplayer replayer(stage, rt);
+    replayer.watchEngineId = stage.engineFor(2)->id;
+    auto frames = replayer.replay(trace);
+
+    CHECK(!frames.empty());
+    if (frames.empty()) return;
+    // Content follows the finger while dragging, then snaps forward
+    float peak = 0;
+    for (auto &f : frames) peak = std::max(peak, f.offsetY);
+    CHECK(peak >= 240);
+    CHECK(peak <= 844 + 1);
+    CHECK_NEAR(frames.back().offsetY, 844, 0.5);
+    CHECK(frames.back().phase == ScrollPhase::Idle);
+    CHECK_NEAR(stage.node(2)->scrollY, 844, 0.5);
+}
+
+TEST(writeReadRoundTrip) {
+    auto trace = loadTrace("paging-flick.trace");
+    auto copy = TouchTrace::fromString(trace.toString());
+    CHECK(copy.events.size() == trace.events.size());
+    CHECK(copy.scene.nodes.size() == trace.scene.nodes.size());
+    CHECK(copy.scene.engines.size() == trace.scene.engines.size());
+
+    TouchTraceStage a(trace.scene), b(copy.scene);
+    jsi::Runtime rt;
+    TouchTraceReplayer ra(a, rt), rb(b, rt);
+    auto fa = ra.replay(trace), fb = rb.replay(copy);
+    CHECK(fa.size() == fb.size());
+    for (size_t i = 0; i < fa.size() && i < fb.size(); i++) {
+        CHECK_NEAR(fa[i].offsetY, fb[i].offsetY, 0);
+    }
+}
+
+TEST(handWrittenTraceTicksAtSceneFrameRate) {
+    // No vsync records: frames are synthesized at F until the scroll settles
+    auto trace = TouchTrace::fromString(
+        "F 120\n"
+        "N 1 0 19 0 0 0 0 100 100 0 0\n"
+        "N 2 1 18 0 0 0 0 100 1000 0 0\n"
+        "E 1 6 0 0.998 100 100 100 1000 0 0 0 0\n"
+        "T 0 50 80 0 1\n"
+        "T 1 50 60 8 1\n"
+        "T 1 50 40 16 1\n"
+        "T 2 50 40 24 1\n");
+    TouchTraceStage stage(trace.scene);
+    auto *engine = stage.engineFor(1);
+    CHECK(engine && !engine->touchResampling);
+    jsi::Runtime rt;
+    TouchTraceReplayer replayer(stage, rt);
+    replayer.watchEngineId = engine ? engine->id : 0;
+    auto frames = replayer.replay(trace);
+    CHECK(frames.size() > 3);
+    if (frames.size() < 2) return;
+    CHECK_NEAR(frames[1].timestamp - frames[0].timestamp, 1000.0 / 120, 1e-6);
+    CHECK(frames.back().offsetY > 40);
+    CHECK(frames.back().phase == ScrollPhase::Idle);
+}
+
+// Root 1 (100x100) holds scroll 2 over content 3, plus a touchable
+// overlay 4 across the top 40pt of the scroll; a 40pt upward drag at y
+static std::string dragScene(float y) {
+    char touches[160];
+    snprintf(touches, sizeof(touches),
+             "T 0 50 %g 0 1\nT 1 50 %g 8 1\nT 1 50 %g 16 1\nT 2 50 %g 24 1\n",
+             y, y - 20, y - 40, y - 40);
+    return std::string(
+        "F 60\n"
+        "N 1 0 18 0 0 0 0 100 100 0 0\n"
+        "N 2 1 19 0 0 0 0 100 100 0 0\n"
+        "N 3 2 18 0 0 0 0 100 1000 0 0\n"
+        "N 4 1 22 0 0 0 0 100 40 0 0\n"
+        "E 2 6 0 0.998 100 100 100 1000 0 0 0 0\n") + touches;
+}
+
+TEST(scrollChainComesFromTheDispatcherHitTest) {
+    jsi::Runtime rt;
+    int hits = 0;
+    auto replay = [&](float y) {
+        auto trace = TouchTrace::fromString(dragScene(y));
+        TouchTraceStage stage(trace.scene);
+        TouchTraceReplayer replayer(stage, rt);
+        replayer.onHit = [&](int, skia::SkiaNode *hit) { hits += hit && hit->id == 4; };
+        replayer.replay(trace);
+        return stage.node(2)->scrollY;
+    };
+    // Below the overlay the drag scrolls; on it, the touch never bubbles
+    // into the scroll behind
+    CHECK(replay(90) > 30);
+    CHECK(hits == 0);
+    CHECK_NEAR(replay(30), 0, 0);
+    CHECK(hits == 1);
+}
+
+TEST(replayDrivesGestureRecognizers) {
+    auto trace = TouchTrace::fromString(dragScene(90));
+    TouchTraceStage stage(trace.scene);
+    auto &dispatcher = stage.dispatcher();
+    stage.node(3)->touchable = true;
+    dispatcher.onNodePropChanged(stage.node(3), "touchable");
+    int pan = dispatcher.attachGesture(3, "pan");
+    float slots[GESTURE_SHARED_SLOTS] = {};
+    dispatcher.setGestureSharedSlots(pan, slots);
+
+    jsi::Runtime rt;
+    TouchTraceReplayer replayer(stage, rt);
+    replayer.replay(trace);
+    CHECK(static_cast<GestureState>(slots[0]) == GestureState::Ended);
+    CHECK_NEAR(slots[4], -40, 1e-4); // translationY
+    CHECK(stage.node(2)->scrollY > 30); // the scroll still got the drag
+}
+
+TEST(headerlessTraceStillReads) {
+    auto trace = TouchTrace::fromString(
+        "# zilol touch trace v1\n"
+        "T 0 10 10 0 1\n"
+        "V 16 16\n");
+    CHECK(trace.events.size() == 2);
+    CHECK(trace.scene.nodes.empty());
+    CHECK_NEAR(trace.scene.frameRate, 60, 0);
+}
+
+ZILOL_TEST_MAIN()
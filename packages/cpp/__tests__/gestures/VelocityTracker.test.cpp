@@ -0,0 +1,75 @@
+// VelocityTracker: the least-squares estimator at degree 1 and 2, and
+// the history window both estimators read.
+
+#include "Check.h"
+#include "gestures/VelocityTracker.h"
+
+using namespace zilol::gestures;
+
+static VelocityTracker leastSquares(int degree) {
+    VelocityTracker tracker;
+    tracker.estimator = VelocityEstimator::LeastSquares;
+    tracker.lsqDegree = degree;
+    return tracker;
+}
+
+TEST(linearFitRecoversConstantVelocity) {
+    // x = 3 + 0.5·t (ms) → 500 px/s, whatever the sample spacing
+    const double times[] = {0, 7, 16, 24, 33, 41, 50};
+    for (int degree = 1; degree <= 2; degree++) {
+        auto tracker = leastSquares(degree);
+        for (double t : times) tracker.addPoint(t, static_cast<float>(3 + 0.5 * t));
+        CHECK_NEAR(tracker.getVelocity(), 500, 0.05);
+    }
+}
+
+TEST(quadraticFitReadsVelocityAtTheNewestSample) {
+    // x = 0.01·t², so dx/dt at t = 80 is 1.6 px/ms
+    auto quadratic = leastSquares(2);
+    auto linear = leastSquares(1);
+    for (double t = 0; t <= 80; t += 8) {
+        float x = static_cast<float>(0.01 * t * t);
+        quadratic.addPoint(t, x);
+        linear.addPoint(t, x);
+    }
+    CHECK_NEAR(quadratic.getVelocity(), 1600, 0.5);
+    // A line through an accelerating drag lags it: the mean slope, 0.8 px/ms
+    CHECK_NEAR(linear.getVelocity(), 800, 0.5);
+}
+
+TEST(quadraticFallsBackToLinearWithTwoSamples) {
+    auto tracker = leastSquares(2);
+    tracker.addPoint(100, 10);
+    CHECK(tracker.getVelocity() == 0);
+    tracker.addPoint(110, 30);
+    CHECK_NEAR(tracker.getVelocity(), 2000, 1e-3);
+}
+
+TEST(samplesOutsideTheWindowAreDropped) {
+    auto tracker = leastSquares(1);
+    // A fast move long before the window, then a slow one inside it
+    tracker.addPoint(0, 0);
+    tracker.addPoint(10, 100);
+    for (double t = 200; t <= 300; t += 10) {
+        tracker.addPoint(t, static_cast<float>(100 + 0.1 * (t - 200)));
+    }
+    CHECK_NEAR(tracker.getVelocity(), 100, 0.05);
+    CHECK(tracker.size() == 11);
+}
+
+TEST(outOfOrderSamplesAreIgnored) {
+    auto tracker = leastSquares(1);
+    tracker.addPoint(0, 0);
+    tracker.addPoint(10, 10);
+    tracker.addPoint(10, 500); // duplicate timestamp
+    tracker.addPoint(5, 500);  // older than the newest
+    tracker.addPoint(20, 20);
+    CHECK(tracker.size() == 3);
+    CHECK_NEAR(tracker.getVelocity(), 1000, 1e-3);
+
+    tracker.reset();
+    CHECK(tracker.size() == 0);
+    CHECK(tracker.getVelocity() == 0);
+}
+
+ZILOL_TEST_MAIN()
@@ -0,0 +1,32 @@
+/**
+ * Bench.h — timing helper for the native benchmarks.
+ *
+ * Benchmarks are plain executables (not ctest cases): build with
+ * CMAKE_BUILD_TYPE=Release and run them from the build directory.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace zilol {
+namespace test {
+
+/// Best of `runs` timings of `iterations` calls to `fn`, in µs per call.
+template <typename Fn>
+double bestOfUs(int runs, int iterations, Fn &&fn) {
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) fn(r, i);
+        double us = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - t0).count();
+        best = std::min(best, us / iterations);
+    }
+    return best;
+}
+
+} // namespace test
+} // namespace zilol
@@ -0,0 +1,77 @@
+/**
+ * Check.h — minimal assertions for the native tests.
+ *
+ * Each test file is its own executable: TEST(name) cases register
+ * themselves and main() comes from ZILOL_TEST_MAIN(). A failing CHECK
+ * reports and continues; the process exits non-zero if any failed.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace zilol {
+namespace test {
+
+struct Case {
+    const char *name;
+    std::function<void()> run;
+};
+
+inline std::vector<Case> &cases() {
+    static std::vector<Case> all;
+    return all;
+}
+
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+struct Register {
+    Register(const char *name, std::function<void()> run) { cases().push_back({name, std::move(run)}); }
+};
+
+inline int runAll() {
+    for (auto &c : cases()) {
+        int before = failures();
+        c.run();
+        fprintf(stderr, "%s %s\n", failures() == before ? "[ OK ]" : "[FAIL]", c.name);
+    }
+    return failures() == 0 ? 0 : 1;
+}
+
+} // namespace test
+} // namespace zilol
+
+#define ZILOL_TEST_CAT2(a, b) a##b
+#define ZILOL_TEST_CAT(a, b) ZILOL_TEST_CAT2(a, b)
+
+#define TEST(name)                                                              \
+    static void name();                                                         \
+    static ::zilol::test::Register ZILOL_TEST_CAT(register_, name)(#name, name); \
+    static void name()
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ::zilol::test::failures()++;                                        \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance)                                             \
+    do {                                                                        \
+        double va_ = (a), vb_ = (b);                                            \
+        if (!(std::fabs(va_ - vb_) <= (tolerance))) {                           \
+            fprintf(stderr, "%s:%d: CHECK_NEAR(%s, %s) failed: %g vs %g\n",     \
+                    __FILE__, __LINE__, #a, #b, va_, vb_);                      \
+            ::zilol::test::failures()++;                                        \
+        }                                                                       \
+    } while (0)
+
+#define ZILOL_TEST_MAIN() \
+    int main() { return ::zilol::test::runAll(); }
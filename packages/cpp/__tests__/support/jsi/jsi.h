@@ -0,0 +1,431 @@
+/**
+ * jsi.h — test double for facebook::jsi.
+ *
+ * A small in-memory object model, enough for the JSI registration code
+ * in the headers to run headlessly: values are undefined, null, bool,
+ * number, string or object; objects hold named properties, array
+ * elements, a host function, a host object or an array buffer. Handles
+ * share their object like JSI's do. There is no interpreter — tests
+ * build arguments in C++ and call the registered host functions.
+ *
+ * Type errors (asNumber() on a string, …) throw JSError, as Hermes does.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook {
+namespace jsi {
+
+class Runtime;
+class Object;
+class Function;
+class Array;
+class ArrayBuffer;
+class Value;
+class HostObject;
+
+namespace detail {
+struct ObjectData;
+}
+
+class JSError : public std::exception {
+public:
+    JSError() = default;
+    JSError(Runtime &, std::string message) : message_(std::move(message)) {}
+    explicit JSError(std::string message) : message_(std::move(message)) {}
+    const char *what() const noexcept override { return message_.c_str(); }
+
+private:
+    std::string message_ = "JSError";
+};
+
+class PropNameID {
+public:
+    static PropNameID forAscii(Runtime &, const char *name) { return PropNameID(name); }
+    static PropNameID forUtf8(Runtime &, const std::string &name) { return PropNameID(name); }
+    std::string utf8(Runtime &) const { return name_; }
+
+private:
+    explicit PropNameID(std::string name) : name_(std::move(name)) {}
+    std::string name_;
+};
+
+class String {
+public:
+    static String createFromUtf8(Runtime &, const std::string &s) { return String(s); }
+    static String createFromAscii(Runtime &, const char *s) { return String(s); }
+    std::string utf8(Runtime &) const { return s_; }
+
+private:
+    friend class Value;
+    explicit String(std::string s) : s_(std::move(s)) {}
+    std::string s_;
+};
+
+/// Native memory behind an ArrayBuffer.
+class MutableBuffer {
+public:
+    virtual ~MutableBuffer() = default;
+    virtual size_t size() const = 0;
+    virtual uint8_t *data() = 0;
+};
+
+class HostObject {
+public:
+    virtual ~HostObject() = default;
+    virtual Value get(Runtime &, const PropNameID &);
+    virtual void set(Runtime &, const PropNameID &, const Value &);
+    virtual std::vector<PropNameID> getPropertyNames(Runtime &) { return {}; }
+};
+
+using HostFunctionType =
+    std::function<Value(Runtime &, const Value &, const Value *, size_t)>;
+
+class Object {
+public:
+    explicit Object(Runtime &);
+    Object(Object &&) = default;
+    Object &operator=(Object &&) = default;
+
+    template <typename T> void setProperty(Runtime &rt, const char *name, T &&value);
+    template <typename T> void setProperty(Runtime &rt, const PropNameID &name, T &&value) {
+        setProperty(rt, name.utf8(rt).c_str(), std::forward<T>(value));
+    }
+    Value getProperty(Runtime &, const char *name) const;
+    Value getProperty(Runtime &, const PropNameID &name) const;
+    bool hasProperty(Runtime &, const char *name) const;
+    Array getPropertyNames(Runtime &) const;
+    Object getPropertyAsObject(Runtime &, const char *name) const;
+    Function getPropertyAsFunction(Runtime &, const char *name) const;
+
+    bool isFunction(Runtime &) const;
+    Function asFunction(Runtime &) const;
+    Function getFunction(Runtime &) const;
+    bool isArray(Runtime &) const;
+    Array asArray(Runtime &) const;
+    Array getArray(Runtime &) const;
+    bool isArrayBuffer(Runtime &) const;
+    ArrayBuffer getArrayBuffer(Runtime &) const;
+
+    static Object createFromHostObject(Runtime &, std::shared_ptr<HostObject> host);
+    template <typename T> bool isHostObject(Runtime &) const;
+    template <typename T> std::shared_ptr<T> getHostObject(Runtime &) const;
+
+    /// Same object (JS ===).
+    static bool strictEquals(Runtime &, const Object &a, const Object &b) {
+        return a.data_ == b.data_;
+    }
+
+protected:
+    friend class Value;
+    friend class Runtime;
+    explicit Object(std::shared_ptr<detail::ObjectData> data) : data_(std::move(data)) {}
+    std::shared_ptr<detail::ObjectData> data_;
+};
+
+class Array : public Object {
+public:
+    Array(Runtime &rt, size_t length);
+    size_t size(Runtime &) const;
+    size_t length(Runtime &rt) const { return size(rt); }
+    Value getValueAtIndex(Runtime &, size_t i) const;
+    template <typename T> void setValueAtIndex(Runtime &rt, size_t i, T &&value);
+
+private:
+    friend class Object;
+    explicit Array(std::shared_ptr<detail::ObjectData> data) : Object(std::move(data)) {}
+};
+
+class Function : public Object {
+public:
+    static Function createFromHostFunction(Runtime &, const PropNameID &, unsigned int,
+                                           HostFunctionType fn);
+    template <typename... Args> Value call(Runtime &rt, Args &&...args) const;
+    Value call(Runtime &rt, const Value *args, size_t count) const;
+    template <typename... Args> Value callAsConstructor(Runtime &rt, Args &&...args) const;
+
+private:
+    friend class Object;
+    explicit Function(std::shared_ptr<detail::ObjectData> data) : Object(std::move(data)) {}
+};
+
+class ArrayBuffer : public Object {
+public:
+    ArrayBuffer(Runtime &, std::shared_ptr<MutableBuffer> buffer);
+    size_t size(Runtime &) const;
+    size_t length(Runtime &rt) const { return size(rt); }
+    uint8_t *data(Runtime &) const;
+
+private:
+    friend class Object;
+    explicit ArrayBuffer(std::shared_ptr<detail::ObjectData> data) : Object(std::move(data)) {}
+};
+
+class Value {
+public:
+    enum class Kind : uint8_t { Undefined, Null, Bool, Number, String, Object };
+
+    Value() {}
+    Value(std::nullptr_t) : kind_(Kind::Null) {}
+    Value(bool b) : kind_(Kind::Bool), number_(b ? 1 : 0) {}
+    Value(double d) : kind_(Kind::Number), number_(d) {}
+    Value(int i) : kind_(Kind::Number), number_(i) {}
+    Value(Runtime &, const Value &other)
+        : kind_(other.kind_), number_(other.number_), string_(other.string_),
+          object_(other.object_) {}
+    Value(Runtime &rt, const Object &object) : Value(rt, Value(Object(object.data_))) {}
+    Value(Object &&object) : kind_(Kind::Object), object_(std::move(object.data_)) {}
+    Value(String &&s) : kind_(Kind::String), string_(std::move(s.s_)) {}
+    Value(Value &&) = default;
+    Value &operator=(Value &&) = default;
+
+    static Value undefined() { return Value(); }
+    static Value null() { return Value(nullptr); }
+
+    bool isUndefined() const { return kind_ == Kind::Undefined; }
+    bool isNull() const { return kind_ == Kind::Null; }
+    bool isNumber() const { return kind_ == Kind::Number; }
+    bool isBool() const { return kind_ == Kind::Bool; }
+    bool isString() const { return kind_ == Kind::String; }
+    bool isObject() const { return kind_ == Kind::Object; }
+
+    double asNumber() const { expect(Kind::Number, "number"); return number_; }
+    double getNumber() const { return asNumber(); }
+    bool asBool() const { expect(Kind::Bool, "bool"); return number_ != 0; }
+    bool getBool() const { return asBool(); }
+    Object asObject(Runtime &) const { expect(Kind::Object, "object"); return Object(object_); }
+    Object getObject(Runtime &rt) const { return asObject(rt); }
+    String asString(Runtime &) const { expect(Kind::String, "string"); return String(string_); }
+    String getString(Runtime &rt) const { return asString(rt); }
+    String toString(Runtime &) const;
+
+private:
+    Kind kind_ = Kind::Undefined;
+    double number_ = 0;
+    std::string string_;
+    std::shared_ptr<detail::ObjectData> object_;
+
+    void expect(Kind kind, const char *what) const {
+        if (kind_ != kind) throw JSError(std::string("Value is not a ") + what);
+    }
+};
+
+namespace detail {
+
+struct ObjectData {
+    std::map<std::string, Value> properties;
+    bool array = false;
+    std::vector<Value> elements;
+    HostFunctionType function;
+    std::shared_ptr<HostObject> host;
+    std::shared_ptr<MutableBuffer> buffer;
+};
+
+/// setProperty / setValueAtIndex take anything a Value is built from;
+/// a Value is copied.
+template <typename T> Value toValue(Runtime &rt, T &&value) {
+    if constexpr (std::is_same_v<std::decay_t<T>, Value>) {
+        return Value(rt, value);
+    } else if constexpr (std::is_base_of_v<Object, std::decay_t<T>> &&
+                         !std::is_rvalue_reference_v<T &&>) {
+        return Value(rt, static_cast<const Object &>(value));
+    } else {
+        return Value(std::forward<T>(value));
+    }
+}
+
+inline std::shared_ptr<ObjectData> make() { return std::make_shared<ObjectData>(); }
+
+} // namespace detail
+
+class Runtime {
+public:
+    Runtime() : global_(detail::make()) {}
+    virtual ~Runtime() = default;
+    Object global() { return Object(global_); }
+
+private:
+    std::shared_ptr<detail::ObjectData> global_;
+};
+
+// ── HostObject ──
+
+inline Value HostObject::get(Runtime &, const PropNameID &) { return Value(); }
+inline void HostObject::set(Runtime &, const PropNameID &name, const Value &) {
+    (void)name;
+    throw JSError("HostObject has no setter");
+}
+
+// ── Object ──
+
+inline Object::Object(Runtime &) : data_(detail::make()) {}
+
+template <typename T>
+void Object::setProperty(Runtime &rt, const char *name, T &&value) {
+    Value v = detail::toValue(rt, std::forward<T>(value));
+    if (data_->host) {
+        data_->host->set(rt, PropNameID::forAscii(rt, name), v);
+        return;
+    }
+    data_->properties[name] = std::move(v);
+}
+
+inline Value Object::getProperty(Runtime &rt, const char *name) const {
+    if (data_->host) return data_->host->get(rt, PropNameID::forAscii(rt, name));
+    if (data_->array && std::string(name) == "length") {
+        return Value(static_cast<double>(data_->elements.size()));
+    }
+    auto it = data_->properties.find(name);
+    return it != data_->properties.end() ? Value(rt, it->second) : Value();
+}
+
+inline Value Object::getProperty(Runtime &rt, const PropNameID &name) const {
+    return getProperty(rt, name.utf8(rt).c_str());
+}
+
+inline bool Object::hasProperty(Runtime &rt, const char *name) const {
+    if (data_->host) return !data_->host->get(rt, PropNameID::forAscii(rt, name)).isUndefined();
+    return data_->properties.count(name) > 0;
+}
+
+inline Array Object::getPropertyNames(Runtime &rt) const {
+    Array names(rt, 0);
+    if (data_->host) {
+        for (auto &name : data_->host->getPropertyNames(rt)) {
+            names.data_->elements.push_back(Value(String::createFromUtf8(rt, name.utf8(rt))));
+        }
+        return names;
+    }
+    for (auto &entry : data_->properties) {
+        names.data_->elements.push_back(Value(String::createFromUtf8(rt, entry.first)));
+    }
+    return names;
+}
+
+inline Object Object::getPropertyAsObject(Runtime &rt, const char *name) const {
+    return getProperty(rt, name).asObject(rt);
+}
+
+inline Function Object::getPropertyAsFunction(Runtime &rt, const char *name) const {
+    return getPropertyAsObject(rt, name).asFunction(rt);
+}
+
+inline bool Object::isFunction(Runtime &) const { return static_cast<bool>(data_->function); }
+inline Function Object::asFunction(Runtime &) const {
+    if (!data_->function) throw JSError("Object is not a function");
+    return Function(data_);
+}
+inline Function Object::getFunction(Runtime &rt) const { return asFunction(rt); }
+inline bool Object::isArray(Runtime &) const { return data_->array; }
+inline Array Object::asArray(Runtime &) const {
+    if (!data_->array) throw JSError("Object is not an array");
+    return Array(data_);
+}
+inline Array Object::getArray(Runtime &rt) const { return asArray(rt); }
+inline bool Object::isArrayBuffer(Runtime &) const { return static_cast<bool>(data_->buffer); }
+inline ArrayBuffer Object::getArrayBuffer(Runtime &) const {
+    if (!data_->buffer) throw JSError("Object is not an ArrayBuffer");
+    return ArrayBuffer(data_);
+}
+
+inline Object Object::createFromHostObject(Runtime &, std::shared_ptr<HostObject> host) {
+    auto data = detail::make();
+    data->host = std::move(host);
+    return Object(std::move(data));
+}
+
+template <typename T> bool Object::isHostObject(Runtime &) const {
+    return std::dynamic_pointer_cast<T>(data_->host) != nullptr;
+}
+
+template <typename T> std::shared_ptr<T> Object::getHostObject(Runtime &) const {
+    return std::dynamic_pointer_cast<T>(data_->host);
+}
+
+// ── Array ──
+
+inline Array::Array(Runtime &rt, size_t length) : Object(rt) {
+    data_->array = true;
+    data_->elements.resize(length);
+}
+
+inline size_t Array::size(Runtime &) const { return data_->elements.size(); }
+
+inline Value Array::getValueAtIndex(Runtime &rt, size_t i) const {
+    if (i >= data_->elements.size()) return Value();
+    return Value(rt, data_->elements[i]);
+}
+
+template <typename T>
+void Array::setValueAtIndex(Runtime &rt, size_t i, T &&value) {
+    if (i >= data_->elements.size()) data_->elements.resize(i + 1);
+    data_->elements[i] = detail::toValue(rt, std::forward<T>(value));
+}
+
+// ── Function ──
+
+inline Function Function::createFromHostFunction(Runtime &, const PropNameID &, unsigned int,
+                                                 HostFunctionType fn) {
+    auto data = detail::make();
+    data->function = std::move(fn);
+    return Function(std::move(data));
+}
+
+inline Value Function::call(Runtime &rt, const Value *args, size_t count) const {
+    return data_->function(rt, Value(), args, count);
+}
+
+template <typename... Args>
+Value Function::call(Runtime &rt, Args &&...args) const {
+    Value values[] = {Value(), detail::toValue(rt, std::forward<Args>(args))...};
+    return call(rt, static_cast<const Value *>(values + 1), sizeof...(Args));
+}
+
+template <typename... Args>
+Value Function::callAsConstructor(Runtime &rt, Args &&...args) const {
+    return call(rt, std::forward<Args>(args)...);
+}
+
+// ── ArrayBuffer ──
+
+inline ArrayBuffer::ArrayBuffer(Runtime &rt, std::shared_ptr<MutableBuffer> buffer)
+    : Object(rt) {
+    data_->buffer = std::move(buffer);
+}
+
+inline size_t ArrayBuffer::size(Runtime &) const { return data_->buffer->size(); }
+inline uint8_t *ArrayBuffer::data(Runtime &) const { return data_->buffer->data(); }
+
+// ── Value ──
+
+inline String Value::toString(Runtime &) const {
+    switch (kind_) {
+        case Kind::Undefined: return String("undefined");
+        case Kind::Null: return String("null");
+        case Kind::Bool: return String(number_ != 0 ? "true" : "false");
+        case Kind::Number: {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%g", number_);
+            return String(buf);
+        }
+        case Kind::String: return String(string_);
+        case Kind::Object: return String("[object Object]");
+    }
+    return String("");
+}
+
+} // namespace jsi
+} // namespace facebook
@@ -0,0 +1,31 @@
+/**
+ * ColorParser.h — test double for the renderer's color parser.
+ *
+ * Parses "#rgb", "#rrggbb", "#rrggbbaa" and "transparent" into
+ * 0xAARRGGBB; anything else parses as opaque black.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace zilol {
+namespace skia {
+
+inline uint32_t parseColor(const std::string &str) {
+    if (str == "transparent") return 0;
+    if (str.size() < 2 || str[0] != '#') return 0xFF000000;
+    std::string hex = str.substr(1);
+    if (hex.size() == 3) hex = {hex[0], hex[0], hex[1], hex[1], hex[2], hex[2]};
+    if (hex.size() != 6 && hex.size() != 8) return 0xFF000000;
+    char *end = nullptr;
+    auto value = static_cast<uint32_t>(std::strtoul(hex.c_str(), &end, 16));
+    if (*end) return 0xFF000000;
+    if (hex.size() == 6) return 0xFF000000 | value;
+    return (value >> 8) | (value << 24); // rrggbbaa → aarrggbb
+}
+
+} // namespace skia
+} // namespace zilol
@@ -0,0 +1,112 @@
+/**
+ * SkiaNodeTree.h — test double for the renderer's node tree.
+ *
+ * Carries only the SkiaNode fields the engines under packages/cpp read
+ * or write, and a tree that owns its nodes so tests can build scenes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zilol {
+namespace skia {
+
+enum class NodeType { View, Text, Image, Scroll, Canvas, Marker, Platform, ActivityIndicator };
+
+struct NodeLayout {
+    float x = 0, y = 0, width = 0, height = 0;
+    float absoluteX = 0, absoluteY = 0;
+};
+
+struct BorderRadii {
+    float topLeft = 0, topRight = 0, bottomRight = 0, bottomLeft = 0;
+};
+
+struct SkiaNode {
+    int id = 0;
+    NodeType type = NodeType::View;
+    SkiaNode *parent = nullptr;
+    std::vector<SkiaNode *> children;
+    NodeLayout layout;
+
+    bool visible = true;
+    std::string display;
+    bool touchable = false;
+
+    // Scroll
+    float scrollX = 0, scrollY = 0;
+    float zoomScale = 1;
+    bool horizontal = false;
+    bool scrollEnabled = true;
+
+    // Animatable
+    float opacity = 1;
+    BorderRadii borderRadii;
+    float borderWidth = 0;
+    float fontSize = 14;
+    float rotationAngle = 0;
+    float translateX = 0, translateY = 0;
+    float scaleX = 1, scaleY = 1;
+
+    // Colors, 0xAARRGGBB as parsed by parseColor
+    uint32_t backgroundColor = 0;
+    uint32_t borderColor = 0xFF000000;
+    uint32_t color = 0xFF000000;
+
+    int dirtyCount = 0;
+    void markDirty() { dirtyCount++; }
+};
+
+class SkiaNodeTree {
+public:
+    SkiaNode *create(NodeType type = NodeType::View) {
+        auto node = std::make_unique<SkiaNode>();
+        node->id = nextId_++;
+        node->type = type;
+        auto *ptr = node.get();
+        nodes_[ptr->id] = std::move(node);
+        return ptr;
+    }
+
+    void appendChild(SkiaNode *parent, SkiaNode *child) {
+        child->parent = parent;
+        parent->children.push_back(child);
+    }
+
+    void removeChild(SkiaNode *parent, SkiaNode *child) {
+        auto &c = parent->children;
+        c.erase(std::remove(c.begin(), c.end(), child), c.end());
+        if (child->parent == parent) child->parent = nullptr;
+    }
+
+    /// Recompute absolute positions from relative layout under `node`.
+    void layoutAbsolute(SkiaNode *node) {
+        float px = node->parent ? node->parent->layout.absoluteX : 0;
+        float py = node->parent ? node->parent->layout.absoluteY : 0;
+        node->layout.absoluteX = px + node->layout.x;
+        node->layout.absoluteY = py + node->layout.y;
+        for (auto *child : node->children) layoutAbsolute(child);
+    }
+
+    void setRoot(SkiaNode *root) { root_ = root; }
+    SkiaNode *getRoot() { return root_; }
+
+    SkiaNode *getNode(int id) {
+        auto it = nodes_.find(id);
+        return it != nodes_.end() ? it->second.get() : nullptr;
+    }
+
+private:
+    int nextId_ = 1;
+    SkiaNode *root_ = nullptr;
+    std::unordered_map<int, std::unique_ptr<SkiaNode>> nodes_;
+};
+
+} // namespace skia
+} // namespace zilol
@@ -6,12 +6,31 @@
  *
  * Three built-in drivers:
  *   - Timing: duration + easing interpolation
- *   - Spring: critically-damped spring
+ *   - Spring: closed-form damped spring, any damping ratio
  *   - Decay: exponential velocity decay
  *
+ * Running animations are stored per driver in structure-of-arrays lanes
+ * and ticked in one tight loop per driver; an id → slot index serves
+ * cancellation.
+ *
+ * Compositions (sequence, parallel, stagger, loop, delay) run natively
+ * and report completion once. Completions are collected during the tick
+ * and delivered after it — in one JS call when a batch dispatcher is set.
+ *
+ * Vector props (position, translate, scale, transform, and the colors
+ * as premultiplied RGBA) are driven by one timing or spring driver
+ * running over a shared progress value; every component follows it and
+ * is written to the node in one call.
+ *
+ * Slot changes and tick passes can be observed in order; replaying them
+ * rebuilds the exact driver state (see AnimationTimeline).
+ *
  * JSI API:
  *   __animateNode(nodeId, prop, driverType, config) → animId
- *   __animateCancel(animId)
+ *   __animateComposite(spec, onFinish?) → id
+ *   __animateCancel(id)
+ *   __animateRetarget(animId, toValue, config?) → bool
+ *   __animateSetBatchDispatcher(fn)   fn([id, finished, id, finished, ...])
  *
  * Writes directly to the C++ SkiaNode props — zero bridge crossings.
  */
@@ -20,14 +39,21 @@
 
 #include "skia/SkiaNodeTree.h"
 #include "skia/ColorParser.h"
+#include "animation/Easing.h"
+#include "animation/NodeProps.h"
+#include "animation/Spring.h"
 
 #include <jsi/jsi.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <functional>
+#include <limits>
 #include <string>
 
 #ifndef M_PI
@@ -37,39 +63,6 @@
 namespace zilol {
 namespace animation {
 
-// ---------------------------------------------------------------------------
-// Easing functions
-// ---------------------------------------------------------------------------
-
-using EasingFn = float (*)(float);
-
-inline float easeLinear(float t) { return t; }
-
-inline float easeInQuad(float t) { return t * t; }
-inline float easeOutQuad(float t) { return t * (2 - t); }
-inline float easeInOutQuad(float t) {
-    return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
-}
-
-inline float easeInCubic(float t) { return t * t * t; }
-inline float easeOutCubic(float t) { float u = t - 1; return u * u * u + 1; }
-inline float easeInOutCubic(float t) {
-    return t < 0.5f ? 4 * t * t * t : (t - 1) * (2 * t - 2) * (2 * t - 2) + 1;
-}
-
-inline float easeInOut(float t) { return easeInOutCubic(t); }
-
-inline EasingFn easingFromString(const std::string &name) {
-    if (name == "linear") return easeLinear;
-    if (name == "easeIn") return easeInQuad;
-    if (name == "easeOut") return easeOutQuad;
-    if (name == "easeInOut" || name == "default") return easeInOut;
-    if (name == "easeInCubic") return easeInCubic;
-    if (name == "easeOutCubic") return easeOutCubic;
-    if (name == "easeInOutCubic") return easeInOutCubic;
-    return easeInOut; // default
-}
-
 // ---------------------------------------------------------------------------
 // Animation driver types
 // ---------------------------------------------------------------------------
@@ -78,28 +71,29 @@ enum class DriverType : uint8_t {
     Timing, Spring, Decay
 };
 
+// Vector animations drive progress over 0..1000 so the px-tuned spring
+// rest thresholds apply (0.5 → 1/2000 of the from → to distance)
+static constexpr float VECTOR_PROGRESS_SCALE = 1000.0f;
+
 // ---------------------------------------------------------------------------
-// Animation — a single running animation
+// Animation — start parameters for a single animation
 // ---------------------------------------------------------------------------
 
 struct Animation {
     int id = 0;
     skia::SkiaNode *node = nullptr;
-    std::string prop; // which prop to animate
+    PropId prop = PropId::Unknown; // which prop to animate (resolved at start)
 
     DriverType driverType = DriverType::Timing;
 
-    // Common state
     float fromValue = 0;
     float toValue = 0;
-    float currentValue = 0;
-    float startTime = 0;
-    bool started = false;
-    bool finished = false;
+    float startTime = -1; // ms; < 0 = the first tick after start()
 
     // Timing driver
     float duration = 300; // ms
     EasingFn easing = easeInOut;
+    EasingTableRef easingTable; // overrides `easing` when set
 
     // Spring driver
     float springTension = 170;
@@ -111,117 +105,565 @@ struct Animation {
     float decayVelocity = 0;
     float decayRate = 0.998f;
 
+    // Vector props — set instead of `prop`; springVelocity is then a
+    // fraction of the distance per ms.
+    VectorPropId vectorProp = VectorPropId::None;
+    VectorValue fromVector{};
+    VectorValue toVector{};
+
     // JS completion callback
     std::shared_ptr<facebook::jsi::Function> onFinishCallback;
+};
+
+// ---------------------------------------------------------------------------
+// SlotState — one running animation's complete driver state
+//
+// Everything a lane slot holds, lifted out so it can be logged and put
+// back bit for bit (AnimationTimeline records and replays these).
+// ---------------------------------------------------------------------------
+
+struct SlotState {
+    int id = 0;
+    DriverType driver = DriverType::Timing;
+    skia::SkiaNode *node = nullptr;
+    PropId prop = PropId::Unknown;
+    float from = 0, to = 0;
+    float startTime = -1;
 
-    // ── Tick ──────────────────────────────────────────────────
+    // Timing
+    float invDuration = 0;
+    EasingFn easing = nullptr;
+    EasingTableRef table;
 
-    void tick(float timestamp) {
-        if (finished) return;
+    // Spring
+    float tension = 0, friction = 0, mass = 0;
+    SpringSolution solution;
 
-        if (!started) {
-            startTime = timestamp;
-            started = true;
+    float velocity = 0; // Spring: current; Decay: initial
+
+    // Decay
+    float logRate = 0, distance = 0;
+
+    // Vector track (the slot itself then drives bare progress)
+    VectorPropId vectorProp = VectorPropId::None;
+    skia::SkiaNode *vectorNode = nullptr;
+    VectorValue vectorFrom{};
+    VectorValue vectorTo{};
+};
+
+// ---------------------------------------------------------------------------
+// Driver lanes — structure-of-arrays animation state
+//
+// Each driver keeps its running animations in dense parallel arrays, so a
+// frame is one tick per driver over contiguous columns that fills `value`
+// and stores it into each node — no per-animation allocation or pointer
+// chase. Timing slots never call out, so their value loops vectorize and
+// a separate write-back pass follows them. Spring and decay slots call
+// exp (and cos/sin for ringing springs) every frame; their node writes
+// stay in the math loop, where they hide behind that latency, as a
+// second pass over the nodes measured slower (bench/LaneTickBench.cpp).
+// Slots are removed by moving the last slot into the hole, and
+// retargeted by storing new parameters over the slot in place.
+// ---------------------------------------------------------------------------
+
+/// Columns shared by every driver.
+struct LaneBase {
+    std::vector<int> ids;
+    std::vector<skia::SkiaNode *> nodes;
+    std::vector<PropId> props;
+    std::vector<float> from;
+    std::vector<float> to;
+    std::vector<float> value;
+    std::vector<float> startTime; // < 0 until the first tick
+    std::vector<uint8_t> finished;
+
+    size_t size() const { return ids.size(); }
+
+    template <typename Fn>
+    void forEachColumn(Fn &&fn) {
+        fn(ids); fn(nodes); fn(props);
+        fn(from); fn(to); fn(value); fn(startTime); fn(finished);
+    }
+
+    /// Move every latched start `ms` later; unlatched slots are untouched.
+    void shiftStart(float ms) {
+        for (float &start : startTime) {
+            if (start >= 0) start += ms;
         }
+    }
 
-        float elapsed = timestamp - startTime;
-        float dt = elapsed; // total elapsed for timing, per-frame for spring/decay
+protected:
+    void storeBase(size_t i, const Animation &anim) {
+        ids[i] = anim.id;
+        nodes[i] = anim.node;
+        props[i] = anim.prop;
+        from[i] = anim.fromValue;
+        to[i] = anim.toValue;
+        value[i] = anim.fromValue;
+        startTime[i] = anim.startTime;
+        finished[i] = 0;
+    }
 
-        switch (driverType) {
-            case DriverType::Timing:
-                tickTiming(elapsed);
-                break;
-            case DriverType::Spring:
-                tickSpring(std::min(timestamp - (startTime > 0 ? startTime : timestamp), 32.0f));
-                break;
-            case DriverType::Decay:
-                tickDecay(elapsed);
-                break;
+    void captureBase(size_t i, SlotState &s) const {
+        s.id = ids[i];
+        s.node = nodes[i];
+        s.prop = props[i];
+        s.from = from[i];
+        s.to = to[i];
+        s.startTime = startTime[i];
+    }
+
+    void restoreBase(size_t i, const SlotState &s) {
+        ids[i] = s.id;
+        nodes[i] = s.node;
+        props[i] = s.prop;
+        from[i] = s.from;
+        to[i] = s.to;
+        value[i] = s.from;
+        startTime[i] = s.startTime;
+        finished[i] = 0;
+    }
+
+    /// Append one default slot to every column of `lane`.
+    template <typename Lane>
+    static size_t grow(Lane &lane) {
+        lane.forEachColumn([](auto &column) { column.emplace_back(); });
+        return lane.size() - 1;
+    }
+
+    /// Latch the start time of slots ticking for the first time. A
+    /// select rather than a branch, so the loop vectorizes.
+    void latchStart(float timestamp) {
+        float *start = startTime.data();
+        for (size_t i = 0, n = size(); i < n; i++) {
+            start[i] = start[i] < 0 ? timestamp : start[i];
         }
+    }
 
-        // Write to node prop
-        applyValue();
+public:
+    /// Write every slot's value to its node, a run of slots sharing a
+    /// prop at a time.
+    void writeBack() const {
+        const size_t n = size();
+        for (size_t i = 0; i < n;) {
+            size_t end = i + 1;
+            while (end < n && props[end] == props[i]) end++;
+            kPropRunWriters[static_cast<uint8_t>(props[i])](
+                nodes.data() + i, value.data() + i, end - i);
+            i = end;
+        }
     }
+};
 
-private:
-    float lastTickTime_ = 0;
+struct TimingLane : LaneBase {
+    std::vector<float> invDuration; // 1 / ms, 0 = finish on first tick
+    std::vector<EasingFn> easing;         // built-in curve, or nullptr
+    std::vector<EasingTableRef> table;    // any other curve
+    std::vector<float> progress;    // per-frame scratch
 
-    void tickTiming(float elapsed) {
-        if (duration <= 0) {
-            currentValue = toValue;
-            finished = true;
-            return;
+    template <typename Fn>
+    void forEachColumn(Fn &&fn) {
+        LaneBase::forEachColumn(fn);
+        fn(invDuration); fn(easing); fn(table); fn(progress);
+    }
+
+    void push(const Animation &anim) { store(grow(*this), anim); }
+
+    void store(size_t i, const Animation &anim) {
+        storeBase(i, anim);
+        invDuration[i] = anim.duration > 0 ? 1.0f / anim.duration : 0.0f;
+        if (!anim.easingTable && easingBatchFor(anim.easing)) {
+            easing[i] = anim.easing;
+            table[i] = nullptr;
+        } else {
+            easing[i] = nullptr;
+            table[i] = anim.easingTable
+                ? anim.easingTable
+                : EasingTableCache::shared().forFunction(anim.easing);
         }
-        float t = std::min(elapsed / duration, 1.0f);
-        float progress = easing(t);
-        currentValue = fromValue + (toValue - fromValue) * progress;
-        if (t >= 1.0f) {
-            currentValue = toValue;
-            finished = true;
+        progress[i] = 0;
+    }
+
+    void push(const SlotState &s) { restore(grow(*this), s); }
+
+    void restore(size_t i, const SlotState &s) {
+        restoreBase(i, s);
+        invDuration[i] = s.invDuration;
+        easing[i] = s.easing;
+        table[i] = s.table;
+        progress[i] = 0;
+    }
+
+    void capture(size_t i, SlotState &s) const {
+        captureBase(i, s);
+        s.invDuration = invDuration[i];
+        s.easing = easing[i];
+        s.table = table[i];
+    }
+
+    float durationMs(size_t i) const {
+        return invDuration[i] > 0 ? 1.0f / invDuration[i] : 0.0f;
+    }
+
+    /// Rate of change (units/ms) at `timestamp`, from the eased curve's
+    /// central difference.
+    float velocityAt(size_t i, float timestamp) const {
+        if (invDuration[i] <= 0 || startTime[i] < 0) return 0;
+        float t = (timestamp - startTime[i]) * invDuration[i];
+        if (t >= 1.0f) return 0;
+        const float h = 1e-3f;
+        float lo = std::max(t - h, 0.0f), hi = std::min(t + h, 1.0f);
+        auto eased = [&](float x) { return easing[i] ? easing[i](x) : table[i]->sample(x); };
+        float slope = (eased(hi) - eased(lo)) / (hi - lo);
+        return (to[i] - from[i]) * slope * invDuration[i];
+    }
+
+    /// Advance every slot and write it to its node; returns how many
+    /// finished this frame.
+    size_t tick(float timestamp) {
+        size_t finishedCount = advance(timestamp);
+        writeBack();
+        return finishedCount;
+    }
+
+    /// Advance every slot's value without touching the nodes.
+    size_t advance(float timestamp) {
+        const size_t n = size();
+        size_t finishedCount = 0;
+        latchStart(timestamp);
+        const float *start = startTime.data();
+        float *t = progress.data();
+        const float *inv = invDuration.data();
+        uint8_t *done = finished.data();
+
+        // Linear progress; the finished flags and count are a separate
+        // loop so both stay free of control flow
+        for (size_t i = 0; i < n; i++) {
+            float linear = std::min((timestamp - start[i]) * inv[i], 1.0f);
+            t[i] = inv[i] > 0 ? linear : 1.0f;
         }
+        for (size_t i = 0; i < n; i++) done[i] = t[i] >= 1.0f;
+        for (size_t i = 0; i < n; i++) finishedCount += done[i];
+
+        // Easing — built-in curves run as batches over slots sharing the
+        // curve; everything else is one table lookup per slot
+        const EasingFn *ease = easing.data();
+        const EasingTableRef *curve = table.data();
+        for (size_t i = 0; i < n;) {
+            size_t end = i + 1;
+            while (end < n && ease[end] == ease[i]) end++;
+            if (ease[i]) {
+                easingBatchFor(ease[i])(t + i, end - i);
+            } else {
+                for (size_t j = i; j < end; j++) t[j] = curve[j]->sample(t[j]);
+            }
+            i = end;
+        }
+
+        // Interpolate; finished slots land exactly on `to`. Both sides of
+        // the select are computed unconditionally so it vectorizes.
+        const float *a = from.data();
+        const float *b = to.data();
+        float *v = value.data();
+        for (size_t i = 0; i < n; i++) {
+            float target = b[i];
+            v[i] = a[i] + (target - a[i]) * t[i];
+            v[i] = done[i] ? target : v[i];
+        }
+        return finishedCount;
+    }
+};
+
+struct SpringLane : LaneBase {
+    std::vector<float> tension;
+    std::vector<float> friction;
+    std::vector<float> mass;
+    std::vector<SpringSolution> solution; // displacement from `to` over time
+    std::vector<float> velocity;          // current, px/ms
+
+    template <typename Fn>
+    void forEachColumn(Fn &&fn) {
+        LaneBase::forEachColumn(fn);
+        fn(tension); fn(friction); fn(mass); fn(solution); fn(velocity);
+    }
+
+    void push(const Animation &anim) { store(grow(*this), anim); }
+
+    void store(size_t i, const Animation &anim) {
+        storeBase(i, anim);
+        tension[i] = anim.springTension;
+        friction[i] = anim.springFriction;
+        mass[i] = anim.springMass;
+        solution[i] = SpringSolution::solve(
+            anim.fromValue - anim.toValue, anim.springVelocity * 1000.0f,
+            anim.springTension, anim.springFriction, anim.springMass);
+        velocity[i] = anim.springVelocity;
     }
 
-    void tickSpring(float dt) {
-        // Critically damped spring
-        float dtSec = dt / 1000.0f;
-        float displacement = currentValue - toValue;
-        float springForce = -springTension * displacement;
-        float velPxSec = springVelocity * 1000.0f;
-        float dampingForce = -springFriction * velPxSec;
-        float accel = (springForce + dampingForce) / springMass;
-        velPxSec += accel * dtSec;
-        springVelocity = velPxSec / 1000.0f;
-        currentValue += springVelocity * dt;
+    void push(const SlotState &s) { restore(grow(*this), s); }
 
-        if (std::abs(currentValue - toValue) < 0.5f &&
-            std::abs(springVelocity) < 0.01f)
-        {
-            currentValue = toValue;
-            springVelocity = 0;
-            finished = true;
+    void restore(size_t i, const SlotState &s) {
+        restoreBase(i, s);
+        tension[i] = s.tension;
+        friction[i] = s.friction;
+        mass[i] = s.mass;
+        solution[i] = s.solution;
+        velocity[i] = s.velocity;
+    }
+
+    void capture(size_t i, SlotState &s) const {
+        captureBase(i, s);
+        s.tension = tension[i];
+        s.friction = friction[i];
+        s.mass = mass[i];
+        s.solution = solution[i];
+        s.velocity = velocity[i];
+    }
+
+    float durationMs(size_t i) const { return solution[i].settleMs; }
+
+    /// Velocity (px/ms) as of the last tick.
+    float velocityAt(size_t i, float) const { return velocity[i]; }
+
+    /// Advance every slot and write it to its node; returns how many
+    /// finished this frame.
+    size_t tick(float timestamp) {
+        const size_t n = size();
+        size_t finishedCount = 0;
+        latchStart(timestamp);
+        const float *start = startTime.data();
+        const SpringSolution *sol = solution.data();
+        const float *target = to.data();
+        float *vel = velocity.data();
+        float *v = value.data();
+        uint8_t *done = finished.data();
+
+        // Evaluated at elapsed time — exact regardless of frame pacing.
+        // Scalar: evaluate() branches on the damping regime and calls
+        // exp / cos / sin.
+        for (size_t i = 0; i < n; i++) {
+            float elapsed = timestamp - start[i];
+            bool settled = elapsed >= sol[i].settleMs;
+            float x = 0, dx = 0;
+            if (!settled) sol[i].evaluate(elapsed * 0.001f, x, dx);
+            v[i] = target[i] + x;
+            vel[i] = dx * 0.001f;
+            done[i] = settled;
+            finishedCount += settled;
+            writeNodeProp(nodes[i], props[i], v[i]);
         }
+        return finishedCount;
+    }
+};
+
+struct DecayLane : LaneBase {
+    std::vector<float> velocity; // initial, px/ms
+    std::vector<float> logRate;  // ln(rate), so rate^t = exp(t * logRate)
+    std::vector<float> distance; // total travel: velocity / (1 - rate)
+
+    template <typename Fn>
+    void forEachColumn(Fn &&fn) {
+        LaneBase::forEachColumn(fn);
+        fn(velocity); fn(logRate); fn(distance);
     }
 
-    void tickDecay(float elapsed) {
-        float friction = std::pow(decayRate, elapsed);
-        currentValue = fromValue + decayVelocity * (1.0f - friction) / (1.0f - decayRate);
+    void push(const Animation &anim) { store(grow(*this), anim); }
 
-        float currentVel = decayVelocity * friction;
-        if (std::abs(currentVel) < 0.05f) {
-            finished = true;
+    void store(size_t i, const Animation &anim) {
+        storeBase(i, anim);
+        velocity[i] = anim.decayVelocity;
+        logRate[i] = std::log(anim.decayRate);
+        distance[i] = anim.decayVelocity / (1.0f - anim.decayRate);
+    }
+
+    void push(const SlotState &s) { restore(grow(*this), s); }
+
+    void restore(size_t i, const SlotState &s) {
+        restoreBase(i, s);
+        velocity[i] = s.velocity;
+        logRate[i] = s.logRate;
+        distance[i] = s.distance;
+    }
+
+    void capture(size_t i, SlotState &s) const {
+        captureBase(i, s);
+        s.velocity = velocity[i];
+        s.logRate = logRate[i];
+        s.distance = distance[i];
+    }
+
+    float velocityAt(size_t i, float timestamp) const {
+        if (startTime[i] < 0) return velocity[i];
+        return velocity[i] * std::exp(logRate[i] * (timestamp - startTime[i]));
+    }
+
+    /// Time until |velocity| drops below the stop threshold.
+    float durationMs(size_t i) const {
+        float speed = std::abs(velocity[i]);
+        if (speed < 0.05f) return 0;
+        if (logRate[i] >= 0) return std::numeric_limits<float>::infinity();
+        return std::log(0.05f / speed) / logRate[i];
+    }
+
+    /// Advance every slot and write it to its node; returns how many
+    /// finished this frame.
+    size_t tick(float timestamp) {
+        const size_t n = size();
+        size_t finishedCount = 0;
+        latchStart(timestamp);
+        const float *start = startTime.data();
+        const float *v0 = velocity.data();
+        const float *lr = logRate.data();
+        const float *dist = distance.data();
+        const float *a = from.data();
+        float *v = value.data();
+        uint8_t *done = finished.data();
+
+        // Scalar: one exp per slot, with the node write behind it
+        for (size_t i = 0; i < n; i++) {
+            float friction = std::exp(lr[i] * (timestamp - start[i]));
+            done[i] = std::abs(v0[i] * friction) < 0.05f;
+            finishedCount += done[i];
+            v[i] = a[i] + dist[i] * (1.0f - friction);
+            writeNodeProp(nodes[i], props[i], v[i]);
         }
+        return finishedCount;
     }
+};
 
-    void applyValue() {
-        if (!node) return;
+/// A running vector animation. Its driver slot animates progress with no
+/// node; the track maps that progress onto the components.
+struct VectorTrack {
+    skia::SkiaNode *node = nullptr;
+    VectorPropId prop = VectorPropId::None;
+    VectorValue from{};
+    VectorValue to{};
 
-        // Map prop name to node field
-        if (prop == "opacity") {
-            node->opacity = currentValue;
-        } else if (prop == "scrollX") {
-            node->scrollX = currentValue;
-        } else if (prop == "scrollY") {
-            node->scrollY = currentValue;
-        } else if (prop == "borderRadius") {
-            node->borderRadii = {currentValue, currentValue, currentValue, currentValue};
-        } else if (prop == "borderWidth") {
-            node->borderWidth = currentValue;
-        } else if (prop == "fontSize") {
-            node->fontSize = currentValue;
-        } else if (prop == "_rotationAngle") {
-            node->rotationAngle = currentValue;
+    /// Components at driver progress `p` (0..VECTOR_PROGRESS_SCALE).
+    VectorValue at(float p) const {
+        float t = p * (1.0f / VECTOR_PROGRESS_SCALE);
+        VectorValue value{};
+        for (int i = 0; i < vectorProp(prop).components; i++) {
+            value[i] = from[i] + (to[i] - from[i]) * t;
         }
-        // Layout props updated via layout.x/y/width/height directly
-        else if (prop == "x") {
-            node->layout.x = currentValue;
-        } else if (prop == "y") {
-            node->layout.y = currentValue;
+        return value;
+    }
+
+    /// Write the components at driver progress `p`.
+    void apply(float p) const {
+        writeVectorProp(node, prop, at(p));
+    }
+
+    /// Re-aim from the components at progress `p` to `target`. Returns the
+    /// progress velocity that keeps the components' current velocity,
+    /// projected onto the new path.
+    float retarget(float p, float progressVelocity, VectorValue target) {
+        const int n = vectorProp(prop).components;
+        VectorValue current = at(p);
+        float dot = 0, length2 = 0;
+        for (int i = 0; i < n; i++) {
+            float rate = (to[i] - from[i]) * progressVelocity;
+            float d = target[i] - current[i];
+            dot += rate * d;
+            length2 += d * d;
         }
+        from = current;
+        to = target;
+        return length2 > 0 ? dot / length2 : 0.0f;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Composition — sequence / parallel / stagger / loop / delay graphs
+//
+// A whole graph is handed to the ticker at once and advanced natively: a
+// finished step starts its successor in the same tickAll(), at the exact
+// time the previous one ended, and only the graph's completion calls
+// back into JS. A delay is a timing leaf with no node; a stagger is a
+// parallel of sequences, each led by a growing delay.
+// ---------------------------------------------------------------------------
+
+// Re-tick passes per frame for steps that start mid-frame
+static constexpr int MAX_COMPOSITION_PASSES = 4;
 
-        node->markDirty();
+struct CompositionStep {
+    enum Kind : uint8_t { Leaf, Sequence, Parallel, Loop };
+
+    Kind kind = Leaf;
+    Animation leaf;       // Leaf
+    bool hasFrom = false; // Leaf: fromValue known (given, or read at first start)
+    int loopCount = -1;   // Loop: iterations, -1 = forever
+    int parent = -1;
+    std::vector<int> children;
+
+    // Runtime
+    int cursor = 0;       // Sequence: running child; Parallel: finished
+                          // children; Loop: completed iterations
+    float endTime = 0;    // Parallel: latest child end
+    int animId = 0;       // Leaf: running animation
+    bool hasLeaf = false; // subtree animates something
+};
+
+struct Composition {
+    int id = 0;
+    std::vector<CompositionStep> steps; // steps[0] is the root
+    std::shared_ptr<facebook::jsi::Function> onFinishCallback;
+
+    int addGroup(CompositionStep::Kind kind, int parent = -1) {
+        CompositionStep step;
+        step.kind = kind;
+        return add(std::move(step), parent);
+    }
+
+    int addAnimation(const Animation &anim, bool hasFrom, int parent = -1) {
+        CompositionStep step;
+        step.leaf = anim;
+        step.hasFrom = hasFrom;
+        return add(std::move(step), parent);
+    }
+
+    int addDelay(float ms, int parent = -1) {
+        Animation wait;
+        wait.duration = ms;
+        wait.easing = easeLinear;
+        return addAnimation(wait, true, parent);
+    }
+
+    int addLoop(int count, int parent = -1) {
+        CompositionStep step;
+        step.kind = CompositionStep::Loop;
+        step.loopCount = count;
+        return add(std::move(step), parent);
+    }
+
+private:
+    int add(CompositionStep step, int parent) {
+        int index = static_cast<int>(steps.size());
+        step.parent = parent;
+        steps.push_back(std::move(step));
+        if (parent >= 0) steps[parent].children.push_back(index);
+        return index;
     }
 };
 
+// ---------------------------------------------------------------------------
+// AnimationTickerObserver — every change to the running set, in order
+//
+// Slots are reported as they are stored (start, retarget, composition
+// steps), removals only when they are not completions (a replayed tick
+// completes on its own), and each tick pass before it runs. Replaying
+// the same calls into restoreSlot / cancel / tickAll rebuilds the exact
+// lane state.
+// ---------------------------------------------------------------------------
+
+class AnimationTickerObserver {
+public:
+    virtual ~AnimationTickerObserver() = default;
+    virtual void onSlotStored(const SlotState &slot) = 0;
+    virtual void onRemoved(int id) = 0;
+    virtual void onTickPass(float timestamp) = 0;
+};
+
 // ---------------------------------------------------------------------------
 // AnimationTicker — owns all animations, ticked per vsync
 // ---------------------------------------------------------------------------
@@ -231,61 +673,943 @@ public:
     /// Create and start a new animation. Returns animation ID.
     int start(Animation anim) {
         anim.id = nextId_++;
-        animations_[anim.id] = std::make_unique<Animation>(std::move(anim));
+        if (anim.vectorProp != VectorPropId::None) startVector(anim);
+        uint32_t slot = 0;
+        switch (anim.driverType) {
+            case DriverType::Timing: slot = timing_.size(); timing_.push(anim); break;
+            case DriverType::Spring: slot = spring_.size(); spring_.push(anim); break;
+            case DriverType::Decay:  slot = decay_.size();  decay_.push(anim);  break;
+        }
+        index_[anim.id] = {anim.driverType, slot};
+        if (anim.onFinishCallback) callbacks_[anim.id] = std::move(anim.onFinishCallback);
+        if (observer_) notifyStored(anim.id);
         return anim.id;
     }
 
-    /// Cancel an animation.
+    /// Start a composition graph. Returns its ID, which cancel() accepts.
+    int startComposition(Composition comp) {
+        int id = nextId_++;
+        comp.id = id;
+        auto owned = std::make_unique<Composition>(std::move(comp));
+        auto *c = owned.get();
+        compositions_[c->id] = std::move(owned);
+
+        // Children follow their parent, so one reverse pass fills hasLeaf
+        for (int i = static_cast<int>(c->steps.size()) - 1; i >= 0; i--) {
+            auto &step = c->steps[i];
+            if (step.kind == CompositionStep::Leaf) step.hasLeaf = true;
+            if (step.hasLeaf && step.parent >= 0) c->steps[step.parent].hasLeaf = true;
+        }
+
+        if (c->steps.empty()) finishComposition(*c, true);
+        else startStep(*c, 0, -1.0f);
+        // Nothing to animate: it ended here, and no tick may come to drop it
+        if (c->id == 0) {
+            releaseLeaves(*c);
+            compositions_.erase(id);
+        }
+        return id;
+    }
+
+    /// Cancel an animation or composition. Its completion callback fires
+    /// with `false` on the next tick.
     void cancel(int id) {
-        auto it = animations_.find(id);
-        if (it != animations_.end()) {
-            it->second->finished = true;
+        auto comp = compositions_.find(id);
+        if (comp != compositions_.end()) {
+            if (comp->second->id != 0) cancelComposition(*comp->second);
+            return;
+        }
+        auto owner = leafOwner_.find(id);
+        if (owner != leafOwner_.end()) {
+            // Cancelling one step cancels the graph it belongs to
+            cancel(owner->second.first);
+            return;
+        }
+        if (!removeAnimation(id)) return;
+        retire(id, false);
+    }
+
+    /// Parameters of a running animation: its driver and that driver's
+    /// settings, target and node. A decay reports as a default spring,
+    /// since a retargeted decay needs a driver that has a target.
+    bool describe(int id, Animation &anim) const {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        Slot slot = it->second;
+        anim = Animation();
+        anim.id = id;
+        anim.driverType = slot.driver == DriverType::Decay ? DriverType::Spring : slot.driver;
+        switch (slot.driver) {
+            case DriverType::Timing:
+                describeBase(timing_, slot.index, anim);
+                anim.duration = timing_.durationMs(slot.index);
+                anim.easing = timing_.easing[slot.index] ? timing_.easing[slot.index] : easeLinear;
+                anim.easingTable = timing_.table[slot.index];
+                break;
+            case DriverType::Spring:
+                describeBase(spring_, slot.index, anim);
+                anim.springTension = spring_.tension[slot.index];
+                anim.springFriction = spring_.friction[slot.index];
+                anim.springMass = spring_.mass[slot.index];
+                break;
+            case DriverType::Decay:
+                describeBase(decay_, slot.index, anim);
+                break;
+        }
+        auto vec = vectors_.find(id);
+        if (vec != vectors_.end()) {
+            anim.node = vec->second.node;
+            anim.vectorProp = vec->second.prop;
+            anim.fromVector = vec->second.from;
+            anim.toVector = vec->second.to;
         }
+        return true;
+    }
+
+    /// Send a running animation to `next.toValue` (`next.toVector` for a
+    /// vector prop) with `next`'s driver and settings, starting from its
+    /// current value and velocity. The id, completion callback and any
+    /// composition ownership carry over. A spring keeps the velocity
+    /// exactly, unless `explicitVelocity` keeps `next`'s own; a timing
+    /// curve restarts from the current value. Fill `next` with describe()
+    /// to keep the current driver.
+    bool retarget(int id, Animation next, bool explicitVelocity = false) {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        Slot slot = it->second;
+
+        float value = 0, velocity = 0, start = -1;
+        switch (slot.driver) {
+            case DriverType::Timing: currentState(timing_, slot.index, value, velocity, start); break;
+            case DriverType::Spring: currentState(spring_, slot.index, value, velocity, start); break;
+            case DriverType::Decay:  currentState(decay_, slot.index, value, velocity, start);  break;
+        }
+
+        next.id = id;
+        next.onFinishCallback = nullptr; // kept in callbacks_
+        next.startTime = start;          // continue from the last tick
+        auto vec = vectors_.find(id);
+        if (vec != vectors_.end()) {
+            float carried = vec->second.retarget(value, velocity, next.toVector);
+            // An explicit velocity is a fraction of the new distance per ms
+            next.springVelocity = explicitVelocity
+                ? next.springVelocity * VECTOR_PROGRESS_SCALE : carried;
+            next.node = nullptr;
+            next.prop = PropId::Unknown;
+            next.fromValue = 0;
+            next.toValue = VECTOR_PROGRESS_SCALE;
+        } else {
+            next.fromValue = value;
+            if (!explicitVelocity) next.springVelocity = velocity;
+        }
+        if (!explicitVelocity) next.decayVelocity = velocity;
+
+        if (next.driverType == slot.driver) {
+            // Same driver — overwrite the slot, no reallocation
+            switch (slot.driver) {
+                case DriverType::Timing: timing_.store(slot.index, next); break;
+                case DriverType::Spring: spring_.store(slot.index, next); break;
+                case DriverType::Decay:  decay_.store(slot.index, next);  break;
+            }
+            if (observer_) notifyStored(id);
+            return true;
+        }
+        switch (slot.driver) {
+            case DriverType::Timing: removeSlot(timing_, slot.index); break;
+            case DriverType::Spring: removeSlot(spring_, slot.index); break;
+            case DriverType::Decay:  removeSlot(decay_, slot.index);  break;
+        }
+        uint32_t index = 0;
+        switch (next.driverType) {
+            case DriverType::Timing: index = timing_.size(); timing_.push(next); break;
+            case DriverType::Spring: index = spring_.size(); spring_.push(next); break;
+            case DriverType::Decay:  index = decay_.size();  decay_.push(next);  break;
+        }
+        index_[id] = {next.driverType, index};
+        if (observer_) notifyStored(id);
+        return true;
     }
 
     /// Tick all active animations. Called from render loop.
     void tickAll(float timestamp, facebook::jsi::Runtime *rt) {
-        std::vector<int> finished;
+        lastTimestamp_ = timestamp;
+        // Every driver is a pure function of elapsed time, so re-ticking is
+        // idempotent; extra passes only run when a composition started a
+        // step that already has elapsed time this frame.
+        for (int pass = 0; pass < MAX_COMPOSITION_PASSES; pass++) {
+            if (observer_) observer_->onTickPass(timestamp);
+            size_t timingDone = timing_.tick(timestamp);
+            size_t springDone = spring_.tick(timestamp);
+            size_t decayDone = decay_.tick(timestamp);
+
+            applyVectors();
+            if (!sinks_.empty()) publishSinks();
+
+            if (timingDone) sweep(timing_);
+            if (springDone) sweep(spring_);
+            if (decayDone) sweep(decay_);
+
+            stepStarted_ = false;
+            advanceCompositions();
+            if (!stepStarted_) break;
+        }
+
+        // Deliver completions. Swap out first — a callback may start or
+        // cancel animations.
+        if (completed_.empty()) return;
+        firing_.swap(completed_);
+        if (rt) deliverCompletions(*rt);
+        firing_.clear();
+    }
+
+    /// Receive every completion of a frame in one call, ahead of the
+    /// per-animation onFinish callbacks. Pass nullptr to remove it.
+    void setBatchDispatcher(std::shared_ptr<facebook::jsi::Function> dispatcher) {
+        batchDispatcher_ = std::move(dispatcher);
+    }
+
+    bool hasActive() const {
+        return !index_.empty() || !completed_.empty();
+    }
+
+    /// Run the clock back by `ms` for every running animation, as if no
+    /// time had passed while the ticker was paused: the next tick resumes
+    /// from the values last shown instead of jumping ahead.
+    void shiftTime(float ms) {
+        timing_.shiftStart(ms);
+        spring_.shiftStart(ms);
+        decay_.shiftStart(ms);
+        if (lastTimestamp_ >= 0) lastTimestamp_ += ms;
+        if (observer_) {
+            for (auto &entry : index_) notifyStored(entry.first);
+        }
+    }
+
+    bool isRunning(int id) const { return index_.count(id) > 0; }
+
+    /// The ticker still holds composition `id`. False once it has
+    /// finished (at the end of that tick) or been cancelled.
+    bool isComposing(int id) const { return compositions_.count(id) > 0; }
+
+    /// Latest value of a running animation (a vector animation reports
+    /// its progress, 0..VECTOR_PROGRESS_SCALE). Leaves `value` untouched
+    /// and returns false if `id` is not running.
+    bool currentValue(int id, float &value) const {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        switch (it->second.driver) {
+            case DriverType::Timing: value = timing_.value[it->second.index]; break;
+            case DriverType::Spring: value = spring_.value[it->second.index]; break;
+            case DriverType::Decay:  value = decay_.value[it->second.index];  break;
+        }
+        return true;
+    }
+
+    /// Mirror a running animation's value (a vector animation's progress)
+    /// into `*sink` on every tick, through its last one. The sink is
+    /// dropped when the animation ends; nullptr unbinds. Returns false if
+    /// `id` is not running.
+    bool setValueSink(int id, float *sink) {
+        if (!index_.count(id)) return false;
+        if (sink) {
+            sinks_[id] = sink;
+            currentValue(id, *sink);
+        } else {
+            sinks_.erase(id);
+        }
+        return true;
+    }
+
+    /// Where `id` mirrors its value, or nullptr.
+    float *valueSink(int id) const {
+        auto it = sinks_.find(id);
+        return it != sinks_.end() ? it->second : nullptr;
+    }
+
+    /// Total run time (ms from the first tick) of a running animation, or
+    /// -1 if `id` is not running. Known up front for every driver.
+    float expectedDuration(int id) const {
+        auto it = index_.find(id);
+        if (it == index_.end()) return -1;
+        switch (it->second.driver) {
+            case DriverType::Timing: return timing_.durationMs(it->second.index);
+            case DriverType::Spring: return spring_.durationMs(it->second.index);
+            case DriverType::Decay:  return decay_.durationMs(it->second.index);
+        }
+        return -1;
+    }
+
+    // ── State capture (AnimationTimeline) ─────────────────────
+
+    /// Report slot changes, removals and tick passes to `observer`
+    /// (nullptr to stop).
+    void setObserver(AnimationTickerObserver *observer) { observer_ = observer; }
+
+    /// Driver state of a running animation.
+    bool slotState(int id, SlotState &state) const {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        state = SlotState();
+        state.driver = it->second.driver;
+        switch (it->second.driver) {
+            case DriverType::Timing: timing_.capture(it->second.index, state); break;
+            case DriverType::Spring: spring_.capture(it->second.index, state); break;
+            case DriverType::Decay:  decay_.capture(it->second.index, state);  break;
+        }
+        auto vec = vectors_.find(id);
+        if (vec != vectors_.end()) {
+            state.vectorProp = vec->second.prop;
+            state.vectorNode = vec->second.node;
+            state.vectorFrom = vec->second.from;
+            state.vectorTo = vec->second.to;
+        }
+        return true;
+    }
+
+    /// Every running animation, in lane order.
+    template <typename Fn>
+    void forEachSlot(Fn &&fn) const {
+        SlotState state;
+        for (auto *lane : {static_cast<const LaneBase *>(&timing_),
+                           static_cast<const LaneBase *>(&spring_),
+                           static_cast<const LaneBase *>(&decay_)}) {
+            for (size_t i = 0; i < lane->size(); i++) {
+                if (slotState(lane->ids[i], state)) fn(state);
+            }
+        }
+    }
+
+    /// Latest value of every running animation, in lane order.
+    template <typename Fn>
+    void forEachValue(Fn &&fn) const {
+        for (auto *lane : {static_cast<const LaneBase *>(&timing_),
+                           static_cast<const LaneBase *>(&spring_),
+                           static_cast<const LaneBase *>(&decay_)}) {
+            for (size_t i = 0; i < lane->size(); i++) fn(lane->ids[i], lane->value[i]);
+        }
+    }
 
-        for (auto &[id, anim] : animations_) {
-            if (anim->finished) {
-                finished.push_back(id);
-                continue;
+    /// Store `state` verbatim: over the animation with its id (moving it
+    /// if the driver differs), or as a new one. No callback is attached.
+    void restoreSlot(const SlotState &state) {
+        auto it = index_.find(state.id);
+        if (it != index_.end() && it->second.driver != state.driver) {
+            switch (it->second.driver) {
+                case DriverType::Timing: removeSlot(timing_, it->second.index); break;
+                case DriverType::Spring: removeSlot(spring_, it->second.index); break;
+                case DriverType::Decay:  removeSlot(decay_, it->second.index);  break;
+            }
+            index_.erase(it);
+            it = index_.end();
+        }
+        if (it != index_.end()) {
+            switch (state.driver) {
+                case DriverType::Timing: timing_.restore(it->second.index, state); break;
+                case DriverType::Spring: spring_.restore(it->second.index, state); break;
+                case DriverType::Decay:  decay_.restore(it->second.index, state);  break;
             }
-            anim->tick(timestamp);
-            if (anim->finished) {
-                finished.push_back(id);
+        } else {
+            uint32_t slot = 0;
+            switch (state.driver) {
+                case DriverType::Timing: slot = timing_.size(); timing_.push(state); break;
+                case DriverType::Spring: slot = spring_.size(); spring_.push(state); break;
+                case DriverType::Decay:  slot = decay_.size();  decay_.push(state);  break;
             }
+            index_[state.id] = {state.driver, slot};
         }
+        if (state.vectorProp != VectorPropId::None) {
+            vectors_[state.id] = {state.vectorNode, state.vectorProp,
+                                  state.vectorFrom, state.vectorTo};
+        } else {
+            vectors_.erase(state.id);
+        }
+        nextId_ = std::max(nextId_, state.id + 1);
+    }
+
+private:
+    struct Slot {
+        DriverType driver;
+        uint32_t index;
+    };
+
+    int nextId_ = 1;
+    float lastTimestamp_ = -1; // of the latest tickAll()
+    TimingLane timing_;
+    SpringLane spring_;
+    DecayLane decay_;
+    std::unordered_map<int, Slot> index_; // animId → lane slot
+    std::unordered_map<int, std::shared_ptr<facebook::jsi::Function>> callbacks_;
+    std::unordered_map<int, VectorTrack> vectors_;        // animId → track
+    std::unordered_map<int, float *> sinks_;              // animId → shared slot
+    struct Completion {
+        int id;
+        bool finished;
+        std::shared_ptr<facebook::jsi::Function> callback; // may be null
+    };
+    std::vector<Completion> completed_;
+    std::vector<Completion> firing_;
+    std::shared_ptr<facebook::jsi::Function> batchDispatcher_;
+
+    // Compositions
+    std::unordered_map<int, std::unique_ptr<Composition>> compositions_;
+    std::unordered_map<int, std::pair<int, int>> leafOwner_; // animId → (comp, step)
+    std::vector<std::pair<int, float>> leafDone_;            // animId, end time
+    bool stepStarted_ = false;
+
+    AnimationTickerObserver *observer_ = nullptr;
+
+    void notifyStored(int id) {
+        SlotState state;
+        if (slotState(id, state)) observer_->onSlotStored(state);
+    }
+
+    template <typename Lane>
+    static void describeBase(const Lane &lane, uint32_t i, Animation &anim) {
+        anim.node = lane.nodes[i];
+        anim.prop = lane.props[i];
+        anim.fromValue = lane.from[i];
+        anim.toValue = lane.to[i];
+    }
 
-        // Fire completion callbacks and remove finished animations
-        for (int id : finished) {
-            auto it = animations_.find(id);
-            if (it != animations_.end()) {
-                auto &anim = it->second;
-                if (anim->onFinishCallback && rt) {
-                    try {
-                        anim->onFinishCallback->call(*rt, facebook::jsi::Value(true));
-                    } catch (...) {}
+    /// Value and velocity (units/ms) as of the last tick, and the time a
+    /// successor should start from (< 0 if the slot has not ticked yet).
+    template <typename Lane>
+    void currentState(const Lane &lane, uint32_t i,
+                      float &value, float &velocity, float &start) const {
+        bool ticked = lane.startTime[i] >= 0 && lastTimestamp_ >= 0;
+        value = lane.value[i];
+        velocity = lane.velocityAt(i, ticked ? lastTimestamp_ : lane.startTime[i]);
+        start = ticked ? lastTimestamp_ : -1.0f;
+    }
+
+    /// Move a vector animation's endpoints into a track and leave the
+    /// driver animating bare progress.
+    void startVector(Animation &anim) {
+        VectorTrack track;
+        track.node = anim.node;
+        track.prop = anim.vectorProp;
+        track.from = anim.fromVector;
+        track.to = anim.toVector;
+        vectors_[anim.id] = track;
+
+        anim.node = nullptr;
+        anim.prop = PropId::Unknown;
+        anim.fromValue = 0;
+        anim.toValue = VECTOR_PROGRESS_SCALE;
+        anim.springVelocity *= VECTOR_PROGRESS_SCALE;
+    }
+
+    void applyVectors() {
+        for (auto &[id, track] : vectors_) {
+            Slot slot = index_.at(id);
+            switch (slot.driver) {
+                case DriverType::Timing: track.apply(timing_.value[slot.index]); break;
+                case DriverType::Spring: track.apply(spring_.value[slot.index]); break;
+                case DriverType::Decay:  track.apply(decay_.value[slot.index]);  break;
+            }
+        }
+    }
+
+    void publishSinks() {
+        for (auto &[id, sink] : sinks_) currentValue(id, *sink);
+    }
+
+    /// Remove finished slots, highest first so the slot moved into a hole
+    /// has already been visited.
+    template <typename Lane>
+    void sweep(Lane &lane) {
+        for (size_t i = lane.size(); i-- > 0;) {
+            if (!lane.finished[i]) continue;
+            int id = lane.ids[i];
+            if (leafOwner_.count(id)) {
+                leafDone_.push_back({id, lane.startTime[i] + lane.durationMs(i)});
+            }
+            index_.erase(id);
+            vectors_.erase(id);
+            sinks_.erase(id);
+            removeSlot(lane, static_cast<uint32_t>(i));
+            retire(id, true);
+        }
+    }
+
+    bool removeAnimation(int id) {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        Slot slot = it->second;
+        index_.erase(it);
+        vectors_.erase(id);
+        sinks_.erase(id);
+        if (observer_) observer_->onRemoved(id);
+        switch (slot.driver) {
+            case DriverType::Timing: removeSlot(timing_, slot.index); break;
+            case DriverType::Spring: removeSlot(spring_, slot.index); break;
+            case DriverType::Decay:  removeSlot(decay_, slot.index);  break;
+        }
+        return true;
+    }
+
+    template <typename Lane>
+    void removeSlot(Lane &lane, uint32_t slot) {
+        uint32_t last = static_cast<uint32_t>(lane.size() - 1);
+        if (slot != last) index_[lane.ids[last]].index = slot;
+        lane.forEachColumn([slot, last](auto &column) {
+            if (slot != last) column[slot] = std::move(column[last]);
+            column.pop_back();
+        });
+    }
+
+    /// Queue the animation's completion. With a batch dispatcher every
+    /// top-level animation is reported; composition steps never are.
+    void retire(int id, bool finished) {
+        auto it = callbacks_.find(id);
+        if (it != callbacks_.end()) {
+            completed_.push_back({id, finished, std::move(it->second)});
+            callbacks_.erase(it);
+        } else if (batchDispatcher_ && !leafOwner_.count(id)) {
+            completed_.push_back({id, finished, nullptr});
+        }
+    }
+
+    /// One dispatcher call for the whole frame, then the per-animation
+    /// onFinish callbacks. Exceptions thrown by JS are reported, and never
+    /// stop the rest.
+    void deliverCompletions(facebook::jsi::Runtime &rt) {
+        namespace jsi = facebook::jsi;
+        auto guarded = [](const char *what, auto &&call) {
+            try {
+                call();
+            } catch (const jsi::JSError &e) {
+                fprintf(stderr, "[AnimationTicker] %s JS ERROR: %s\n", what, e.what());
+            } catch (const std::exception &e) {
+                fprintf(stderr, "[AnimationTicker] %s ERROR: %s\n", what, e.what());
+            } catch (...) {
+                fprintf(stderr, "[AnimationTicker] %s ERROR: unknown exception\n", what);
+            }
+        };
+
+        if (batchDispatcher_) {
+            auto dispatcher = batchDispatcher_; // the call may replace it
+            guarded("batch onFinish", [&] {
+                jsi::Array events(rt, firing_.size() * 2);
+                size_t i = 0;
+                for (auto &c : firing_) {
+                    events.setValueAtIndex(rt, i++, c.id);
+                    events.setValueAtIndex(rt, i++, c.finished);
+                }
+                dispatcher->call(rt, std::move(events));
+            });
+        }
+        for (auto &c : firing_) {
+            if (!c.callback) continue;
+            guarded("onFinish", [&] { c.callback->call(rt, jsi::Value(c.finished)); });
+        }
+    }
+
+    // ── Composition stepping ──────────────────────────────────
+
+    /// Start step `index` at `time` (ms; < 0 = next tick).
+    void startStep(Composition &c, int index, float time) {
+        auto &step = c.steps[index];
+        switch (step.kind) {
+            case CompositionStep::Leaf: {
+                // No fromValue: start from the node's value the first time
+                // and keep it, so every loop iteration replays the same run
+                // (by the second pass the node already sits at the target)
+                if (!step.hasFrom && step.leaf.node) {
+                    if (step.leaf.vectorProp != VectorPropId::None) {
+                        step.leaf.fromVector = readVectorProp(step.leaf.node, step.leaf.vectorProp);
+                    } else {
+                        step.leaf.fromValue = readNodeProp(step.leaf.node, step.leaf.prop);
+                    }
+                    step.hasFrom = true;
                 }
-                animations_.erase(it);
+                Animation anim = step.leaf;
+                anim.startTime = time;
+                step.animId = start(std::move(anim));
+                leafOwner_[step.animId] = {c.id, index};
+                stepStarted_ = true;
+                return;
             }
+            case CompositionStep::Sequence:
+                step.cursor = 0;
+                if (step.children.empty()) stepFinished(c, index, time);
+                else startStep(c, step.children[0], time);
+                return;
+            case CompositionStep::Parallel:
+                step.cursor = 0;
+                step.endTime = time;
+                if (step.children.empty()) {
+                    stepFinished(c, index, time);
+                    return;
+                }
+                for (int child : step.children) startStep(c, child, time);
+                return;
+            case CompositionStep::Loop:
+                step.cursor = 0;
+                // A loop over nothing would spin without ever yielding
+                if (step.children.empty() || !step.hasLeaf || step.loopCount == 0) {
+                    stepFinished(c, index, time);
+                } else {
+                    startStep(c, step.children[0], time);
+                }
+                return;
         }
     }
 
-    bool hasActive() const {
-        return !animations_.empty();
+    /// Step `index` ended at `time`; advance its parent.
+    void stepFinished(Composition &c, int index, float time) {
+        int parentIndex = c.steps[index].parent;
+        if (parentIndex < 0) {
+            finishComposition(c, true);
+            return;
+        }
+        auto &parent = c.steps[parentIndex];
+        switch (parent.kind) {
+            case CompositionStep::Sequence:
+                if (++parent.cursor < static_cast<int>(parent.children.size())) {
+                    startStep(c, parent.children[parent.cursor], time);
+                } else {
+                    stepFinished(c, parentIndex, time);
+                }
+                return;
+            case CompositionStep::Parallel:
+                parent.endTime = std::max(parent.endTime, time);
+                if (++parent.cursor == static_cast<int>(parent.children.size())) {
+                    stepFinished(c, parentIndex, parent.endTime);
+                }
+                return;
+            case CompositionStep::Loop:
+                if (parent.loopCount < 0 || ++parent.cursor < parent.loopCount) {
+                    startStep(c, parent.children[0], time);
+                } else {
+                    stepFinished(c, parentIndex, time);
+                }
+                return;
+            case CompositionStep::Leaf:
+                return;
+        }
     }
 
-private:
-    int nextId_ = 1;
-    std::unordered_map<int, std::unique_ptr<Animation>> animations_;
+    void advanceCompositions() {
+        for (size_t i = 0; i < leafDone_.size(); i++) {
+            auto [animId, endTime] = leafDone_[i];
+            auto owner = leafOwner_.find(animId);
+            if (owner == leafOwner_.end()) continue;
+            auto [compId, stepIndex] = owner->second;
+            leafOwner_.erase(owner);
+            auto comp = compositions_.find(compId);
+            if (comp == compositions_.end()) continue;
+            comp->second->steps[stepIndex].animId = 0;
+            stepFinished(*comp->second, stepIndex, endTime);
+        }
+        leafDone_.clear();
+        for (auto it = compositions_.begin(); it != compositions_.end();) {
+            if (it->second->id == 0) {
+                releaseLeaves(*it->second);
+                it = compositions_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void cancelComposition(Composition &c) {
+        int id = c.id;
+        releaseLeaves(c);
+        finishComposition(c, false);
+        compositions_.erase(id);
+    }
+
+    /// Stop any leaf still running and drop its owner entry, so no
+    /// leafOwner_ entry outlives the graph it points into.
+    void releaseLeaves(Composition &c) {
+        for (auto &step : c.steps) {
+            if (step.animId == 0) continue;
+            leafOwner_.erase(step.animId);
+            callbacks_.erase(step.animId);
+            removeAnimation(step.animId);
+            step.animId = 0;
+        }
+    }
+
+    /// Queue the completion callback; the graph is dropped at the end of
+    /// the current advance.
+    void finishComposition(Composition &c, bool finished) {
+        if (c.onFinishCallback || batchDispatcher_) {
+            completed_.push_back({c.id, finished, std::move(c.onFinishCallback)});
+        }
+        c.id = 0;
+    }
 };
 
 // ---------------------------------------------------------------------------
 // JSI Registration
 // ---------------------------------------------------------------------------
 
+/// config.easing: a name, "cubic-bezier(x1, y1, x2, y2)", [x1, y1, x2, y2],
+/// or { keyframes: [[time, progress, easingName?], ...] }. Names stay
+/// direct polynomials; the rest compile to a shared table.
+inline void parseEasing(facebook::jsi::Runtime &rt,
+                        const facebook::jsi::Value &value,
+                        Animation &anim)
+{
+    auto &cache = EasingTableCache::shared();
+    if (value.isString()) {
+        auto name = value.asString(rt).utf8(rt);
+        if (name.find("cubic-bezier") != std::string::npos) {
+            anim.easingTable = cache.fromString(name);
+        } else {
+            anim.easing = easingFromString(name);
+        }
+        return;
+    }
+    if (!value.isObject()) return;
+
+    auto obj = value.asObject(rt);
+    if (obj.isArray(rt)) {
+        auto points = obj.asArray(rt);
+        if (points.size(rt) < 4) return;
+        auto at = [&](size_t i) {
+            return static_cast<float>(points.getValueAtIndex(rt, i).asNumber());
+        };
+        anim.easingTable = cache.cubicBezier(at(0), at(1), at(2), at(3));
+        return;
+    }
+    if (!obj.hasProperty(rt, "keyframes")) return;
+
+    auto list = obj.getProperty(rt, "keyframes").asObject(rt).asArray(rt);
+    std::vector<EasingKeyframe> stops;
+    size_t n = list.size(rt);
+    for (size_t i = 0; i < n; i++) {
+        auto stop = list.getValueAtIndex(rt, i).asObject(rt).asArray(rt);
+        if (stop.size(rt) < 2) continue;
+        EasingKeyframe kf;
+        kf.time = static_cast<float>(stop.getValueAtIndex(rt, 0).asNumber());
+        kf.progress = static_cast<float>(stop.getValueAtIndex(rt, 1).asNumber());
+        if (stop.size(rt) > 2) {
+            kf.easing = easingFromString(stop.getValueAtIndex(rt, 2).asString(rt).utf8(rt));
+        }
+        stops.push_back(kf);
+    }
+    anim.easingTable = cache.keyframes(std::move(stops));
+}
+
+/// A vector prop value from JS: a number for every component or an
+/// array [x, y, …]; for a color, a color string or 0xAARRGGBB number,
+/// parsed here once. Components not given keep their value in `base`.
+inline VectorValue parseVectorValue(facebook::jsi::Runtime &rt,
+                                    const facebook::jsi::Value &value,
+                                    VectorPropId prop,
+                                    const VectorValue &base)
+{
+    const auto &accessor = vectorProp(prop);
+    VectorValue result = base;
+    if (accessor.colorSpace != ColorSpace::None) {
+        if (value.isString()) {
+            colorToComponents(skia::parseColor(value.asString(rt).utf8(rt)),
+                              accessor.colorSpace, result.data());
+        } else if (value.isNumber()) {
+            colorToComponents(static_cast<uint32_t>(value.asNumber()),
+                              accessor.colorSpace, result.data());
+        }
+        return result;
+    }
+    if (value.isNumber()) {
+        float v = static_cast<float>(value.asNumber());
+        for (int i = 0; i < accessor.components; i++) result[i] = v;
+        return result;
+    }
+    if (!value.isObject()) return result;
+
+    auto obj = value.asObject(rt);
+    if (!obj.isArray(rt)) return result;
+    auto list = obj.asArray(rt);
+    size_t n = std::min(list.size(rt), static_cast<size_t>(accessor.components));
+    for (size_t i = 0; i < n; i++) {
+        result[i] = static_cast<float>(list.getValueAtIndex(rt, i).asNumber());
+    }
+    return result;
+}
+
+/// Set `anim`'s driver from `driverStr` ("timing" | "spring" | "decay")
+/// and override the settings present in `config`.
+inline void parseDriverConfig(facebook::jsi::Runtime &rt,
+                              const std::string &driverStr,
+                              const facebook::jsi::Object &config,
+                              Animation &anim)
+{
+    if (driverStr == "timing") {
+        anim.driverType = DriverType::Timing;
+        if (config.hasProperty(rt, "duration")) {
+            anim.duration = static_cast<float>(
+                config.getProperty(rt, "duration").asNumber());
+        }
+        if (config.hasProperty(rt, "easing")) {
+            parseEasing(rt, config.getProperty(rt, "easing"), anim);
+        }
+    } else if (driverStr == "spring") {
+        anim.driverType = DriverType::Spring;
+        if (config.hasProperty(rt, "tension")) {
+            anim.springTension = static_cast<float>(
+                config.getProperty(rt, "tension").asNumber());
+        }
+        if (config.hasProperty(rt, "friction")) {
+            anim.springFriction = static_cast<float>(
+                config.getProperty(rt, "friction").asNumber());
+        }
+        if (config.hasProperty(rt, "velocity")) {
+            anim.springVelocity = static_cast<float>(
+                config.getProperty(rt, "velocity").asNumber());
+        }
+        if (config.hasProperty(rt, "mass")) {
+            anim.springMass = static_cast<float>(
+                config.getProperty(rt, "mass").asNumber());
+        }
+    } else if (driverStr == "decay") {
+        anim.driverType = DriverType::Decay;
+        if (config.hasProperty(rt, "velocity")) {
+            anim.decayVelocity = static_cast<float>(
+                config.getProperty(rt, "velocity").asNumber());
+        }
+        if (config.hasProperty(rt, "rate")) {
+            anim.decayRate = static_cast<float>(
+                config.getProperty(rt, "rate").asNumber());
+        }
+    }
+}
+
+/// Fill `anim` from __animateNode-style arguments. `hasFrom` reports
+/// whether config carried fromValue; otherwise fromValue is the node's
+/// current value. Returns false if the node does not exist, or for a
+/// decay on a vector prop (decay has no target to interpolate toward).
+inline bool parseAnimation(facebook::jsi::Runtime &rt,
+                           skia::SkiaNodeTree *tree,
+                           int nodeId,
+                           const std::string &prop,
+                           const std::string &driverStr,
+                           const facebook::jsi::Object &config,
+                           Animation &anim,
+                           bool &hasFrom)
+{
+    using namespace facebook;
+
+    auto *node = tree->getNode(nodeId);
+    if (!node) return false;
+
+    anim.node = node;
+    anim.prop = propIdFromString(prop);
+    anim.vectorProp = vectorPropFromString(prop);
+    hasFrom = config.hasProperty(rt, "fromValue");
+    if (config.hasProperty(rt, "colorSpace") &&
+        config.getProperty(rt, "colorSpace").asString(rt).utf8(rt) == "linear") {
+        anim.vectorProp = withColorSpace(anim.vectorProp, ColorSpace::Linear);
+    }
+
+    if (anim.vectorProp != VectorPropId::None) {
+        if (driverStr == "decay") return false;
+        // Parsed once here; ticks only interpolate floats
+        VectorValue current = readVectorProp(node, anim.vectorProp);
+        anim.fromVector = hasFrom
+            ? parseVectorValue(rt, config.getProperty(rt, "fromValue"), anim.vectorProp, current)
+            : current;
+        anim.toVector = config.hasProperty(rt, "toValue")
+            ? parseVectorValue(rt, config.getProperty(rt, "toValue"), anim.vectorProp, anim.fromVector)
+            : anim.fromVector;
+    } else {
+        // fromValue — explicit, or the current value
+        anim.fromValue = hasFrom
+            ? static_cast<float>(config.getProperty(rt, "fromValue").asNumber())
+            : readNodeProp(node, anim.prop);
+
+        // toValue
+        if (config.hasProperty(rt, "toValue")) {
+            anim.toValue = static_cast<float>(
+                config.getProperty(rt, "toValue").asNumber());
+        }
+    }
+
+    parseDriverConfig(rt, driverStr, config, anim);
+
+    // onFinish callback
+    if (config.hasProperty(rt, "onFinish")) {
+        auto cbVal = config.getProperty(rt, "onFinish");
+        if (cbVal.isObject() && cbVal.asObject(rt).isFunction(rt)) {
+            anim.onFinishCallback = std::make_shared<jsi::Function>(
+                cbVal.asObject(rt).asFunction(rt));
+        }
+    }
+    return true;
+}
+
+/// Append the step described by `spec` (and its subtree) under `parent`.
+/// Returns false on an unknown type or a missing node.
+inline bool parseCompositionStep(facebook::jsi::Runtime &rt,
+                                 skia::SkiaNodeTree *tree,
+                                 const facebook::jsi::Object &spec,
+                                 Composition &comp,
+                                 int parent)
+{
+    using namespace facebook;
+
+    auto type = spec.getProperty(rt, "type").asString(rt).utf8(rt);
+    auto number = [&](const char *key, double fallback) {
+        return spec.hasProperty(rt, key) ? spec.getProperty(rt, key).asNumber() : fallback;
+    };
+    auto children = [&](int group, float staggerMs) {
+        if (!spec.hasProperty(rt, "children")) return true;
+        auto list = spec.getProperty(rt, "children").asObject(rt).asArray(rt);
+        size_t n = list.size(rt);
+        for (size_t i = 0; i < n; i++) {
+            auto child = list.getValueAtIndex(rt, i).asObject(rt);
+            int at = group;
+            if (staggerMs > 0 && i > 0) {
+                at = comp.addGroup(CompositionStep::Sequence, group);
+                comp.addDelay(staggerMs * i, at);
+            }
+            if (!parseCompositionStep(rt, tree, child, comp, at)) return false;
+        }
+        return true;
+    };
+
+    if (type == "animation") {
+        Animation anim;
+        bool hasFrom = false;
+        auto config = spec.hasProperty(rt, "config")
+            ? spec.getProperty(rt, "config").asObject(rt)
+            : jsi::Object(rt);
+        if (!parseAnimation(rt, tree,
+                            static_cast<int>(spec.getProperty(rt, "node").asNumber()),
+                            spec.getProperty(rt, "prop").asString(rt).utf8(rt),
+                            spec.getProperty(rt, "driver").asString(rt).utf8(rt),
+                            config, anim, hasFrom)) {
+            return false;
+        }
+        comp.addAnimation(anim, hasFrom, parent);
+        return true;
+    }
+    if (type == "delay") {
+        comp.addDelay(static_cast<float>(number("duration", 0)), parent);
+        return true;
+    }
+    if (type == "sequence") {
+        return children(comp.addGroup(CompositionStep::Sequence, parent), 0);
+    }
+    if (type == "parallel") {
+        return children(comp.addGroup(CompositionStep::Parallel, parent), 0);
+    }
+    if (type == "stagger") {
+        return children(comp.addGroup(CompositionStep::Parallel, parent),
+                        static_cast<float>(number("delay", 0)));
+    }
+    if (type == "loop") {
+        int loop = comp.addLoop(static_cast<int>(number("count", -1)), parent);
+        if (!spec.hasProperty(rt, "child")) return true;
+        return parseCompositionStep(
+            rt, tree, spec.getProperty(rt, "child").asObject(rt), comp, loop);
+    }
+    return false;
+}
+
 inline void registerAnimationHostFunctions(
     facebook::jsi::Runtime &rt,
     AnimationTicker *ticker,
@@ -295,7 +1619,13 @@ inline void registerAnimationHostFunctions(
 
     // __animateNode(nodeId, prop, driverType, config) → animId
     // driverType: "timing" | "spring" | "decay"
-    // config: { toValue, duration?, easing?, tension?, friction?, velocity?, rate? }
+    // config: { toValue, fromValue?, duration?, easing?, tension?, friction?,
+    //           velocity?, rate?, colorSpace?, onFinish? }
+    // easing: name | "cubic-bezier(…)" | [x1, y1, x2, y2] | { keyframes }
+    // prop may be a vector prop ("position", "translate", "scale",
+    // "transform", "backgroundColor", "borderColor", "color") with values
+    // as in parseVectorValue. Timing and spring only. Colors interpolate
+    // premultiplied, in linear light with colorSpace: "linear".
     rt.global().setProperty(rt, "__animateNode",
         jsi::Function::createFromHostFunction(rt,
             jsi::PropNameID::forAscii(rt, "__animateNode"), 4,
@@ -303,92 +1633,46 @@ inline void registerAnimationHostFunctions(
                            const jsi::Value *args, size_t count) -> jsi::Value {
                 if (count < 4) return jsi::Value(-1);
 
-                int nodeId = static_cast<int>(args[0].asNumber());
-                auto prop = args[1].asString(rt).utf8(rt);
-                auto driverStr = args[2].asString(rt).utf8(rt);
-                auto config = args[3].asObject(rt);
-
-                auto *node = tree->getNode(nodeId);
-                if (!node) return jsi::Value(-1);
-
                 Animation anim;
-                anim.node = node;
-                anim.prop = prop;
-
-                // Read current value as fromValue
-                if (prop == "opacity") anim.fromValue = node->opacity;
-                else if (prop == "scrollX") anim.fromValue = node->scrollX;
-                else if (prop == "scrollY") anim.fromValue = node->scrollY;
-                else if (prop == "borderRadius") anim.fromValue = node->borderRadii.topLeft;
-                else if (prop == "borderWidth") anim.fromValue = node->borderWidth;
-                else if (prop == "fontSize") anim.fromValue = node->fontSize;
-                else if (prop == "_rotationAngle") anim.fromValue = node->rotationAngle;
-                else if (prop == "x") anim.fromValue = node->layout.x;
-                else if (prop == "y") anim.fromValue = node->layout.y;
-
-                anim.currentValue = anim.fromValue;
-
-                // toValue
-                if (config.hasProperty(rt, "toValue")) {
-                    anim.toValue = static_cast<float>(
-                        config.getProperty(rt, "toValue").asNumber());
-                }
-
-                // Driver config
-                if (driverStr == "timing") {
-                    anim.driverType = DriverType::Timing;
-                    if (config.hasProperty(rt, "duration")) {
-                        anim.duration = static_cast<float>(
-                            config.getProperty(rt, "duration").asNumber());
-                    }
-                    if (config.hasProperty(rt, "easing")) {
-                        auto easingName = config.getProperty(rt, "easing")
-                                              .asString(rt).utf8(rt);
-                        anim.easing = easingFromString(easingName);
-                    }
-                } else if (driverStr == "spring") {
-                    anim.driverType = DriverType::Spring;
-                    if (config.hasProperty(rt, "tension")) {
-                        anim.springTension = static_cast<float>(
-                            config.getProperty(rt, "tension").asNumber());
-                    }
-                    if (config.hasProperty(rt, "friction")) {
-                        anim.springFriction = static_cast<float>(
-                            config.getProperty(rt, "friction").asNumber());
-                    }
-                    if (config.hasProperty(rt, "velocity")) {
-                        anim.springVelocity = static_cast<float>(
-                            config.getProperty(rt, "velocity").asNumber());
-                    }
-                    if (config.hasProperty(rt, "mass")) {
-                        anim.springMass = static_cast<float>(
-                            config.getProperty(rt, "mass").asNumber());
-                    }
-                } else if (driverStr == "decay") {
-                    anim.driverType = DriverType::Decay;
-                    if (config.hasProperty(rt, "velocity")) {
-                        anim.decayVelocity = static_cast<float>(
-                            config.getProperty(rt, "velocity").asNumber());
-                    }
-                    if (config.hasProperty(rt, "rate")) {
-                        anim.decayRate = static_cast<float>(
-                            config.getProperty(rt, "rate").asNumber());
-                    }
-                }
-
-                // onFinish callback
-                if (config.hasProperty(rt, "onFinish")) {
-                    auto cbVal = config.getProperty(rt, "onFinish");
-                    if (cbVal.isObject() && cbVal.asObject(rt).isFunction(rt)) {
-                        anim.onFinishCallback = std::make_shared<jsi::Function>(
-                            cbVal.asObject(rt).asFunction(rt));
-                    }
+                bool hasFrom = false;
+                if (!parseAnimation(rt, tree,
+                                    static_cast<int>(args[0].asNumber()),
+                                    args[1].asString(rt).utf8(rt),
+                                    args[2].asString(rt).utf8(rt),
+                                    args[3].asObject(rt), anim, hasFrom)) {
+                    return jsi::Value(-1);
                 }
 
                 int animId = ticker->start(std::move(anim));
                 return jsi::Value(animId);
             }));
 
+    // __animateComposite(spec, onFinish?) → id
+    // spec: { type: "animation", node, prop, driver, config }
+    //     | { type: "sequence" | "parallel", children: [spec] }
+    //     | { type: "stagger", delay, children: [spec] }
+    //     | { type: "loop", count?, child: spec }     count -1 = forever
+    //     | { type: "delay", duration }
+    // onFinish(finished) fires once, when the whole graph ends or is
+    // cancelled through __animateCancel(id).
+    rt.global().setProperty(rt, "__animateComposite",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animateComposite"), 2,
+            [ticker, tree](jsi::Runtime &rt, const jsi::Value &,
+                           const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isObject()) return jsi::Value(-1);
+
+                Composition comp;
+                if (!parseCompositionStep(rt, tree, args[0].asObject(rt), comp, -1)) {
+                    return jsi::Value(-1);
+                }
+                if (count >= 2 && args[1].isObject() && args[1].asObject(rt).isFunction(rt)) {
+                    comp.onFinishCallback = std::make_shared<jsi::Function>(
+                        args[1].asObject(rt).asFunction(rt));
+                }
+                return jsi::Value(ticker->startComposition(std::move(comp)));
+            }));
+
     // __animateCancel(animId)
     rt.global().setProperty(rt, "__animateCancel",
         jsi::Function::createFromHostFunction(rt,
@@ -400,6 +1684,67 @@ inline void registerAnimationHostFunctions(
                 ticker->cancel(id);
                 return jsi::Value::undefined();
             }));
+
+    // __animateRetarget(animId, toValue, config?) → bool
+    // Moves a running animation to a new target from its current value and
+    // velocity, keeping its id and onFinish. config may switch the driver
+    // (driver: "timing" | "spring") and override its settings; otherwise
+    // the current driver and settings continue. A decay becomes a spring.
+    // config.velocity replaces the carried velocity (for a vector prop, a
+    // fraction of the new distance per ms). Returns false if the animation
+    // is not running.
+    rt.global().setProperty(rt, "__animateRetarget",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animateRetarget"), 3,
+            [ticker](jsi::Runtime &rt, const jsi::Value &,
+                     const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value(false);
+                int id = static_cast<int>(args[0].asNumber());
+
+                Animation next;
+                if (!ticker->describe(id, next)) return jsi::Value(false);
+                bool isVector = next.vectorProp != VectorPropId::None;
+                bool explicitVelocity = false;
+                if (isVector) {
+                    // Components not given keep their current target
+                    next.toVector = parseVectorValue(rt, args[1], next.vectorProp, next.toVector);
+                } else {
+                    next.toValue = static_cast<float>(args[1].asNumber());
+                }
+
+                if (count >= 3 && args[2].isObject()) {
+                    auto config = args[2].asObject(rt);
+                    std::string driverStr =
+                        next.driverType == DriverType::Timing ? "timing" : "spring";
+                    if (config.hasProperty(rt, "driver")) {
+                        driverStr = config.getProperty(rt, "driver").asString(rt).utf8(rt);
+                    }
+                    if (isVector && driverStr == "decay") return jsi::Value(false);
+                    parseDriverConfig(rt, driverStr, config, next);
+                    explicitVelocity = config.hasProperty(rt, "velocity");
+                }
+                return jsi::Value(ticker->retarget(id, std::move(next), explicitVelocity));
+            }));
+
+    // __animateSetBatchDispatcher(fn)
+    // fn(events) where events is a flat array [id, finished, id, ...] of
+    // every animation and composition that ended this frame. Called once
+    // per frame after the tick, before the individual onFinish callbacks.
+    // Call without a function to remove it.
+    rt.global().setProperty(rt, "__animateSetBatchDispatcher",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animateSetBatchDispatcher"), 1,
+            [ticker](jsi::Runtime &rt, const jsi::Value &,
+                     const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isObject() ||
+                    !args[0].asObject(rt).isFunction(rt)) {
+                    ticker->setBatchDispatcher(nullptr);
+                    return jsi::Value::undefined();
+                }
+                ticker->setBatchDispatcher(std::make_shared<jsi::Function>(
+                    args[0].asObject(rt).asFunction(rt)));
+                return jsi::Value::undefined();
+            }));
 }
 
 } // namespace animation
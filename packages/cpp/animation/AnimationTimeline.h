@@ -0,0 +1,765 @@
+/**
+ * AnimationTimeline.h — record, export and scrub AnimationTicker motion.
+ *
+ * A recording is a compact binary log of what the ticker did: every
+ * driver slot as it was stored (start, retarget, composition steps, and
+ * a snapshot of what was already running), every removal that was not a
+ * completion, every tick pass, and after each vsync one frame of samples
+ * — the value of every running animation and the offset / velocity of
+ * every active ScrollEngine.
+ *
+ * Slots are logged verbatim (spring solutions, easing tables, vector
+ * tracks), and every driver is a pure function of elapsed time, so a
+ * player rebuilds the ticker's exact state at any time without the app:
+ * it seeks to arbitrary timestamps, or replays the whole log headlessly
+ * and emits the same frames as CSV for diffing in CI. Scroll samples are
+ * reported and shown as recorded; TouchTrace reproduces scroll physics.
+ *
+ * Binary format (host byte order), after the 4-byte magic "ZTL1":
+ *   'E' u32 index, f32[EASING_TABLE_SIZE + 1]    easing table, before first use
+ *   'S' slot                                     see writeSlot()
+ *   'X' i32 animId                               removed (cancelled)
+ *   'P' f32 timestamp                            tick pass
+ *   'F' f64 timestamp, u16 animations, u16 scrolls,
+ *       { i32 animId, f32 value } …,
+ *       { i32 engineId, i32 nodeId, f32 offsetX, f32 offsetY,
+ *         f32 velocityX, f32 velocityY, u8 phase } …
+ *
+ * JSI API:
+ *   __animationTimelineStart()               begin recording
+ *   __animationTimelineStop(path?) → bytes   stop; write the timeline to path
+ *   __animationTimelineLoad(path) → bool     scrub a saved timeline instead
+ *   __animationTimelineSeek(timeMs) → bool   pause live animations and show
+ *                                            the timeline at timeMs
+ *   __animationTimelineResume()              leave scrubbing; live animations
+ *                                            continue from where they paused
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+#include "animation/AnimationTicker.h"
+#include "animation/Easing.h"
+#include "gestures/ScrollEngine.h"
+
+#include <jsi/jsi.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace zilol {
+namespace animation {
+
+// ---------------------------------------------------------------------------
+// Binary encoding
+// ---------------------------------------------------------------------------
+
+static constexpr char TIMELINE_MAGIC[4] = {'Z', 'T', 'L', '1'};
+
+enum class TimelineRecord : uint8_t {
+    EasingTable = 'E',
+    Slot = 'S',
+    Removed = 'X',
+    TickPass = 'P',
+    Frame = 'F',
+};
+
+class TimelineWriter {
+public:
+    explicit TimelineWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD only");
+        const auto *p = reinterpret_cast<const uint8_t *>(&value);
+        out_.insert(out_.end(), p, p + sizeof(T));
+    }
+
+    void put(TimelineRecord record) { put(static_cast<uint8_t>(record)); }
+
+    void putString(const char *s) {
+        size_t n = std::min<size_t>(std::strlen(s), 255);
+        put(static_cast<uint8_t>(n));
+        out_.insert(out_.end(), s, s + n);
+    }
+
+private:
+    std::vector<uint8_t> &out_;
+};
+
+class TimelineReader {
+public:
+    TimelineReader(const uint8_t *data, size_t size) : p_(data), end_(data + size) {}
+
+    /// Reads past the end yield zeroes and clear ok().
+    template <typename T>
+    T get() {
+        T value{};
+        if (static_cast<size_t>(end_ - p_) < sizeof(T)) {
+            ok_ = false;
+            p_ = end_;
+            return value;
+        }
+        std::memcpy(&value, p_, sizeof(T));
+        p_ += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        size_t n = get<uint8_t>();
+        if (static_cast<size_t>(end_ - p_) < n) {
+            ok_ = false;
+            p_ = end_;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char *>(p_), n);
+        p_ += n;
+        return s;
+    }
+
+    bool done() const { return p_ == end_; }
+    bool ok() const { return ok_; }
+
+private:
+    const uint8_t *p_;
+    const uint8_t *end_;
+    bool ok_ = true;
+};
+
+// ---------------------------------------------------------------------------
+// Decoded timeline
+// ---------------------------------------------------------------------------
+
+struct TimelineScrollSample {
+    int engineId = 0;
+    int nodeId = 0;
+    float offsetX = 0, offsetY = 0;
+    float velocityX = 0, velocityY = 0;
+    gestures::ScrollPhase phase = gestures::ScrollPhase::Idle;
+};
+
+struct TimelineFrame {
+    double timestamp = 0;
+    std::vector<std::pair<int, float>> animations; // animId, value
+    std::vector<TimelineScrollSample> scrolls;
+};
+
+/// A logged slot; nodes are kept as ids until the player resolves them.
+struct TimelineSlot {
+    SlotState state;
+    int nodeId = 0;
+    int vectorNodeId = 0;
+};
+
+struct TimelineEvent {
+    enum Kind : uint8_t { Slot, Removed, TickPass, Frame };
+    Kind kind = Slot;
+    int id = 0;           // Removed
+    double timestamp = 0; // TickPass, Frame
+    size_t index = 0;     // Slot: into slots; Frame: into frames
+};
+
+// ---------------------------------------------------------------------------
+// Recorder — observes the live ticker, sampled from ZilolRuntime's onVsync
+// ---------------------------------------------------------------------------
+
+class AnimationTimelineRecorder : public AnimationTickerObserver {
+public:
+    AnimationTimelineRecorder(AnimationTicker *ticker, gestures::ScrollEngineManager *scroll)
+        : ticker_(ticker), scroll_(scroll) {}
+
+    ~AnimationTimelineRecorder() override { stop(); }
+
+    /// Recording stops by itself once the timeline reaches this size.
+    size_t maxBytes = 16u << 20;
+
+    bool recording() const { return recording_; }
+    const std::vector<uint8_t> &bytes() const { return bytes_; }
+
+    /// Clear the timeline and start with a snapshot of what is running.
+    void start() {
+        stop();
+        bytes_.clear();
+        tables_.clear();
+        bytes_.insert(bytes_.end(), TIMELINE_MAGIC, TIMELINE_MAGIC + 4);
+        recording_ = true;
+        ticker_->forEachSlot([this](const SlotState &slot) { writeSlot(slot); });
+        ticker_->setObserver(this);
+    }
+
+    void stop() {
+        if (!recording_) return;
+        recording_ = false;
+        ticker_->setObserver(nullptr);
+        tables_.clear();
+    }
+
+    /// Sample this frame's values. Call after the scroll and animation ticks.
+    void onFrame(double timestamp) {
+        if (!recording_) return;
+        size_t animations = 0, scrolls = 0;
+        ticker_->forEachValue([&](int, float) { animations++; });
+        if (scroll_) scroll_->forEachActive([&](gestures::ScrollEngine *) { scrolls++; });
+        if (animations == 0 && scrolls == 0) return;
+
+        TimelineWriter w(bytes_);
+        w.put(TimelineRecord::Frame);
+        w.put(timestamp);
+        w.put(static_cast<uint16_t>(std::min<size_t>(animations, UINT16_MAX)));
+        w.put(static_cast<uint16_t>(std::min<size_t>(scrolls, UINT16_MAX)));
+        size_t written = 0;
+        ticker_->forEachValue([&](int id, float value) {
+            if (written++ >= UINT16_MAX) return;
+            w.put(static_cast<int32_t>(id));
+            w.put(value);
+        });
+        written = 0;
+        if (scroll_) scroll_->forEachActive([&](gestures::ScrollEngine *engine) {
+            if (written++ >= UINT16_MAX) return;
+            w.put(static_cast<int32_t>(engine->id));
+            w.put(static_cast<int32_t>(engine->node ? engine->node->id : 0));
+            w.put(engine->offsetX);
+            w.put(engine->offsetY);
+            w.put(engine->reportedVelocityX());
+            w.put(engine->reportedVelocityY());
+            w.put(static_cast<uint8_t>(engine->phase));
+        });
+        checkSize();
+    }
+
+    bool save(const std::string &path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char *>(bytes_.data()),
+                  static_cast<std::streamsize>(bytes_.size()));
+        return static_cast<bool>(out);
+    }
+
+    // ── AnimationTickerObserver ───────────────────────────────
+
+    void onSlotStored(const SlotState &slot) override {
+        writeSlot(slot);
+        checkSize();
+    }
+
+    void onRemoved(int id) override {
+        TimelineWriter w(bytes_);
+        w.put(TimelineRecord::Removed);
+        w.put(static_cast<int32_t>(id));
+    }
+
+    void onTickPass(float timestamp) override {
+        TimelineWriter w(bytes_);
+        w.put(TimelineRecord::TickPass);
+        w.put(timestamp);
+    }
+
+private:
+    AnimationTicker *ticker_;
+    gestures::ScrollEngineManager *scroll_;
+    bool recording_ = false;
+    std::vector<uint8_t> bytes_;
+    // Tables already written; the refs keep the keys from being reused
+    std::unordered_map<const EasingTable *, std::pair<uint32_t, EasingTableRef>> tables_;
+
+    static int32_t nodeId(const skia::SkiaNode *node) { return node ? node->id : 0; }
+
+    uint32_t tableIndex(const EasingTableRef &table) {
+        auto it = tables_.find(table.get());
+        if (it != tables_.end()) return it->second.first;
+        auto index = static_cast<uint32_t>(tables_.size());
+        tables_[table.get()] = {index, table};
+        TimelineWriter w(bytes_);
+        w.put(TimelineRecord::EasingTable);
+        w.put(index);
+        for (float sample : table->samples) w.put(sample);
+        return index;
+    }
+
+    /// i32 id, u8 driver, i32 nodeId, u8 prop, f32 from, to, startTime, then
+    ///   Timing: f32 invDuration, u8 0 + name | u8 1 + u32 table
+    ///   Spring: f32 tension, friction, mass, u8 regime,
+    ///           f32 alpha, omega, a, b, settleMs, velocity
+    ///   Decay:  f32 velocity, logRate, distance
+    /// then u8 vectorProp; unless None: i32 nodeId,
+    ///   f32 from[MAX_VECTOR_COMPONENTS], f32 to[MAX_VECTOR_COMPONENTS]
+    void writeSlot(const SlotState &s) {
+        // A table record must precede the slot that uses it
+        uint32_t table = s.driver == DriverType::Timing && !s.easing && s.table
+            ? tableIndex(s.table) : 0;
+
+        TimelineWriter w(bytes_);
+        w.put(TimelineRecord::Slot);
+        w.put(static_cast<int32_t>(s.id));
+        w.put(static_cast<uint8_t>(s.driver));
+        w.put(nodeId(s.node));
+        w.put(static_cast<uint8_t>(s.prop));
+        w.put(s.from);
+        w.put(s.to);
+        w.put(s.startTime);
+        switch (s.driver) {
+            case DriverType::Timing:
+                w.put(s.invDuration);
+                if (s.easing) {
+                    w.put(static_cast<uint8_t>(0));
+                    const char *name = easingName(s.easing);
+                    w.putString(name ? name : "linear");
+                } else {
+                    w.put(static_cast<uint8_t>(1));
+                    w.put(table);
+                }
+                break;
+            case DriverType::Spring:
+                w.put(s.tension);
+                w.put(s.friction);
+                w.put(s.mass);
+                w.put(static_cast<uint8_t>(s.solution.regime));
+                w.put(s.solution.alpha);
+                w.put(s.solution.omega);
+                w.put(s.solution.a);
+                w.put(s.solution.b);
+                w.put(s.solution.settleMs);
+                w.put(s.velocity);
+                break;
+            case DriverType::Decay:
+                w.put(s.velocity);
+                w.put(s.logRate);
+                w.put(s.distance);
+                break;
+        }
+        w.put(static_cast<uint8_t>(s.vectorProp));
+        if (s.vectorProp == VectorPropId::None) return;
+        w.put(nodeId(s.vectorNode));
+        for (float v : s.vectorFrom) w.put(v);
+        for (float v : s.vectorTo) w.put(v);
+    }
+
+    void checkSize() {
+        if (bytes_.size() < maxBytes) return;
+        fprintf(stderr, "[AnimationTimeline] %zu bytes recorded, stopping\n", bytes_.size());
+        stop();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Player — rebuilds the recorded ticker state, live or headless
+// ---------------------------------------------------------------------------
+
+/**
+ * Replays a timeline into a private AnimationTicker. seek() puts that
+ * ticker in its state at any timestamp and writes the values to nodes —
+ * the live tree's when resolveNode looks them up there, otherwise
+ * detached stand-in nodes, so a CI job needs no app. replay() runs the
+ * whole log and samples the replayed ticker wherever a frame was
+ * recorded; writeCsv() of the recorded and replayed frames should match.
+ *
+ * Seeking backwards, or forwards from between two recorded passes,
+ * replays from the start.
+ */
+class AnimationTimelinePlayer {
+public:
+    explicit AnimationTimelinePlayer(const std::vector<uint8_t> &bytes) {
+        valid_ = decode(bytes);
+        reset();
+    }
+
+    /// Node for a recorded node id (0 = none). Default: stand-in nodes.
+    std::function<skia::SkiaNode *(int nodeId)> resolveNode;
+
+    bool valid() const { return valid_; }
+    const std::vector<TimelineFrame> &frames() const { return frames_; }
+    const AnimationTicker &ticker() const { return *ticker_; }
+
+    /// Recorded time span (ms): first to last tick pass or frame.
+    double startTime() const { return startTime_; }
+    double endTime() const { return endTime_; }
+
+    /// Show the timeline at `timestamp` (clamped to startTime()).
+    void seek(double timestamp) {
+        timestamp = std::max(timestamp, startTime_);
+        if (dirty_ || timestamp < position_) reset();
+        for (; cursor_ < events_.size(); cursor_++) {
+            auto &e = events_[cursor_];
+            if (e.kind == TimelineEvent::TickPass && e.timestamp > timestamp) break;
+            apply(e);
+        }
+        if (timestamp > position_) {
+            // Between recorded passes; latches slots that start here
+            ticker_->tickAll(static_cast<float>(timestamp), nullptr);
+            dirty_ = true;
+        }
+        showScrolls(timestamp);
+    }
+
+    /// Replay the whole log; one frame per recorded frame, with animation
+    /// values from the replayed ticker and scroll samples as recorded.
+    std::vector<TimelineFrame> replay() {
+        reset();
+        std::vector<TimelineFrame> out;
+        for (; cursor_ < events_.size(); cursor_++) {
+            auto &e = events_[cursor_];
+            if (e.kind != TimelineEvent::Frame) {
+                apply(e);
+                continue;
+            }
+            TimelineFrame frame;
+            frame.timestamp = e.timestamp;
+            ticker_->forEachValue([&](int id, float value) {
+                frame.animations.push_back({id, value});
+            });
+            frame.scrolls = frames_[e.index].scrolls;
+            out.push_back(std::move(frame));
+        }
+        return out;
+    }
+
+    /// One row per animation or scroll engine per frame.
+    static void writeCsv(const std::vector<TimelineFrame> &frames, std::ostream &out) {
+        out << "timestamp,kind,id,value,offsetX,offsetY,velocityX,velocityY,phase\n";
+        for (auto &f : frames) {
+            for (auto &[id, value] : f.animations) {
+                out << f.timestamp << ",animation," << id << "," << value << ",,,,,\n";
+            }
+            for (auto &s : f.scrolls) {
+                out << f.timestamp << ",scroll," << s.engineId << ",,"
+                    << s.offsetX << "," << s.offsetY << ","
+                    << s.velocityX << "," << s.velocityY << ","
+                    << static_cast<int>(s.phase) << "\n";
+            }
+        }
+    }
+
+    static bool readFile(const std::string &path, std::vector<uint8_t> &bytes) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+private:
+    bool valid_ = false;
+    std::vector<TimelineEvent> events_;
+    std::vector<TimelineSlot> slots_;
+    std::vector<TimelineFrame> frames_;
+    double startTime_ = 0, endTime_ = 0;
+
+    std::unique_ptr<AnimationTicker> ticker_;
+    size_t cursor_ = 0;       // next event to apply
+    double position_ = 0;     // timestamp of the last applied pass
+    bool dirty_ = false;      // ticked off the recorded passes
+    std::unordered_map<int, std::unique_ptr<skia::SkiaNode>> standIns_;
+
+    void reset() {
+        ticker_ = std::make_unique<AnimationTicker>();
+        cursor_ = 0;
+        position_ = -std::numeric_limits<double>::infinity();
+        dirty_ = false;
+    }
+
+    skia::SkiaNode *node(int id) {
+        if (id == 0) return nullptr;
+        if (resolveNode) return resolveNode(id);
+        auto &standIn = standIns_[id];
+        if (!standIn) {
+            standIn = std::make_unique<skia::SkiaNode>();
+            standIn->id = id;
+        }
+        return standIn.get();
+    }
+
+    void apply(const TimelineEvent &e) {
+        switch (e.kind) {
+            case TimelineEvent::Slot: {
+                const auto &logged = slots_[e.index];
+                SlotState state = logged.state;
+                state.node = node(logged.nodeId);
+                state.vectorNode = node(logged.vectorNodeId);
+                ticker_->restoreSlot(state);
+                break;
+            }
+            case TimelineEvent::Removed:
+                ticker_->cancel(e.id);
+                break;
+            case TimelineEvent::TickPass:
+                ticker_->tickAll(static_cast<float>(e.timestamp), nullptr);
+                position_ = e.timestamp;
+                break;
+            case TimelineEvent::Frame:
+                break;
+        }
+    }
+
+    /// Scroll offsets of the last recorded frame at or before `timestamp`.
+    void showScrolls(double timestamp) {
+        const TimelineFrame *shown = nullptr;
+        for (auto &f : frames_) {
+            if (f.timestamp > timestamp) break;
+            shown = &f;
+        }
+        if (!shown) return;
+        for (auto &s : shown->scrolls) {
+            auto *n = node(s.nodeId);
+            if (!n) continue;
+            n->scrollX = s.offsetX;
+            n->scrollY = s.offsetY;
+            n->markDirty();
+        }
+    }
+
+    bool decode(const std::vector<uint8_t> &bytes) {
+        if (bytes.size() < 4 || std::memcmp(bytes.data(), TIMELINE_MAGIC, 4) != 0) return false;
+        TimelineReader r(bytes.data() + 4, bytes.size() - 4);
+        std::vector<EasingTableRef> tables;
+        bool timed = false;
+        auto mark = [&](double t) {
+            if (!timed) startTime_ = t;
+            endTime_ = t;
+            timed = true;
+        };
+
+        while (!r.done() && r.ok()) {
+            auto record = static_cast<TimelineRecord>(r.get<uint8_t>());
+            TimelineEvent e;
+            switch (record) {
+                case TimelineRecord::EasingTable: {
+                    uint32_t index = r.get<uint32_t>();
+                    if (index != tables.size()) return false;
+                    EasingTable table;
+                    for (float &sample : table.samples) sample = r.get<float>();
+                    tables.push_back(std::make_shared<const EasingTable>(table));
+                    continue;
+                }
+                case TimelineRecord::Slot: {
+                    TimelineSlot slot;
+                    if (!readSlot(r, tables, slot)) return false;
+                    e.kind = TimelineEvent::Slot;
+                    e.index = slots_.size();
+                    slots_.push_back(std::move(slot));
+                    break;
+                }
+                case TimelineRecord::Removed:
+                    e.kind = TimelineEvent::Removed;
+                    e.id = r.get<int32_t>();
+                    break;
+                case TimelineRecord::TickPass:
+                    e.kind = TimelineEvent::TickPass;
+                    e.timestamp = r.get<float>();
+                    mark(e.timestamp);
+                    break;
+                case TimelineRecord::Frame: {
+                    TimelineFrame frame;
+                    frame.timestamp = r.get<double>();
+                    size_t animations = r.get<uint16_t>();
+                    size_t scrolls = r.get<uint16_t>();
+                    for (size_t i = 0; i < animations && r.ok(); i++) {
+                        int id = r.get<int32_t>();
+                        frame.animations.push_back({id, r.get<float>()});
+                    }
+                    for (size_t i = 0; i < scrolls && r.ok(); i++) {
+                        TimelineScrollSample s;
+                        s.engineId = r.get<int32_t>();
+                        s.nodeId = r.get<int32_t>();
+                        s.offsetX = r.get<float>();
+                        s.offsetY = r.get<float>();
+                        s.velocityX = r.get<float>();
+                        s.velocityY = r.get<float>();
+                        s.phase = static_cast<gestures::ScrollPhase>(r.get<uint8_t>());
+                        frame.scrolls.push_back(s);
+                    }
+                    e.kind = TimelineEvent::Frame;
+                    e.timestamp = frame.timestamp;
+                    e.index = frames_.size();
+                    mark(e.timestamp);
+                    frames_.push_back(std::move(frame));
+                    break;
+                }
+                default:
+                    return false;
+            }
+            if (r.ok()) events_.push_back(e);
+        }
+        return r.ok();
+    }
+
+    static bool readSlot(TimelineReader &r, const std::vector<EasingTableRef> &tables,
+                         TimelineSlot &slot) {
+        auto &s = slot.state;
+        s.id = r.get<int32_t>();
+        s.driver = static_cast<DriverType>(r.get<uint8_t>());
+        slot.nodeId = r.get<int32_t>();
+        s.prop = static_cast<PropId>(r.get<uint8_t>());
+        if (s.prop > PropId::Unknown) return false;
+        s.from = r.get<float>();
+        s.to = r.get<float>();
+        s.startTime = r.get<float>();
+        switch (s.driver) {
+            case DriverType::Timing:
+                s.invDuration = r.get<float>();
+                if (r.get<uint8_t>() == 0) {
+                    s.easing = easingFromString(r.getString());
+                } else {
+                    uint32_t index = r.get<uint32_t>();
+                    if (index >= tables.size()) return false;
+                    s.table = tables[index];
+                }
+                break;
+            case DriverType::Spring:
+                s.tension = r.get<float>();
+                s.friction = r.get<float>();
+                s.mass = r.get<float>();
+                s.solution.regime = static_cast<SpringRegime>(r.get<uint8_t>());
+                s.solution.alpha = r.get<float>();
+                s.solution.omega = r.get<float>();
+                s.solution.a = r.get<float>();
+                s.solution.b = r.get<float>();
+                s.solution.settleMs = r.get<float>();
+                s.velocity = r.get<float>();
+                break;
+            case DriverType::Decay:
+                s.velocity = r.get<float>();
+                s.logRate = r.get<float>();
+                s.distance = r.get<float>();
+                break;
+            default:
+                return false;
+        }
+        s.vectorProp = static_cast<VectorPropId>(r.get<uint8_t>());
+        if (s.vectorProp == VectorPropId::None) return r.ok();
+        if (s.vectorProp > VectorPropId::None) return false;
+        slot.vectorNodeId = r.get<int32_t>();
+        for (float &v : s.vectorFrom) v = r.get<float>();
+        for (float &v : s.vectorTo) v = r.get<float>();
+        return r.ok();
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Session — the recorder plus the timeline being scrubbed
+// ---------------------------------------------------------------------------
+
+struct AnimationTimelineSession {
+    AnimationTimelineRecorder recorder;
+    std::unique_ptr<AnimationTimelinePlayer> player; // last stopped or loaded
+    bool scrubbing = false; // live ticker paused while set
+
+    AnimationTimelineSession(AnimationTicker *ticker, gestures::ScrollEngineManager *scroll)
+        : recorder(ticker, scroll), ticker_(ticker) {}
+
+    /// Call every vsync before the animation tick; returns whether the
+    /// live ticker may tick. The frames skipped while scrubbing are cut
+    /// out of the live animations' clock once scrubbing ends.
+    bool beginFrame(double timestamp) {
+        if (scrubbing) {
+            if (pausedAt_ < 0) pausedAt_ = lastFrame_ >= 0 ? lastFrame_ : timestamp;
+        } else if (pausedAt_ >= 0) {
+            if (ticker_) ticker_->shiftTime(static_cast<float>(lastFrame_ - pausedAt_));
+            pausedAt_ = -1;
+        }
+        lastFrame_ = timestamp;
+        return !scrubbing;
+    }
+
+private:
+    AnimationTicker *ticker_;
+    double lastFrame_ = -1; // latest beginFrame()
+    double pausedAt_ = -1;  // last live frame before scrubbing, or -1
+};
+
+// ---------------------------------------------------------------------------
+// JSI Registration
+// ---------------------------------------------------------------------------
+
+inline void registerAnimationTimelineHostFunctions(
+    facebook::jsi::Runtime &rt,
+    AnimationTimelineSession *session,
+    skia::SkiaNodeTree *tree)
+{
+    namespace jsi = facebook::jsi;
+
+    auto usePlayer = [session, tree](std::unique_ptr<AnimationTimelinePlayer> player) {
+        if (!player->valid()) return false;
+        player->resolveNode = [tree](int id) { return tree->getNode(id); };
+        session->player = std::move(player);
+        return true;
+    };
+
+    // __animationTimelineStart()
+    rt.global().setProperty(rt, "__animationTimelineStart",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animationTimelineStart"), 0,
+            [session](jsi::Runtime &, const jsi::Value &,
+                      const jsi::Value *, size_t) -> jsi::Value {
+                session->scrubbing = false;
+                session->recorder.start();
+                return jsi::Value::undefined();
+            }));
+
+    // __animationTimelineStop(path?) → byte length
+    rt.global().setProperty(rt, "__animationTimelineStop",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animationTimelineStop"), 1,
+            [session, usePlayer](jsi::Runtime &rt, const jsi::Value &,
+                                 const jsi::Value *args, size_t count) -> jsi::Value {
+                auto &recorder = session->recorder;
+                recorder.stop();
+                if (count >= 1 && args[0].isString()) {
+                    auto path = args[0].asString(rt).utf8(rt);
+                    if (!recorder.save(path)) {
+                        fprintf(stderr, "[AnimationTimeline] cannot write %s\n", path.c_str());
+                    }
+                }
+                usePlayer(std::make_unique<AnimationTimelinePlayer>(recorder.bytes()));
+                return jsi::Value(static_cast<double>(recorder.bytes().size()));
+            }));
+
+    // __animationTimelineLoad(path) → bool
+    rt.global().setProperty(rt, "__animationTimelineLoad",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animationTimelineLoad"), 1,
+            [usePlayer](jsi::Runtime &rt, const jsi::Value &,
+                        const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isString()) return jsi::Value(false);
+                std::vector<uint8_t> bytes;
+                if (!AnimationTimelinePlayer::readFile(args[0].asString(rt).utf8(rt), bytes)) {
+                    return jsi::Value(false);
+                }
+                return jsi::Value(usePlayer(std::make_unique<AnimationTimelinePlayer>(bytes)));
+            }));
+
+    // __animationTimelineSeek(timeMs) → bool
+    rt.global().setProperty(rt, "__animationTimelineSeek",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animationTimelineSeek"), 1,
+            [session](jsi::Runtime &, const jsi::Value &,
+                      const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isNumber()) return jsi::Value(false);
+                if (!session->player || session->recorder.recording()) return jsi::Value(false);
+                session->scrubbing = true;
+                session->player->seek(args[0].asNumber());
+                return jsi::Value(true);
+            }));
+
+    // __animationTimelineResume()
+    rt.global().setProperty(rt, "__animationTimelineResume",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__animationTimelineResume"), 0,
+            [session](jsi::Runtime &, const jsi::Value &,
+                      const jsi::Value *, size_t) -> jsi::Value {
+                session->scrubbing = false;
+                return jsi::Value::undefined();
+            }));
+}
+
+} // namespace animation
+} // namespace zilol
@@ -0,0 +1,260 @@
+/**
+ * Easing.h — easing curves and their precomputed lookup tables.
+ *
+ * The built-in polynomials are evaluated directly, in batches. Every
+ * other curve is compiled into an EasingTable: sampled once at
+ * EASING_TABLE_SIZE + 1 evenly spaced points, then read per tick with
+ * one linear interpolation. Per-tick cost is then the same for a
+ * cubic-bezier solved by Newton iteration, a many-stop keyframe track,
+ * or an arbitrary EasingFn. Tables are immutable and shared by every
+ * animation using an identical curve.
+ *
+ * Curve sources:
+ *   - built-in names ("linear", "easeOut", …) and any EasingFn
+ *   - cubic-bezier(x1, y1, x2, y2), CSS semantics
+ *   - keyframe tracks: (time, progress) stops with an optional easing
+ *     per segment; progress may leave [0, 1] for overshoot
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zilol {
+namespace animation {
+
+// ---------------------------------------------------------------------------
+// Easing functions
+// ---------------------------------------------------------------------------
+
+using EasingFn = float (*)(float);
+
+inline float easeLinear(float t) { return t; }
+
+inline float easeInQuad(float t) { return t * t; }
+inline float easeOutQuad(float t) { return t * (2 - t); }
+inline float easeInOutQuad(float t) {
+    return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
+}
+
+inline float easeInCubic(float t) { return t * t * t; }
+inline float easeOutCubic(float t) { float u = t - 1; return u * u * u + 1; }
+inline float easeInOutCubic(float t) {
+    return t < 0.5f ? 4 * t * t * t : (t - 1) * (2 * t - 2) * (2 * t - 2) + 1;
+}
+
+inline float easeInOut(float t) { return easeInOutCubic(t); }
+
+inline EasingFn easingFromString(const std::string &name) {
+    if (name == "linear") return easeLinear;
+    if (name == "easeIn") return easeInQuad;
+    if (name == "easeOut") return easeOutQuad;
+    if (name == "easeInOut" || name == "default") return easeInOut;
+    if (name == "easeInOutQuad") return easeInOutQuad;
+    if (name == "easeInCubic") return easeInCubic;
+    if (name == "easeOutCubic") return easeOutCubic;
+    if (name == "easeInOutCubic") return easeInOutCubic;
+    return easeInOut; // default
+}
+
+/// Name of a built-in curve (easingFromString maps it back), or nullptr
+/// for any other function.
+inline const char *easingName(EasingFn fn) {
+    if (fn == easeLinear) return "linear";
+    if (fn == easeInQuad) return "easeIn";
+    if (fn == easeOutQuad) return "easeOut";
+    if (fn == easeInOut) return "easeInOut";
+    if (fn == easeInOutQuad) return "easeInOutQuad";
+    if (fn == easeInCubic) return "easeInCubic";
+    if (fn == easeOutCubic) return "easeOutCubic";
+    if (fn == easeInOutCubic) return "easeInOutCubic";
+    return nullptr;
+}
+
+/// Apply one easing curve to a run of progress values. Instantiated per
+/// built-in curve so the call inlines and the loop vectorizes.
+using EasingBatchFn = void (*)(float *, size_t);
+
+template <EasingFn Fn>
+inline void easeBatch(float *t, size_t n) {
+    for (size_t i = 0; i < n; i++) t[i] = Fn(t[i]);
+}
+
+/// Batch form of a built-in curve, or nullptr for any other function.
+inline EasingBatchFn easingBatchFor(EasingFn fn) {
+    if (fn == easeLinear) return [](float *, size_t) {};
+    if (fn == easeInQuad) return easeBatch<easeInQuad>;
+    if (fn == easeOutQuad) return easeBatch<easeOutQuad>;
+    if (fn == easeInOutQuad) return easeBatch<easeInOutQuad>;
+    if (fn == easeInCubic) return easeBatch<easeInCubic>;
+    if (fn == easeOutCubic) return easeBatch<easeOutCubic>;
+    if (fn == easeInOutCubic || fn == easeInOut) return easeBatch<easeInOutCubic>;
+    return nullptr;
+}
+
+/// CSS cubic-bezier: solve x(s) = t for s (Newton, bisection fallback),
+/// return y(s). Control x values are clamped to [0, 1].
+inline float cubicBezierAt(float t, float x1, float y1, float x2, float y2) {
+    if (t <= 0) return 0;
+    if (t >= 1) return 1;
+    x1 = std::clamp(x1, 0.0f, 1.0f);
+    x2 = std::clamp(x2, 0.0f, 1.0f);
+    auto curve = [](float s, float p1, float p2) {
+        float u = 1 - s;
+        return 3 * u * u * s * p1 + 3 * u * s * s * p2 + s * s * s;
+    };
+    auto slope = [](float s, float p1, float p2) {
+        float u = 1 - s;
+        return 3 * u * u * p1 + 6 * u * s * (p2 - p1) + 3 * s * s * (1 - p2);
+    };
+
+    float lo = 0, hi = 1, s = t;
+    for (int i = 0; i < 20; i++) {
+        float diff = curve(s, x1, x2) - t;
+        if (std::abs(diff) < 1e-6f) break;
+        if (diff > 0) hi = s;
+        else lo = s;
+        float dx = slope(s, x1, x2);
+        s = std::abs(dx) > 1e-6f ? std::clamp(s - diff / dx, lo, hi) : 0.5f * (lo + hi);
+    }
+    return curve(s, y1, y2);
+}
+
+// ---------------------------------------------------------------------------
+// EasingTable
+// ---------------------------------------------------------------------------
+
+static constexpr int EASING_TABLE_SIZE = 256; // segments
+
+struct EasingTable {
+    std::array<float, EASING_TABLE_SIZE + 1> samples{};
+
+    /// Eased progress at linear progress `t` (clamped to [0, 1]).
+    float sample(float t) const {
+        float x = std::clamp(t, 0.0f, 1.0f) * EASING_TABLE_SIZE;
+        int i = std::min(static_cast<int>(x), EASING_TABLE_SIZE - 1);
+        float f = x - static_cast<float>(i);
+        return samples[i] + (samples[i + 1] - samples[i]) * f;
+    }
+
+    template <typename Curve>
+    static EasingTable build(Curve &&curve) {
+        EasingTable table;
+        for (int i = 0; i <= EASING_TABLE_SIZE; i++) {
+            table.samples[i] = curve(static_cast<float>(i) / EASING_TABLE_SIZE);
+        }
+        return table;
+    }
+};
+
+using EasingTableRef = std::shared_ptr<const EasingTable>;
+
+/// One keyframe stop. `easing` shapes the segment that starts here.
+struct EasingKeyframe {
+    float time;     // 0..1
+    float progress; // fraction of from → to; may overshoot
+    EasingFn easing = easeLinear;
+};
+
+// ---------------------------------------------------------------------------
+// EasingTableCache — one table per distinct curve
+// ---------------------------------------------------------------------------
+
+class EasingTableCache {
+public:
+    static EasingTableCache &shared() {
+        static EasingTableCache cache;
+        return cache;
+    }
+
+    EasingTableRef forFunction(EasingFn fn) {
+        char key[32];
+        std::snprintf(key, sizeof(key), "f:%p", reinterpret_cast<void *>(fn));
+        return lookup(key, [fn] { return EasingTable::build(fn); });
+    }
+
+    EasingTableRef cubicBezier(float x1, float y1, float x2, float y2) {
+        char key[96];
+        std::snprintf(key, sizeof(key), "b:%a,%a,%a,%a", x1, y1, x2, y2);
+        return lookup(key, [=] {
+            return EasingTable::build([=](float t) {
+                return cubicBezierAt(t, x1, y1, x2, y2);
+            });
+        });
+    }
+
+    /// Stops are sorted by time (stable, so equal times keep their order).
+    /// Progress holds before the first stop and after the last.
+    EasingTableRef keyframes(std::vector<EasingKeyframe> stops) {
+        if (stops.empty()) return forFunction(easeLinear);
+        std::stable_sort(stops.begin(), stops.end(),
+                         [](const EasingKeyframe &a, const EasingKeyframe &b) {
+                             return a.time < b.time;
+                         });
+        std::string key = "k:";
+        char part[80];
+        for (auto &stop : stops) {
+            std::snprintf(part, sizeof(part), "%a,%a,%p;", stop.time, stop.progress,
+                          reinterpret_cast<void *>(stop.easing));
+            key += part;
+        }
+        return lookup(key, [&stops] {
+            return EasingTable::build([&stops](float t) {
+                if (t <= stops.front().time) return stops.front().progress;
+                if (t >= stops.back().time) return stops.back().progress;
+                size_t i = 1;
+                while (stops[i].time < t) i++;
+                const auto &a = stops[i - 1];
+                const auto &b = stops[i];
+                float span = b.time - a.time;
+                float u = span > 0 ? (t - a.time) / span : 1.0f;
+                return a.progress + (b.progress - a.progress) * a.easing(u);
+            });
+        });
+    }
+
+    /// Resolve a JS easing string: a built-in name or
+    /// "cubic-bezier(x1, y1, x2, y2)".
+    EasingTableRef fromString(const std::string &name) {
+        float x1, y1, x2, y2;
+        if (std::sscanf(name.c_str(), " cubic-bezier ( %f , %f , %f , %f )",
+                        &x1, &y1, &x2, &y2) == 4) {
+            return cubicBezier(x1, y1, x2, y2);
+        }
+        return forFunction(easingFromString(name));
+    }
+
+    size_t size() const { return tables_.size(); }
+
+private:
+    // Weak so a curve's table is freed with its last animation
+    std::unordered_map<std::string, std::weak_ptr<const EasingTable>> tables_;
+
+    template <typename Build>
+    EasingTableRef lookup(const std::string &key, Build &&build) {
+        auto &slot = tables_[key];
+        if (auto table = slot.lock()) return table;
+        auto table = std::make_shared<const EasingTable>(build());
+        slot = table;
+        if (tables_.size() > 64) prune();
+        return table;
+    }
+
+    void prune() {
+        for (auto it = tables_.begin(); it != tables_.end();) {
+            if (it->second.expired()) it = tables_.erase(it);
+            else ++it;
+        }
+    }
+};
+
+} // namespace animation
+} // namespace zilol
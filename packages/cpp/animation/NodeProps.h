@@ -0,0 +1,373 @@
+/**
+ * NodeProps.h — animatable SkiaNode prop access.
+ *
+ * The single prop path shared by every native driver that writes node
+ * fields without going through JS: AnimationTicker animations and
+ * ScrollEngine scroll-linked bindings. Props are resolved from their JS
+ * name to a PropId once; reads and writes go through an accessor table.
+ *
+ * Vector props (position, translate, scale, transform and the colors)
+ * have their own table and are read and written as whole component
+ * arrays.
+ *
+ * Also provides range interpolation (inputRange → outputRange with
+ * extrapolation), as used by scroll bindings.
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace zilol {
+namespace animation {
+
+// ---------------------------------------------------------------------------
+// Prop IDs
+// ---------------------------------------------------------------------------
+
+/// Animatable props, resolved once from their JS name when an animation
+/// or binding starts — the per-frame path never compares strings.
+enum class PropId : uint8_t {
+    Opacity,
+    ScrollX,
+    ScrollY,
+    BorderRadius,
+    BorderWidth,
+    FontSize,
+    RotationAngle,
+    X,
+    Y,
+    Unknown
+};
+
+// ---------------------------------------------------------------------------
+// Accessor table — one indirect call per read / write
+// ---------------------------------------------------------------------------
+
+struct PropAccessor {
+    const char *name;
+    float (*read)(const skia::SkiaNode *);
+    void (*write)(skia::SkiaNode *, float);
+};
+
+// Indexed by PropId. Layout props write layout.x/y directly.
+inline constexpr PropAccessor kPropAccessors[] = {
+    {"opacity",
+     [](const skia::SkiaNode *n) { return n->opacity; },
+     [](skia::SkiaNode *n, float v) { n->opacity = v; }},
+    {"scrollX",
+     [](const skia::SkiaNode *n) { return n->scrollX; },
+     [](skia::SkiaNode *n, float v) { n->scrollX = v; }},
+    {"scrollY",
+     [](const skia::SkiaNode *n) { return n->scrollY; },
+     [](skia::SkiaNode *n, float v) { n->scrollY = v; }},
+    {"borderRadius",
+     [](const skia::SkiaNode *n) { return n->borderRadii.topLeft; },
+     [](skia::SkiaNode *n, float v) { n->borderRadii = {v, v, v, v}; }},
+    {"borderWidth",
+     [](const skia::SkiaNode *n) { return n->borderWidth; },
+     [](skia::SkiaNode *n, float v) { n->borderWidth = v; }},
+    {"fontSize",
+     [](const skia::SkiaNode *n) { return n->fontSize; },
+     [](skia::SkiaNode *n, float v) { n->fontSize = v; }},
+    {"_rotationAngle",
+     [](const skia::SkiaNode *n) { return n->rotationAngle; },
+     [](skia::SkiaNode *n, float v) { n->rotationAngle = v; }},
+    {"x",
+     [](const skia::SkiaNode *n) { return n->layout.x; },
+     [](skia::SkiaNode *n, float v) { n->layout.x = v; }},
+    {"y",
+     [](const skia::SkiaNode *n) { return n->layout.y; },
+     [](skia::SkiaNode *n, float v) { n->layout.y = v; }},
+    // Unknown props read as 0 and ignore writes
+    {"",
+     [](const skia::SkiaNode *) { return 0.0f; },
+     [](skia::SkiaNode *, float) {}},
+};
+
+static_assert(sizeof(kPropAccessors) / sizeof(kPropAccessors[0]) ==
+              static_cast<size_t>(PropId::Unknown) + 1,
+              "kPropAccessors must cover every PropId");
+
+/// Resolve a JS prop name. Called once per animation / binding.
+inline PropId propIdFromString(const std::string &name) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(PropId::Unknown); i++) {
+        if (name == kPropAccessors[i].name) return static_cast<PropId>(i);
+    }
+    return PropId::Unknown;
+}
+
+inline const char *propName(PropId prop) {
+    return kPropAccessors[static_cast<uint8_t>(prop)].name;
+}
+
+// ---------------------------------------------------------------------------
+// Prop read / write
+// ---------------------------------------------------------------------------
+
+/// Read the current value of an animatable prop. Unknown props read as 0.
+inline float readNodeProp(const skia::SkiaNode *node, PropId prop) {
+    return kPropAccessors[static_cast<uint8_t>(prop)].read(node);
+}
+
+/// Write an animatable prop and mark the node dirty.
+inline void writeNodeProp(skia::SkiaNode *node, PropId prop, float value) {
+    if (!node) return;
+    kPropAccessors[static_cast<uint8_t>(prop)].write(node, value);
+    node->markDirty();
+}
+
+/// Write one value per node for a run of slots sharing a prop.
+/// Instantiated per PropId, so the accessor inlines into the loop.
+template <size_t P>
+inline void writeNodePropRun(skia::SkiaNode *const *nodes, const float *values,
+                             size_t count)
+{
+    constexpr auto write = kPropAccessors[P].write;
+    for (size_t i = 0; i < count; i++) {
+        if (!nodes[i]) continue;
+        write(nodes[i], values[i]);
+        nodes[i]->markDirty();
+    }
+}
+
+using PropRunWriter = void (*)(skia::SkiaNode *const *, const float *, size_t);
+
+template <size_t... P>
+constexpr std::array<PropRunWriter, sizeof...(P)>
+makePropRunWriters(std::index_sequence<P...>) {
+    return {{writeNodePropRun<P>...}};
+}
+
+// Indexed by PropId
+inline constexpr auto kPropRunWriters = makePropRunWriters(
+    std::make_index_sequence<static_cast<size_t>(PropId::Unknown) + 1>{});
+
+// ---------------------------------------------------------------------------
+// Vector props — multi-component, written as one unit
+// ---------------------------------------------------------------------------
+
+static constexpr int MAX_VECTOR_COMPONENTS = 5;
+
+using VectorValue = std::array<float, MAX_VECTOR_COMPONENTS>;
+
+/// How a color prop's components are interpolated. Both premultiply
+/// alpha, so a fade to transparent never passes through a dark fringe.
+enum class ColorSpace : uint8_t {
+    None,          // not a color prop
+    Premultiplied, // sRGB-encoded channels × alpha (CSS default)
+    Linear         // linear-light channels × alpha
+};
+
+inline float srgbToLinear(float c) {
+    return c <= 0.04045f ? c * (1.0f / 12.92f) : std::pow((c + 0.055f) * (1.0f / 1.055f), 2.4f);
+}
+
+inline float linearToSrgb(float c) {
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+/// 0xAARRGGBB (as skia::parseColor returns) → premultiplied [r, g, b, a]
+/// in `space`, each 0..1.
+inline void colorToComponents(uint32_t argb, ColorSpace space, float *c) {
+    float a = static_cast<float>((argb >> 24) & 0xFF) * (1.0f / 255);
+    for (int i = 0; i < 3; i++) {
+        float channel = static_cast<float>((argb >> (16 - 8 * i)) & 0xFF) * (1.0f / 255);
+        if (space == ColorSpace::Linear) channel = srgbToLinear(channel);
+        c[i] = channel * a;
+    }
+    c[3] = a;
+}
+
+/// Premultiplied [r, g, b, a] in `space` → 0xAARRGGBB, clamped and
+/// rounded to 8 bits per channel.
+inline uint32_t componentsToColor(const float *c, ColorSpace space) {
+    float a = std::clamp(c[3], 0.0f, 1.0f);
+    if (a <= 0) return 0;
+    auto byte = [](float v) {
+        return static_cast<uint32_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255));
+    };
+    uint32_t argb = byte(a) << 24;
+    for (int i = 0; i < 3; i++) {
+        float channel = std::clamp(c[i] / a, 0.0f, 1.0f);
+        if (space == ColorSpace::Linear) channel = linearToSrgb(channel);
+        argb |= byte(channel) << (16 - 8 * i);
+    }
+    return argb;
+}
+
+/// Multi-component props. Every component is written in the same call,
+/// so a frame never shows half of the update. Colors are stored on the
+/// node as 0xAARRGGBB and animated as four premultiplied components;
+/// each has a linear-light variant, picked with colorSpace: "linear".
+enum class VectorPropId : uint8_t {
+    Position,              // layout.x, layout.y
+    Translate,             // translateX, translateY
+    Scale,                 // scaleX, scaleY
+    Transform,             // translateX, translateY, scaleX, scaleY, rotationAngle
+    BackgroundColor,       // r, g, b, a (premultiplied)
+    BackgroundColorLinear,
+    BorderColor,
+    BorderColorLinear,
+    Color,                 // text color
+    ColorLinear,
+    None
+};
+
+struct VectorPropAccessor {
+    const char *name;
+    uint8_t components;
+    void (*read)(const skia::SkiaNode *, float *);
+    void (*write)(skia::SkiaNode *, const float *);
+    ColorSpace colorSpace = ColorSpace::None;
+};
+
+template <uint32_t skia::SkiaNode::*Field, ColorSpace Space>
+inline void readColorProp(const skia::SkiaNode *n, float *c) {
+    colorToComponents(n->*Field, Space, c);
+}
+
+template <uint32_t skia::SkiaNode::*Field, ColorSpace Space>
+inline void writeColorProp(skia::SkiaNode *n, const float *c) {
+    n->*Field = componentsToColor(c, Space);
+}
+
+template <uint32_t skia::SkiaNode::*Field, ColorSpace Space>
+constexpr VectorPropAccessor colorProp(const char *name) {
+    return {name, 4, readColorProp<Field, Space>, writeColorProp<Field, Space>, Space};
+}
+
+// Indexed by VectorPropId. A linear color follows its premultiplied one.
+inline constexpr VectorPropAccessor kVectorPropAccessors[] = {
+    {"position", 2,
+     [](const skia::SkiaNode *n, float *c) { c[0] = n->layout.x; c[1] = n->layout.y; },
+     [](skia::SkiaNode *n, const float *c) { n->layout.x = c[0]; n->layout.y = c[1]; }},
+    {"translate", 2,
+     [](const skia::SkiaNode *n, float *c) { c[0] = n->translateX; c[1] = n->translateY; },
+     [](skia::SkiaNode *n, const float *c) { n->translateX = c[0]; n->translateY = c[1]; }},
+    {"scale", 2,
+     [](const skia::SkiaNode *n, float *c) { c[0] = n->scaleX; c[1] = n->scaleY; },
+     [](skia::SkiaNode *n, const float *c) { n->scaleX = c[0]; n->scaleY = c[1]; }},
+    {"transform", 5,
+     [](const skia::SkiaNode *n, float *c) {
+         c[0] = n->translateX;
+         c[1] = n->translateY;
+         c[2] = n->scaleX;
+         c[3] = n->scaleY;
+         c[4] = n->rotationAngle;
+     },
+     [](skia::SkiaNode *n, const float *c) {
+         n->translateX = c[0];
+         n->translateY = c[1];
+         n->scaleX = c[2];
+         n->scaleY = c[3];
+         n->rotationAngle = c[4];
+     }},
+    colorProp<&skia::SkiaNode::backgroundColor, ColorSpace::Premultiplied>("backgroundColor"),
+    colorProp<&skia::SkiaNode::backgroundColor, ColorSpace::Linear>("backgroundColor:linear"),
+    colorProp<&skia::SkiaNode::borderColor, ColorSpace::Premultiplied>("borderColor"),
+    colorProp<&skia::SkiaNode::borderColor, ColorSpace::Linear>("borderColor:linear"),
+    colorProp<&skia::SkiaNode::color, ColorSpace::Premultiplied>("color"),
+    colorProp<&skia::SkiaNode::color, ColorSpace::Linear>("color:linear"),
+    {"", 0,
+     [](const skia::SkiaNode *, float *) {},
+     [](skia::SkiaNode *, const float *) {}},
+};
+
+static_assert(sizeof(kVectorPropAccessors) / sizeof(kVectorPropAccessors[0]) ==
+              static_cast<size_t>(VectorPropId::None) + 1,
+              "kVectorPropAccessors must cover every VectorPropId");
+
+/// Resolve a JS prop name; None for scalar or unknown props.
+inline VectorPropId vectorPropFromString(const std::string &name) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(VectorPropId::None); i++) {
+        if (name == kVectorPropAccessors[i].name) return static_cast<VectorPropId>(i);
+    }
+    return VectorPropId::None;
+}
+
+inline const VectorPropAccessor &vectorProp(VectorPropId prop) {
+    return kVectorPropAccessors[static_cast<uint8_t>(prop)];
+}
+
+/// The variant of color prop `prop` interpolated in `space`; any other
+/// prop is returned unchanged.
+inline VectorPropId withColorSpace(VectorPropId prop, ColorSpace space) {
+    ColorSpace current = vectorProp(prop).colorSpace;
+    if (current == ColorSpace::None || space == ColorSpace::None || current == space) {
+        return prop;
+    }
+    uint8_t id = static_cast<uint8_t>(prop);
+    return static_cast<VectorPropId>(current == ColorSpace::Premultiplied ? id + 1 : id - 1);
+}
+
+inline VectorValue readVectorProp(const skia::SkiaNode *node, VectorPropId prop) {
+    VectorValue value{};
+    if (node) vectorProp(prop).read(node, value.data());
+    return value;
+}
+
+/// Write every component of a vector prop and mark the node dirty once.
+inline void writeVectorProp(skia::SkiaNode *node, VectorPropId prop, const VectorValue &value) {
+    if (!node) return;
+    vectorProp(prop).write(node, value.data());
+    node->markDirty();
+}
+
+// ---------------------------------------------------------------------------
+// Range interpolation
+// ---------------------------------------------------------------------------
+
+enum class Extrapolate : uint8_t {
+    Extend,   // continue the edge segment's slope
+    Clamp,    // hold the edge output value
+    Identity  // return the input unchanged
+};
+
+inline Extrapolate extrapolateFromString(const std::string &name) {
+    if (name == "clamp") return Extrapolate::Clamp;
+    if (name == "identity") return Extrapolate::Identity;
+    return Extrapolate::Extend;
+}
+
+/// Piecewise-linear map of `x` through (input[i] → output[i]).
+/// `input` must be non-decreasing and the same length as `output`.
+inline float interpolateRange(float x,
+                              const std::vector<float> &input,
+                              const std::vector<float> &output,
+                              Extrapolate left = Extrapolate::Extend,
+                              Extrapolate right = Extrapolate::Extend)
+{
+    size_t n = std::min(input.size(), output.size());
+    if (n == 0) return x;
+    if (n == 1) return output[0];
+
+    if (x < input[0]) {
+        if (left == Extrapolate::Clamp) return output[0];
+        if (left == Extrapolate::Identity) return x;
+    } else if (x > input[n - 1]) {
+        if (right == Extrapolate::Clamp) return output[n - 1];
+        if (right == Extrapolate::Identity) return x;
+    }
+
+    // Find segment [i, i+1] containing x (edge segments extend outward)
+    size_t i = 0;
+    while (i + 2 < n && x > input[i + 1]) i++;
+
+    float in0 = input[i], in1 = input[i + 1];
+    float out0 = output[i], out1 = output[i + 1];
+    if (in1 == in0) return x < in0 ? out0 : out1;
+    return out0 + (x - in0) * (out1 - out0) / (in1 - in0);
+}
+
+} // namespace animation
+} // namespace zilol
@@ -0,0 +1,289 @@
+/**
+ * SharedValues.h — native float slots shared with JS synchronously.
+ *
+ * One fixed block of SHARED_VALUE_CAPACITY floats. JS allocates runs of
+ * slots and binds native writers to them; the writers store straight
+ * into the block as they run, so reading an animation's value, a scroll
+ * offset or a pan translation from JS is one property read — no copy
+ * kept in JS, no callback, no allocation per frame. JS writes land in
+ * the same memory and are read by native code on its next tick (e.g. a
+ * value graph's { op: "shared", slot }).
+ *
+ * JS sees the block as a Float32Array over an ArrayBuffer backed by the
+ * block itself: a read or write is a typed-array element access, with no
+ * host call. The block never moves, so writers — native and the view —
+ * hold plain pointers into it.
+ *
+ * Writers:
+ *   animation  1 slot   value after every tick, through its last one
+ *                       (a vector animation: progress 0..1000)
+ *   scroll     5 slots  offsetX, offsetY, velocityX, velocityY, phase
+ *   gesture    9 slots  state, x, y, translationX, translationY,
+ *                       velocityX, velocityY, scale, rotation
+ *
+ * The scroll phase slot replaces per-engine drag callbacks: it changes
+ * on every phase change, including drag begin and end.
+ *
+ * JSI API:
+ *   __sharedValues                             Float32Array over the block
+ *   __sharedValueAllocate(count, initial?) → slot   first of `count`, -1 if full
+ *   __sharedValueRelease(slot)                 free a run, unbinding its writers
+ *   __sharedValueBindAnimation(animId, slot) → bool
+ *   __sharedValueBindScroll(engineId, slot) → bool
+ *   __sharedValueBindGesture(gestureId, slot) → bool
+ */
+
+#pragma once
+
+#include "animation/AnimationTicker.h"
+#include "gestures/ScrollEngine.h"
+#include "gestures/GestureRecognizer.h"
+#include "gestures/TouchDispatcher.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace zilol {
+namespace animation {
+
+static constexpr int SHARED_VALUE_CAPACITY = 4096;
+
+// ---------------------------------------------------------------------------
+// SharedValueStore
+// ---------------------------------------------------------------------------
+
+class SharedValueStore {
+public:
+    SharedValueStore(AnimationTicker *ticker,
+                     gestures::ScrollEngineManager *scroll,
+                     gestures::TouchDispatcher *touch)
+        : ticker_(ticker), scroll_(scroll), touch_(touch) {}
+
+    /// Reserve `count` contiguous slots set to `initial`. Returns the
+    /// first slot, or -1 if no gap is large enough.
+    int allocate(int count, float initial = 0) {
+        if (count <= 0 || count > SHARED_VALUE_CAPACITY) return -1;
+        int base = 0;
+        for (auto &[start, length] : runs_) {
+            if (start - base >= count) break;
+            base = start + length;
+        }
+        if (base + count > SHARED_VALUE_CAPACITY) return -1;
+        runs_[base] = count;
+        std::fill_n(values_.begin() + base, count, initial);
+        return base;
+    }
+
+    /// Free the run starting at `base`; its writers stop writing.
+    bool release(int base) {
+        auto run = runs_.find(base);
+        if (run == runs_.end()) return false;
+        int end = base + run->second;
+        runs_.erase(run);
+        bindings_.erase(std::remove_if(bindings_.begin(), bindings_.end(),
+            [&](const Binding &b) {
+                if (b.slot < base || b.slot >= end) return false;
+                unbind(b);
+                return true;
+            }), bindings_.end());
+        std::fill(values_.begin() + base, values_.begin() + end, 0.0f);
+        return true;
+    }
+
+    /// `count` slots from `slot` lie inside one allocated run.
+    bool contains(int slot, int count = 1) const {
+        if (slot < 0) return false;
+        auto run = runs_.upper_bound(slot);
+        if (run == runs_.begin()) return false;
+        --run;
+        return slot + count <= run->first + run->second;
+    }
+
+    float read(int slot) const {
+        return slot >= 0 && slot < SHARED_VALUE_CAPACITY ? values_[slot] : 0.0f;
+    }
+
+    /// The whole block, SHARED_VALUE_CAPACITY floats (the JS view's memory).
+    float *data() { return values_.data(); }
+
+    /// Native-side write; ignored outside allocated runs.
+    bool write(int slot, float value) {
+        if (!contains(slot)) return false;
+        values_[slot] = value;
+        return true;
+    }
+
+    // ── Writers ───────────────────────────────────────────────
+
+    bool bindAnimation(int animId, int slot) {
+        if (!contains(slot) || !ticker_->setValueSink(animId, &values_[slot])) return false;
+        rebind({Binding::Animation, animId, slot, &values_[slot]});
+        return true;
+    }
+
+    bool bindScroll(int engineId, int slot) {
+        auto *engine = scroll_ ? scroll_->get(engineId) : nullptr;
+        if (!engine || !contains(slot, gestures::SCROLL_SHARED_SLOTS)) return false;
+        engine->sharedSlots = &values_[slot];
+        engine->publishShared();
+        rebind({Binding::Scroll, engineId, slot, &values_[slot]});
+        return true;
+    }
+
+    bool bindGesture(int gestureId, int slot) {
+        if (!touch_ || !contains(slot, gestures::GESTURE_SHARED_SLOTS)) return false;
+        if (!touch_->setGestureSharedSlots(gestureId, &values_[slot])) return false;
+        rebind({Binding::Gesture, gestureId, slot, &values_[slot]});
+        return true;
+    }
+
+    /// Scroll engine `engineId` is being destroyed
+    /// (ScrollEngineManager::onEngineRemoved).
+    void onScrollRemoved(int engineId) {
+        dropBinding(Binding::Scroll, engineId);
+    }
+
+private:
+    struct Binding {
+        enum Kind : uint8_t { Animation, Scroll, Gesture };
+        Kind kind;
+        int source;    // animId, engineId or gestureId
+        int slot;
+        float *writer; // where the source was pointed; only that is undone
+    };
+
+    AnimationTicker *ticker_;
+    gestures::ScrollEngineManager *scroll_;
+    gestures::TouchDispatcher *touch_;
+    // Fixed storage: writers keep pointers into it
+    std::array<float, SHARED_VALUE_CAPACITY> values_{};
+    std::map<int, int> runs_; // first slot → count, by position
+    // Kept until their run is released; a source that is gone is skipped
+    std::vector<Binding> bindings_;
+
+    /// A source writes to one place; a new binding replaces its last.
+    void rebind(Binding binding) {
+        for (auto &b : bindings_) {
+            if (b.kind == binding.kind && b.source == binding.source) {
+                b = binding;
+                return;
+            }
+        }
+        bindings_.push_back(binding);
+    }
+
+    /// The source is gone; forget its binding without touching a writer
+    /// that may since have taken its id.
+    void dropBinding(Binding::Kind kind, int source) {
+        bindings_.erase(std::remove_if(bindings_.begin(), bindings_.end(),
+            [&](const Binding &b) { return b.kind == kind && b.source == source; }),
+            bindings_.end());
+    }
+
+    /// Stop the writer, unless it now writes somewhere else (its id was
+    /// reused, or it was bound again through another path).
+    void unbind(const Binding &b) {
+        switch (b.kind) {
+            case Binding::Animation:
+                if (ticker_->valueSink(b.source) == b.writer) {
+                    ticker_->setValueSink(b.source, nullptr);
+                }
+                break;
+            case Binding::Scroll:
+                if (auto *engine = scroll_ ? scroll_->get(b.source) : nullptr) {
+                    if (engine->sharedSlots == b.writer) engine->sharedSlots = nullptr;
+                }
+                break;
+            case Binding::Gesture:
+                if (touch_ && touch_->gestureSharedSlots(b.source) == b.writer) {
+                    touch_->setGestureSharedSlots(b.source, nullptr);
+                }
+                break;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// SharedValueBuffer — the block as ArrayBuffer memory
+// ---------------------------------------------------------------------------
+
+class SharedValueBuffer : public facebook::jsi::MutableBuffer {
+public:
+    explicit SharedValueBuffer(SharedValueStore *store) : store_(store) {}
+
+    size_t size() const override { return SHARED_VALUE_CAPACITY * sizeof(float); }
+    uint8_t *data() override { return reinterpret_cast<uint8_t *>(store_->data()); }
+
+private:
+    SharedValueStore *store_;
+};
+
+// ---------------------------------------------------------------------------
+// JSI Registration
+// ---------------------------------------------------------------------------
+
+inline void registerSharedValueHostFunctions(
+    facebook::jsi::Runtime &rt,
+    SharedValueStore *store)
+{
+    namespace jsi = facebook::jsi;
+
+    // __sharedValues — Float32Array over the block; [slot] reads and writes
+    jsi::ArrayBuffer buffer(rt, std::make_shared<SharedValueBuffer>(store));
+    rt.global().setProperty(rt, "__sharedValues",
+        rt.global().getPropertyAsFunction(rt, "Float32Array")
+            .callAsConstructor(rt, std::move(buffer)));
+
+    // __sharedValueAllocate(count, initial?) → first slot, -1 if full
+    rt.global().setProperty(rt, "__sharedValueAllocate",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__sharedValueAllocate"), 2,
+            [store](jsi::Runtime &, const jsi::Value &,
+                    const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isNumber()) return jsi::Value(-1);
+                float initial = count >= 2 && args[1].isNumber()
+                    ? static_cast<float>(args[1].asNumber()) : 0.0f;
+                return jsi::Value(store->allocate(static_cast<int>(args[0].asNumber()), initial));
+            }));
+
+    // __sharedValueRelease(slot)
+    rt.global().setProperty(rt, "__sharedValueRelease",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__sharedValueRelease"), 1,
+            [store](jsi::Runtime &, const jsi::Value &,
+                    const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isNumber()) return jsi::Value::undefined();
+                store->release(static_cast<int>(args[0].asNumber()));
+                return jsi::Value::undefined();
+            }));
+
+    // __sharedValueBindAnimation(animId, slot) → bool
+    // __sharedValueBindScroll(engineId, slot) → bool
+    // __sharedValueBindGesture(gestureId, slot) → bool
+    using Bind = bool (SharedValueStore::*)(int, int);
+    auto registerBind = [&](const char *name, Bind bind) {
+        rt.global().setProperty(rt, name,
+            jsi::Function::createFromHostFunction(rt,
+                jsi::PropNameID::forAscii(rt, name), 2,
+                [store, bind](jsi::Runtime &, const jsi::Value &,
+                              const jsi::Value *args, size_t count) -> jsi::Value {
+                    if (count < 2 || !args[0].isNumber() || !args[1].isNumber()) {
+                        return jsi::Value(false);
+                    }
+                    return jsi::Value((store->*bind)(static_cast<int>(args[0].asNumber()),
+                                                     static_cast<int>(args[1].asNumber())));
+                }));
+    };
+    registerBind("__sharedValueBindAnimation", &SharedValueStore::bindAnimation);
+    registerBind("__sharedValueBindScroll", &SharedValueStore::bindScroll);
+    registerBind("__sharedValueBindGesture", &SharedValueStore::bindGesture);
+}
+
+} // namespace animation
+} // namespace zilol
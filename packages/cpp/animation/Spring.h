@@ -0,0 +1,202 @@
+/**
+ * Spring.h — closed-form damped spring.
+ *
+ * Solves m·x'' + c·x' + k·x = 0 analytically for every damping ratio
+ * (under-, critically and over-damped), so a spring is evaluated at its
+ * elapsed time rather than integrated frame by frame: exact at any frame
+ * rate, O(1) per tick, seekable, and its settle time is known when it
+ * starts.
+ *
+ * x is the displacement from the target; units are px and seconds.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace zilol {
+namespace animation {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+static constexpr float SPRING_REST_DISPLACEMENT = 0.5f; // px
+static constexpr float SPRING_REST_VELOCITY = 10.0f;    // px/s (0.01 px/ms)
+static constexpr float SPRING_MAX_SETTLE_MS = 10000.0f; // safety cap
+
+// ---------------------------------------------------------------------------
+// SpringSolution
+// ---------------------------------------------------------------------------
+
+enum class SpringRegime : uint8_t {
+    Under,    // x = e^(-αt)·(a·cos ωt + b·sin ωt)
+    Critical, // x = e^(-αt)·(a + b·t)
+    Over      // x = a·e^(r1·t) + b·e^(r2·t), r1 = -α, r2 = -ω
+};
+
+struct SpringSolution {
+    SpringRegime regime = SpringRegime::Critical;
+    float alpha = 0; // decay rate (1/s); Over: slow root magnitude
+    float omega = 0; // Under: damped frequency; Over: fast root magnitude
+    float a = 0;
+    float b = 0;
+    float settleMs = 0;
+
+    /// Solve for initial displacement `x0` (px) and velocity `v0` (px/s).
+    static SpringSolution solve(float x0, float v0,
+                                float tension, float friction, float mass) {
+        float k = std::max(tension, 1e-4f);
+        float c = std::max(friction, 0.0f);
+        float m = std::max(mass, 1e-4f);
+        float omega0 = std::sqrt(k / m);
+        float zeta = c / (2.0f * std::sqrt(k * m));
+
+        SpringSolution s;
+        if (std::abs(zeta - 1.0f) < 1e-4f) {
+            s.regime = SpringRegime::Critical;
+            s.alpha = omega0;
+            s.a = x0;
+            s.b = v0 + omega0 * x0;
+        } else if (zeta < 1.0f) {
+            s.regime = SpringRegime::Under;
+            s.alpha = zeta * omega0;
+            s.omega = omega0 * std::sqrt(1.0f - zeta * zeta);
+            s.a = x0;
+            s.b = (v0 + s.alpha * x0) / s.omega;
+        } else {
+            float root = omega0 * std::sqrt(zeta * zeta - 1.0f);
+            float r1 = -zeta * omega0 + root; // slow
+            float r2 = -zeta * omega0 - root; // fast
+            s.regime = SpringRegime::Over;
+            s.alpha = -r1;
+            s.omega = -r2;
+            s.a = (v0 - r2 * x0) / (r1 - r2);
+            s.b = x0 - s.a;
+        }
+        s.settleMs = s.findSettleTime();
+        return s;
+    }
+
+    /// Displacement (px) and velocity (px/s) at `t` seconds.
+    void evaluate(float t, float &x, float &v) const {
+        switch (regime) {
+            case SpringRegime::Under: {
+                float e = std::exp(-alpha * t);
+                float cs = std::cos(omega * t), sn = std::sin(omega * t);
+                x = e * (a * cs + b * sn);
+                v = e * ((b * omega - alpha * a) * cs - (a * omega + alpha * b) * sn);
+                break;
+            }
+            case SpringRegime::Critical: {
+                float e = std::exp(-alpha * t);
+                x = e * (a + b * t);
+                v = e * (b - alpha * (a + b * t));
+                break;
+            }
+            case SpringRegime::Over: {
+                float e1 = std::exp(-alpha * t), e2 = std::exp(-omega * t);
+                x = a * e1 + b * e2;
+                v = -alpha * a * e1 - omega * b * e2;
+                break;
+            }
+        }
+    }
+
+private:
+    /// Upper bounds on |x| and |v| at `t`. Non-increasing in t, except
+    /// for Critical before t = 1/α.
+    void envelope(float t, float &bx, float &bv) const {
+        switch (regime) {
+            case SpringRegime::Under: {
+                float e = std::exp(-alpha * t);
+                float p = b * omega - alpha * a, q = a * omega + alpha * b;
+                bx = e * std::sqrt(a * a + b * b);
+                bv = e * std::sqrt(p * p + q * q);
+                break;
+            }
+            case SpringRegime::Critical: {
+                float e = std::exp(-alpha * t);
+                bx = e * (std::abs(a) + std::abs(b) * t);
+                bv = e * (std::abs(b - alpha * a) + alpha * std::abs(b) * t);
+                break;
+            }
+            case SpringRegime::Over: {
+                float e1 = std::exp(-alpha * t), e2 = std::exp(-omega * t);
+                bx = std::abs(a) * e1 + std::abs(b) * e2;
+                bv = alpha * std::abs(a) * e1 + omega * std::abs(b) * e2;
+                break;
+            }
+        }
+    }
+
+    /// Bounds of the form e^(-αt)·(A + B·t) for Under and Over. Near
+    /// ζ = 1 the terms of envelope() grow without limit (b ~ 1/ω for
+    /// Under, a ~ 1/(ω − α) for Over) while these converge on the
+    /// critical envelope. Non-increasing from t = 1/α on.
+    void nearCriticalEnvelope(float t, float &bx, float &bv) const {
+        float e = std::exp(-alpha * t);
+        if (regime == SpringRegime::Under) {
+            // |sin ωt| ≤ ωt
+            float p = b * omega - alpha * a, q = a * omega + alpha * b;
+            bx = e * (std::abs(a) + std::abs(b) * omega * t);
+            bv = e * (std::abs(p) + std::abs(q) * omega * t);
+        } else {
+            // With s = 1 − e^(-(ω − α)t) ≤ (ω − α)·t:
+            //   x = e1·(x0 − b·s),  v = e1·(v0 + ω·b·s)
+            float x0 = a + b, v0 = -alpha * a - omega * b;
+            float spread = std::abs(b) * (omega - alpha);
+            bx = e * (std::abs(x0) + spread * t);
+            bv = e * (std::abs(v0) + omega * spread * t);
+        }
+    }
+
+    bool restsBy(float t, bool nearCritical = false) const {
+        float bx = 0, bv = 0;
+        if (nearCritical) nearCriticalEnvelope(t, bx, bv);
+        else envelope(t, bx, bv);
+        return bx < SPRING_REST_DISPLACEMENT && bv < SPRING_REST_VELOCITY;
+    }
+
+    /// Earliest time (ms) after which the spring stays at rest.
+    float findSettleTime() const {
+        float settle = bisectSettleTime(false);
+        if (regime == SpringRegime::Critical) return settle;
+        // Near ζ = 1 the e^(-αt)·(A + B·t) bound rests much sooner
+        float tight = bisectSettleTime(true);
+        return std::min(settle, tight);
+    }
+
+    /// Settle time (ms) under one envelope: bracket, then bisect.
+    float bisectSettleTime(bool nearCritical) const {
+        const float maxSec = SPRING_MAX_SETTLE_MS / 1000.0f;
+        // e^(-αt)·(A + B·t) envelopes peak before 1/α; search past the peak
+        bool peaked = nearCritical || regime == SpringRegime::Critical;
+        float lo = peaked ? 1.0f / alpha : 0.0f;
+        if (lo >= maxSec) return SPRING_MAX_SETTLE_MS;
+        if (restsBy(lo, nearCritical)) return lo * 1000.0f;
+
+        // Bracket, then bisect to ~0.1 ms
+        float hi = std::max(lo * 2.0f, 0.016f);
+        while (!restsBy(hi, nearCritical)) {
+            lo = hi;
+            hi *= 2.0f;
+            if (hi >= maxSec) {
+                if (!restsBy(maxSec, nearCritical)) return SPRING_MAX_SETTLE_MS;
+                hi = maxSec;
+                break;
+            }
+        }
+        while (hi - lo > 1e-4f) {
+            float mid = 0.5f * (lo + hi);
+            if (restsBy(mid, nearCritical)) hi = mid;
+            else lo = mid;
+        }
+        return hi * 1000.0f;
+    }
+};
+
+} // namespace animation
+} // namespace zilol
@@ -0,0 +1,421 @@
+/**
+ * ValueGraph.h — native derived values (animated nodes).
+ *
+ * A graph is an expression over live native values — scroll offsets,
+ * running animations, node props — whose results are written into
+ * SkiaNode props. JS describes it once; it is compiled into a flat
+ * instruction list and evaluated every frame after the scroll and
+ * animation ticks, so values derived from motion (header opacity from
+ * scroll, card scale from a pan) never wait on JS.
+ *
+ * Expressions (JS objects, nested; a bare number is a constant):
+ *   { op: "const", value }
+ *   { op: "scroll", engine, axis: "x" | "y" | "velocityX" | "velocityY" }
+ *   { op: "animation", id }        holds the last value once it ends
+ *   { op: "shared", slot }         a shared value (SharedValues.h); JS
+ *                                  writes apply on the next frame
+ *   { op: "prop", node, prop }     the prop's current value
+ *   { op: "add" | "sub" | "multiply" | "divide" | "min" | "max", args: [expr, …] }
+ *   { op: "modulo", args: [a, b] } result takes the sign of b
+ *   { op: "greaterThan" | "lessThan", args: [a, b] }  → 1 or 0
+ *   { op: "cond", args: [test, then, else] }          test != 0
+ *   { op: "interpolate", input, inputRange, outputRange, extrapolate? }
+ *   { op: "clamp", input, min, max }
+ *   { op: "diffClamp", input, min, max }  accumulates input deltas,
+ *                                         clamped (collapsing headers)
+ *
+ * JSI API:
+ *   __valueGraphCreate([{ node, prop, value: expr }, …]) → graphId
+ *   __valueGraphRemove(graphId)
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+#include "animation/AnimationTicker.h"
+#include "animation/NodeProps.h"
+#include "animation/SharedValues.h"
+#include "gestures/ScrollEngine.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zilol {
+namespace animation {
+
+// ---------------------------------------------------------------------------
+// Instructions
+// ---------------------------------------------------------------------------
+
+enum class GraphOp : uint8_t {
+    Const, Scroll, Animation, Prop, Shared,
+    Add, Sub, Multiply, Divide, Min, Max, Modulo,
+    GreaterThan, LessThan, Cond,
+    Interpolate, Clamp, DiffClamp
+};
+
+enum class ScrollInput : uint8_t { X, Y, VelocityX, VelocityY };
+
+/// One instruction. Its result lands in the register of the same index;
+/// operands only refer to earlier registers.
+struct GraphInstruction {
+    GraphOp op = GraphOp::Const;
+    int a = -1, b = -1, c = -1;     // operand registers
+    float constant = 0;             // Const
+    int source = 0;                 // Scroll: engine id; Animation: anim id;
+                                    // Shared: slot
+    ScrollInput axis = ScrollInput::Y;
+    skia::SkiaNode *node = nullptr; // Prop
+    PropId prop = PropId::Unknown;
+    int range = -1;                 // Interpolate: index into ranges
+    Extrapolate extrapolate = Extrapolate::Extend;
+
+    // State carried across frames
+    float state = 0;       // Animation: last value; DiffClamp: accumulated
+    float lastInput = 0;   // DiffClamp
+    bool primed = false;   // DiffClamp
+};
+
+struct GraphRange {
+    std::vector<float> input;
+    std::vector<float> output;
+};
+
+struct GraphOutput {
+    skia::SkiaNode *node = nullptr;
+    PropId prop = PropId::Unknown;
+    int reg = -1;
+    float written = std::numeric_limits<float>::quiet_NaN(); // last write
+};
+
+struct ValueGraph {
+    int id = 0;
+    std::vector<GraphInstruction> code;
+    std::vector<GraphRange> ranges;
+    std::vector<GraphOutput> outputs;
+    std::vector<float> registers; // sized to code
+
+    int emit(GraphInstruction instruction) {
+        code.push_back(instruction);
+        return static_cast<int>(code.size()) - 1;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// ValueGraphRunner — owns graphs, evaluated once per frame
+// ---------------------------------------------------------------------------
+
+class ValueGraphRunner {
+public:
+    ValueGraphRunner(gestures::ScrollEngineManager *scroll, AnimationTicker *ticker)
+        : scroll_(scroll), ticker_(ticker) {}
+
+    int add(ValueGraph graph) {
+        graph.id = nextId_++;
+        graph.registers.assign(graph.code.size(), 0.0f);
+        int id = graph.id;
+        graphs_.push_back(std::move(graph));
+        evaluate(graphs_.back()); // apply immediately, like scroll bindings
+        return id;
+    }
+
+    void remove(int id) {
+        graphs_.erase(std::remove_if(graphs_.begin(), graphs_.end(),
+            [id](const ValueGraph &g) { return g.id == id; }), graphs_.end());
+    }
+
+    bool empty() const { return graphs_.empty(); }
+
+    void setSharedValues(const SharedValueStore *shared) { shared_ = shared; }
+
+    /// Evaluate every graph. Call after the scroll and animation ticks.
+    void evaluateAll() {
+        for (auto &graph : graphs_) evaluate(graph);
+    }
+
+private:
+    gestures::ScrollEngineManager *scroll_;
+    AnimationTicker *ticker_;
+    const SharedValueStore *shared_ = nullptr;
+    std::vector<ValueGraph> graphs_;
+    int nextId_ = 1;
+
+    void evaluate(ValueGraph &g) {
+        float *r = g.registers.data();
+        for (size_t i = 0; i < g.code.size(); i++) {
+            auto &in = g.code[i];
+            switch (in.op) {
+                case GraphOp::Const: r[i] = in.constant; break;
+                case GraphOp::Scroll: r[i] = readScroll(in); break;
+                case GraphOp::Animation:
+                    // A finished animation holds its final value
+                    ticker_->currentValue(in.source, in.state);
+                    r[i] = in.state;
+                    break;
+                case GraphOp::Prop:
+                    r[i] = in.node ? readNodeProp(in.node, in.prop) : 0.0f;
+                    break;
+                case GraphOp::Shared:
+                    r[i] = shared_ ? shared_->read(in.source) : 0.0f;
+                    break;
+                case GraphOp::Add: r[i] = r[in.a] + r[in.b]; break;
+                case GraphOp::Sub: r[i] = r[in.a] - r[in.b]; break;
+                case GraphOp::Multiply: r[i] = r[in.a] * r[in.b]; break;
+                case GraphOp::Divide: r[i] = r[in.b] != 0 ? r[in.a] / r[in.b] : 0.0f; break;
+                case GraphOp::Min: r[i] = std::min(r[in.a], r[in.b]); break;
+                case GraphOp::Max: r[i] = std::max(r[in.a], r[in.b]); break;
+                case GraphOp::Modulo: {
+                    float m = r[in.b];
+                    float v = m != 0 ? std::fmod(r[in.a], m) : 0.0f;
+                    r[i] = v != 0 && (v < 0) != (m < 0) ? v + m : v;
+                    break;
+                }
+                case GraphOp::GreaterThan: r[i] = r[in.a] > r[in.b] ? 1.0f : 0.0f; break;
+                case GraphOp::LessThan: r[i] = r[in.a] < r[in.b] ? 1.0f : 0.0f; break;
+                case GraphOp::Cond: r[i] = r[in.a] != 0 ? r[in.b] : r[in.c]; break;
+                case GraphOp::Interpolate: {
+                    auto &range = g.ranges[in.range];
+                    r[i] = interpolateRange(r[in.a], range.input, range.output,
+                                            in.extrapolate, in.extrapolate);
+                    break;
+                }
+                case GraphOp::Clamp:
+                    r[i] = std::clamp(r[in.a], r[in.b], std::max(r[in.b], r[in.c]));
+                    break;
+                case GraphOp::DiffClamp: {
+                    float x = r[in.a];
+                    float lo = r[in.b], hi = std::max(r[in.b], r[in.c]);
+                    float delta = in.primed ? x - in.lastInput : x;
+                    in.state = std::clamp(in.state + delta, lo, hi);
+                    in.lastInput = x;
+                    in.primed = true;
+                    r[i] = in.state;
+                    break;
+                }
+            }
+        }
+        // Only changed outputs dirty their node
+        for (auto &out : g.outputs) {
+            float v = r[out.reg];
+            if (v == out.written) continue;
+            out.written = v;
+            writeNodeProp(out.node, out.prop, v);
+        }
+    }
+
+    float readScroll(const GraphInstruction &in) const {
+        auto *engine = scroll_ ? scroll_->get(in.source) : nullptr;
+        if (!engine) return 0;
+        switch (in.axis) {
+            case ScrollInput::X: return engine->offsetX;
+            case ScrollInput::Y: return engine->offsetY;
+            case ScrollInput::VelocityX: return engine->reportedVelocityX();
+            case ScrollInput::VelocityY: return engine->reportedVelocityY();
+        }
+        return 0;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// JSI Registration
+// ---------------------------------------------------------------------------
+
+/// Compile `expr` (and its operands) into `graph`. Returns its register,
+/// or -1 on an unknown op, a missing operand or a malformed range.
+inline int compileGraphExpression(facebook::jsi::Runtime &rt,
+                                  skia::SkiaNodeTree *tree,
+                                  const facebook::jsi::Value &expr,
+                                  ValueGraph &graph)
+{
+    using namespace facebook;
+
+    GraphInstruction in;
+    if (expr.isNumber()) {
+        in.constant = static_cast<float>(expr.asNumber());
+        return graph.emit(in);
+    }
+    if (!expr.isObject()) return -1;
+    auto obj = expr.asObject(rt);
+    if (!obj.hasProperty(rt, "op")) return -1;
+    auto op = obj.getProperty(rt, "op").asString(rt).utf8(rt);
+
+    auto number = [&](const char *key, double fallback) {
+        return obj.hasProperty(rt, key) ? obj.getProperty(rt, key).asNumber() : fallback;
+    };
+    auto operand = [&](const char *key) {
+        return obj.hasProperty(rt, key)
+            ? compileGraphExpression(rt, tree, obj.getProperty(rt, key), graph)
+            : -1;
+    };
+    auto readRange = [&](const char *key) {
+        std::vector<float> out;
+        if (!obj.hasProperty(rt, key)) return out;
+        auto arr = obj.getProperty(rt, key).asObject(rt).asArray(rt);
+        size_t n = arr.size(rt);
+        out.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            out.push_back(static_cast<float>(arr.getValueAtIndex(rt, i).asNumber()));
+        }
+        return out;
+    };
+
+    // ── Sources ──
+    if (op == "const") {
+        in.constant = static_cast<float>(number("value", 0));
+        return graph.emit(in);
+    }
+    if (op == "scroll") {
+        in.op = GraphOp::Scroll;
+        in.source = static_cast<int>(number("engine", 0));
+        auto axis = obj.hasProperty(rt, "axis")
+            ? obj.getProperty(rt, "axis").asString(rt).utf8(rt) : std::string("y");
+        in.axis = axis == "x" ? ScrollInput::X
+                : axis == "velocityX" ? ScrollInput::VelocityX
+                : axis == "velocityY" ? ScrollInput::VelocityY
+                : ScrollInput::Y;
+        return graph.emit(in);
+    }
+    if (op == "animation") {
+        in.op = GraphOp::Animation;
+        in.source = static_cast<int>(number("id", 0));
+        return graph.emit(in);
+    }
+    if (op == "shared") {
+        in.op = GraphOp::Shared;
+        in.source = static_cast<int>(number("slot", -1));
+        if (in.source < 0 || in.source >= SHARED_VALUE_CAPACITY) return -1;
+        return graph.emit(in);
+    }
+    if (op == "prop") {
+        in.op = GraphOp::Prop;
+        in.node = tree->getNode(static_cast<int>(number("node", 0)));
+        in.prop = propIdFromString(obj.getProperty(rt, "prop").asString(rt).utf8(rt));
+        if (!in.node || in.prop == PropId::Unknown) return -1;
+        return graph.emit(in);
+    }
+
+    // ── Single input ──
+    if (op == "interpolate") {
+        in.op = GraphOp::Interpolate;
+        in.a = operand("input");
+        GraphRange range{readRange("inputRange"), readRange("outputRange")};
+        if (in.a < 0 || range.input.size() < 2 || range.input.size() != range.output.size()) {
+            return -1;
+        }
+        if (obj.hasProperty(rt, "extrapolate")) {
+            in.extrapolate = extrapolateFromString(
+                obj.getProperty(rt, "extrapolate").asString(rt).utf8(rt));
+        }
+        in.range = static_cast<int>(graph.ranges.size());
+        graph.ranges.push_back(std::move(range));
+        return graph.emit(in);
+    }
+    if (op == "clamp" || op == "diffClamp") {
+        in.op = op == "clamp" ? GraphOp::Clamp : GraphOp::DiffClamp;
+        in.a = operand("input");
+        in.b = operand("min");
+        in.c = operand("max");
+        if (in.a < 0 || in.b < 0 || in.c < 0) return -1;
+        return graph.emit(in);
+    }
+
+    // ── args: [expr, …] ──
+    static const std::unordered_map<std::string, GraphOp> kArgOps = {
+        {"add", GraphOp::Add}, {"sub", GraphOp::Sub},
+        {"multiply", GraphOp::Multiply}, {"divide", GraphOp::Divide},
+        {"min", GraphOp::Min}, {"max", GraphOp::Max},
+        {"modulo", GraphOp::Modulo},
+        {"greaterThan", GraphOp::GreaterThan}, {"lessThan", GraphOp::LessThan},
+        {"cond", GraphOp::Cond},
+    };
+    auto found = kArgOps.find(op);
+    if (found == kArgOps.end() || !obj.hasProperty(rt, "args")) return -1;
+    auto args = obj.getProperty(rt, "args").asObject(rt).asArray(rt);
+    size_t n = args.size(rt);
+    std::vector<int> regs;
+    for (size_t i = 0; i < n; i++) {
+        int reg = compileGraphExpression(rt, tree, args.getValueAtIndex(rt, i), graph);
+        if (reg < 0) return -1;
+        regs.push_back(reg);
+    }
+
+    in.op = found->second;
+    if (in.op == GraphOp::Cond) {
+        if (regs.size() != 3) return -1;
+        in.a = regs[0]; in.b = regs[1]; in.c = regs[2];
+        return graph.emit(in);
+    }
+    if (regs.size() < 2) return -1;
+    bool chains = in.op == GraphOp::Add || in.op == GraphOp::Multiply ||
+                  in.op == GraphOp::Min || in.op == GraphOp::Max;
+    if (!chains && regs.size() != 2) return -1;
+    // Variadic ops fold left: ((a + b) + c) + …
+    int acc = regs[0];
+    for (size_t i = 1; i < regs.size(); i++) {
+        in.a = acc;
+        in.b = regs[i];
+        acc = graph.emit(in);
+    }
+    return acc;
+}
+
+inline void registerValueGraphHostFunctions(
+    facebook::jsi::Runtime &rt,
+    ValueGraphRunner *runner,
+    skia::SkiaNodeTree *tree)
+{
+    using namespace facebook;
+
+    // __valueGraphCreate(outputs) → graphId
+    // outputs: [{ node, prop, value: expr }, …] — expressions as described
+    // at the top of ValueGraph.h. Compiled once; returns -1 if any output
+    // or expression is malformed.
+    rt.global().setProperty(rt, "__valueGraphCreate",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__valueGraphCreate"), 1,
+            [runner, tree](jsi::Runtime &rt, const jsi::Value &,
+                           const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isObject() || !args[0].asObject(rt).isArray(rt)) {
+                    return jsi::Value(-1);
+                }
+                auto list = args[0].asObject(rt).asArray(rt);
+                size_t n = list.size(rt);
+                ValueGraph graph;
+                for (size_t i = 0; i < n; i++) {
+                    auto spec = list.getValueAtIndex(rt, i).asObject(rt);
+                    GraphOutput out;
+                    out.node = tree->getNode(static_cast<int>(
+                        spec.getProperty(rt, "node").asNumber()));
+                    out.prop = propIdFromString(
+                        spec.getProperty(rt, "prop").asString(rt).utf8(rt));
+                    out.reg = compileGraphExpression(
+                        rt, tree, spec.getProperty(rt, "value"), graph);
+                    if (!out.node || out.prop == PropId::Unknown || out.reg < 0) {
+                        return jsi::Value(-1);
+                    }
+                    graph.outputs.push_back(out);
+                }
+                return jsi::Value(runner->add(std::move(graph)));
+            }));
+
+    // __valueGraphRemove(graphId)
+    rt.global().setProperty(rt, "__valueGraphRemove",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__valueGraphRemove"), 1,
+            [runner](jsi::Runtime &, const jsi::Value &,
+                     const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1) return jsi::Value::undefined();
+                runner->remove(static_cast<int>(args[0].asNumber()));
+                return jsi::Value::undefined();
+            }));
+}
+
+} // namespace animation
+} // namespace zilol
@@ -11,12 +11,15 @@
 
 #pragma once
 
+#include "gestures/VelocityTracker.h"
+
 #include <jsi/jsi.h>
 
 #include <memory>
 #include <string>
 #include <cmath>
 #include <chrono>
+#include <functional>
 #include <unordered_map>
 
 namespace zilol {
@@ -86,6 +89,9 @@ struct TouchPoint {
 // GestureRecognizer base class
 // ---------------------------------------------------------------------------
 
+// Slots a recognizer writes into its shared values
+static constexpr int GESTURE_SHARED_SLOTS = 9;
+
 class GestureRecognizer {
 public:
     int gestureId = 0;
@@ -97,6 +103,14 @@ public:
     std::shared_ptr<facebook::jsi::Function> onUpdate;
     std::shared_ptr<facebook::jsi::Function> onEnd;
 
+    // Native observer (e.g. a PanDrive) — runs before the JS callbacks
+    std::function<void(GestureState, const GestureEvent &)> onNative;
+
+    // Shared value slots (animation/SharedValues.h), written on every
+    // event before any callback: state, x, y, translationX, translationY,
+    // velocityX, velocityY, scale, rotation
+    float *sharedSlots = nullptr;
+
     virtual ~GestureRecognizer() = default;
 
     /// Called for each touch event on this node.
@@ -111,23 +125,49 @@ public:
     /// Get the gesture type string.
     virtual std::string type() const = 0;
 
+    /// Mirror `state` into the state slot after a touch event, so JS can
+    /// tell Ended from Cancelled or Failed without an onEnd callback.
+    void publishState() {
+        if (sharedSlots) sharedSlots[0] = static_cast<float>(state);
+    }
+
 protected:
     void fireStart(facebook::jsi::Runtime &rt, const GestureEvent &e) {
+        publishShared(GestureState::Began, e);
+        if (onNative) onNative(GestureState::Began, e);
         if (onStart) {
             try { onStart->call(rt, e.toJSI(rt)); } catch (...) {}
         }
     }
     void fireUpdate(facebook::jsi::Runtime &rt, const GestureEvent &e) {
+        publishShared(GestureState::Changed, e);
+        if (onNative) onNative(GestureState::Changed, e);
         if (onUpdate) {
             try { onUpdate->call(rt, e.toJSI(rt)); } catch (...) {}
         }
     }
     void fireEnd(facebook::jsi::Runtime &rt, const GestureEvent &e) {
+        publishShared(GestureState::Ended, e);
+        if (onNative) onNative(GestureState::Ended, e);
         if (onEnd) {
             try { onEnd->call(rt, e.toJSI(rt)); } catch (...) {}
         }
     }
 
+    void publishShared(GestureState s, const GestureEvent &e) {
+        if (!sharedSlots) return;
+        float *v = sharedSlots;
+        v[0] = static_cast<float>(s);
+        v[1] = e.x;
+        v[2] = e.y;
+        v[3] = e.translationX;
+        v[4] = e.translationY;
+        v[5] = e.velocityX;
+        v[6] = e.velocityY;
+        v[7] = e.scale;
+        v[8] = e.rotation;
+    }
+
     static double nowMs() {
         return std::chrono::duration<double, std::milli>(
             std::chrono::steady_clock::now().time_since_epoch()).count();
@@ -144,6 +184,11 @@ public:
 
     std::string type() const override { return "pan"; }
 
+    void setVelocityEstimator(VelocityEstimator estimator) {
+        trackerX_.estimator = estimator;
+        trackerY_.estimator = estimator;
+    }
+
     void onTouchEvent(int phase, float x, float y, int pointerId,
                       facebook::jsi::Runtime &rt) override {
         double now = nowMs();
@@ -156,14 +201,19 @@ public:
                 touch_.startTimeMs = now;
                 touch_.lastTimeMs = now;
                 touch_.active = true;
-                prevX_ = x; prevY_ = y;
-                prevTimeMs_ = now;
+                trackerX_.reset();
+                trackerY_.reset();
+                trackerX_.addPoint(now, x);
+                trackerY_.addPoint(now, y);
                 state = GestureState::Possible;
                 break;
             }
             case 1: { // moved
                 if (!touch_.active || touch_.pointerId != pointerId) return;
                 touch_.x = x; touch_.y = y;
+                touch_.lastTimeMs = now;
+                trackerX_.addPoint(now, x);
+                trackerY_.addPoint(now, y);
 
                 float dx = x - touch_.startX;
                 float dy = y - touch_.startY;
@@ -179,22 +229,15 @@ public:
                     fireStart(rt, e);
                     state = GestureState::Changed;
                 } else if (state == GestureState::Changed) {
-                    // Velocity: pixels per second
-                    double dt = (now - prevTimeMs_) / 1000.0;
-                    float vx = dt > 0 ? (x - prevX_) / (float)dt : 0;
-                    float vy = dt > 0 ? (y - prevY_) / (float)dt : 0;
-
                     GestureEvent e;
                     e.x = x; e.y = y;
                     e.absoluteX = x; e.absoluteY = y;
                     e.translationX = dx; e.translationY = dy;
-                    e.velocityX = vx; e.velocityY = vy;
+                    e.velocityX = trackerX_.getVelocity();
+                    e.velocityY = trackerY_.getVelocity();
                     e.numberOfPointers = 1;
                     fireUpdate(rt, e);
                 }
-
-                prevX_ = x; prevY_ = y;
-                prevTimeMs_ = now;
                 break;
             }
             case 2: // ended
@@ -203,16 +246,13 @@ public:
                 touch_.active = false;
 
                 if (state == GestureState::Changed || state == GestureState::Began) {
-                    double dt = (now - prevTimeMs_) / 1000.0;
-                    float vx = dt > 0 ? (x - prevX_) / (float)dt : 0;
-                    float vy = dt > 0 ? (y - prevY_) / (float)dt : 0;
-
                     GestureEvent e;
                     e.x = x; e.y = y;
                     e.absoluteX = x; e.absoluteY = y;
                     e.translationX = x - touch_.startX;
                     e.translationY = y - touch_.startY;
-                    e.velocityX = vx; e.velocityY = vy;
+                    e.velocityX = trackerX_.getVelocity();
+                    e.velocityY = trackerY_.getVelocity();
                     e.numberOfPointers = 0;
                     fireEnd(rt, e);
                 }
@@ -225,14 +265,13 @@ public:
     void reset() override {
         GestureRecognizer::reset();
         touch_ = {};
-        prevX_ = 0; prevY_ = 0;
-        prevTimeMs_ = 0;
+        trackerX_.reset();
+        trackerY_.reset();
     }
 
 private:
     TouchPoint touch_;
-    float prevX_ = 0, prevY_ = 0;
-    double prevTimeMs_ = 0;
+    VelocityTracker trackerX_, trackerY_;
 };
 
 // ---------------------------------------------------------------------------
@@ -0,0 +1,335 @@
+/**
+ * HitTestIndex.h — uniform-grid index over node rects for hit testing.
+ *
+ * The tree is split into spaces at Scroll nodes: the top space holds
+ * every node outside a scroll container, and each Scroll node owns a
+ * space for its content. A space indexes only the nodes a hit can land
+ * on — hit targets and the Scroll nodes that lead into nested spaces —
+ * by their absolute rect, in a uniform grid. Content rects are stored
+ * in content coordinates, so scrolling never touches the index; the
+ * query maps the point through the scroll offset instead.
+ *
+ * A query visits the candidates under the point front to back: in the
+ * tree's pre-order, reversed, which is the order the recursive walk
+ * returns them in. The caller still checks each candidate's ancestors
+ * (visibility, bounds), but only along one path, so cost follows tree
+ * depth and cell occupancy rather than node count.
+ *
+ * Every indexed node maps to the space holding it, so an update finds
+ * its space with one lookup instead of scanning them all.
+ *
+ * Updates:
+ *   layout change of an indexed node   re-bucketed in place
+ *   target set gains or loses a node   its space rebuilds on next query
+ *   child insert / remove              the parent's space (and any space
+ *                                      still holding the subtree) rebuilds
+ *                                      lazily; Scroll spaces in it drop
+ *   new root                           every space rebuilds lazily
+ *   prop set                           only `touchable` and geometry keys
+ *                                      (layout, transform) do anything
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace zilol {
+namespace gestures {
+
+// Grid cell edge (pt); grows for very large spaces to bound the cell count
+static constexpr float HIT_GRID_CELL = 128.0f;
+static constexpr int HIT_GRID_MAX_CELLS = 1 << 14;
+// Rects spanning more cells than this go on one always-tested list
+static constexpr int HIT_GRID_MAX_SPAN = 16;
+
+struct HitRect {
+    float left = 0, top = 0, right = 0, bottom = 0;
+
+    static HitRect of(const skia::SkiaNode *node) {
+        auto &l = node->layout;
+        return {l.absoluteX, l.absoluteY, l.absoluteX + l.width, l.absoluteY + l.height};
+    }
+
+    bool contains(float x, float y) const {
+        return x >= left && x <= right && y >= top && y <= bottom;
+    }
+};
+
+/// What setting a node prop can change in the index.
+enum class HitPropEffect { None, Target, Geometry };
+
+inline HitPropEffect hitPropEffect(const std::string &key) {
+    static const std::unordered_set<std::string> geometry = {
+        // layout
+        "width", "height", "minWidth", "minHeight", "maxWidth", "maxHeight",
+        "flex", "flexDirection", "justifyContent", "alignItems", "alignSelf",
+        "position", "top", "right", "bottom", "left",
+        "margin", "marginTop", "marginRight", "marginBottom", "marginLeft",
+        "marginHorizontal", "marginVertical",
+        "padding", "paddingTop", "paddingRight", "paddingBottom", "paddingLeft",
+        "paddingHorizontal", "paddingVertical",
+        // transform
+        "translateX", "translateY", "scaleX", "scaleY", "rotation", "transform",
+    };
+    if (key == "touchable") return HitPropEffect::Target;
+    return geometry.count(key) ? HitPropEffect::Geometry : HitPropEffect::None;
+}
+
+class HitTestIndex {
+public:
+    /// Whether a node belongs in the index: a hit target or a Scroll node.
+    std::function<bool(const skia::SkiaNode *)> indexed;
+
+    /// Drop every space (new root). Rebuilt on the next query.
+    void invalidate() {
+        spaces_.clear();
+        spaceOf_.clear();
+    }
+
+    /// `child`'s subtree was inserted under or removed from `parent`.
+    /// Only the space holding `parent`'s children rebuilds, plus a space
+    /// the subtree was moved out of without a remove. The spaces of
+    /// Scroll nodes inside the subtree are dropped.
+    void onChildChanged(const skia::SkiaNode *parent, const skia::SkiaNode *child) {
+        if (!parent || !child) return;
+        const skia::SkiaNode *key = parent;
+        if (parent->type == skia::NodeType::Scroll || owningSpace(parent, key)) {
+            auto it = spaces_.find(key);
+            if (it != spaces_.end()) it->second.dirty = true;
+        }
+        detachSubtree(child);
+    }
+
+    /// `node`'s absolute rect changed.
+    void onLayoutChanged(skia::SkiaNode *node) {
+        auto *space = indexedSpaceOf(node);
+        if (!space || space->dirty) return;
+        auto it = space->slots.find(node);
+        if (it == space->slots.end()) return;
+        auto &entry = space->entries[it->second];
+        unbucket(*space, it->second);
+        entry.rect = HitRect::of(node);
+        if (!bucket(*space, it->second)) space->dirty = true; // left the grid
+    }
+
+    /// `node` may have become, or stopped being, a hit target.
+    void onTargetChanged(skia::SkiaNode *node) {
+        auto *space = builtSpaceOf(node);
+        if (!space) return;
+        bool wasIndexed = space->slots.count(node) > 0;
+        if (wasIndexed != (indexed && indexed(node))) space->dirty = true;
+    }
+
+    /**
+     * Visit indexed nodes under (x, y) in `spaceRoot`'s space (nullptr =
+     * the top space under `treeRoot`), front to back, until `visit`
+     * returns a node; that node is returned.
+     */
+    template <typename Visit>
+    skia::SkiaNode *query(skia::SkiaNode *spaceRoot, skia::SkiaNode *treeRoot,
+                          float x, float y, Visit &&visit) {
+        if (!spaceRoot && treeRoot != treeRoot_) {
+            invalidate();
+            treeRoot_ = treeRoot;
+        }
+        auto &space = spaces_[spaceRoot];
+        if (space.dirty) build(space, spaceRoot);
+
+        // Merge the cell's list with the oversized list, both descending
+        static const std::vector<uint32_t> kNone;
+        const auto &cell = space.cellAt(x, y) >= 0 ? space.cells[space.cellAt(x, y)] : kNone;
+        const auto &large = space.large;
+        size_t i = 0, j = 0;
+        while (i < cell.size() || j < large.size()) {
+            uint32_t e = j >= large.size() || (i < cell.size() && cell[i] > large[j])
+                ? cell[i++] : large[j++];
+            const auto &entry = space.entries[e];
+            if (!entry.rect.contains(x, y)) continue;
+            if (auto *hit = visit(entry.node)) return hit;
+        }
+        return nullptr;
+    }
+
+private:
+    struct Entry {
+        skia::SkiaNode *node = nullptr;
+        HitRect rect;
+        bool large = false;
+    };
+
+    // Entry index = pre-order rank within the space; lists hold entry
+    // indices in descending order (front-most first)
+    struct Space {
+        bool dirty = true;
+        std::vector<Entry> entries;
+        std::unordered_map<const skia::SkiaNode *, uint32_t> slots;
+        float originX = 0, originY = 0, cell = HIT_GRID_CELL;
+        int cols = 0, rows = 0;
+        std::vector<std::vector<uint32_t>> cells;
+        std::vector<uint32_t> large;
+
+        int cellAt(float x, float y) const {
+            int c = static_cast<int>(std::floor((x - originX) / cell));
+            int r = static_cast<int>(std::floor((y - originY) / cell));
+            if (c < 0 || r < 0 || c >= cols || r >= rows) return -1;
+            return r * cols + c;
+        }
+    };
+
+    skia::SkiaNode *treeRoot_ = nullptr;
+    std::unordered_map<const skia::SkiaNode *, Space> spaces_; // nullptr = top
+    // Indexed node → key of the space whose entries hold it
+    std::unordered_map<const skia::SkiaNode *, const skia::SkiaNode *> spaceOf_;
+
+    /// Space key for `node` (its nearest Scroll ancestor, or nullptr), or
+    /// false if the node is not under the indexed root.
+    bool owningSpace(const skia::SkiaNode *node, const skia::SkiaNode *&key) const {
+        key = nullptr;
+        const skia::SkiaNode *top = node;
+        for (auto *p = node->parent; p; p = p->parent) {
+            if (!key && p->type == skia::NodeType::Scroll) key = p;
+            top = p;
+        }
+        return top == treeRoot_;
+    }
+
+    /// The built space holding `node`, or nullptr if none is built yet.
+    Space *builtSpaceOf(const skia::SkiaNode *node) {
+        if (!node) return nullptr;
+        const skia::SkiaNode *key;
+        if (!owningSpace(node, key)) return nullptr;
+        auto it = spaces_.find(key);
+        return it != spaces_.end() && !it->second.dirty ? &it->second : nullptr;
+    }
+
+    /// The space whose entries hold `node`, or nullptr if it is not indexed.
+    Space *indexedSpaceOf(const skia::SkiaNode *node) {
+        auto it = spaceOf_.find(node);
+        if (it == spaceOf_.end()) return nullptr;
+        auto space = spaces_.find(it->second);
+        return space != spaces_.end() ? &space->second : nullptr;
+    }
+
+    void detachSubtree(const skia::SkiaNode *node) {
+        if (auto *space = indexedSpaceOf(node)) space->dirty = true;
+        if (node->type == skia::NodeType::Scroll) dropSpace(node);
+        for (auto *child : node->children) detachSubtree(child);
+    }
+
+    void dropSpace(const skia::SkiaNode *key) {
+        auto it = spaces_.find(key);
+        if (it == spaces_.end()) return;
+        forgetEntries(it->second, key);
+        spaces_.erase(it);
+    }
+
+    /// Unmap the nodes of `space` that still point at it (a node moved
+    /// between spaces may already belong to another).
+    void forgetEntries(const Space &space, const skia::SkiaNode *key) {
+        for (auto &entry : space.entries) {
+            auto it = spaceOf_.find(entry.node);
+            if (it != spaceOf_.end() && it->second == key) spaceOf_.erase(it);
+        }
+    }
+
+    void build(Space &space, skia::SkiaNode *spaceRoot) {
+        forgetEntries(space, spaceRoot);
+        space = Space();
+        space.dirty = false;
+        if (spaceRoot) {
+            for (auto *child : spaceRoot->children) collect(space, child);
+        } else if (treeRoot_) {
+            collect(space, treeRoot_);
+        }
+        for (auto &entry : space.entries) spaceOf_[entry.node] = spaceRoot;
+        if (space.entries.empty()) return;
+
+        HitRect bounds = space.entries[0].rect;
+        for (auto &e : space.entries) {
+            bounds.left = std::min(bounds.left, e.rect.left);
+            bounds.top = std::min(bounds.top, e.rect.top);
+            bounds.right = std::max(bounds.right, e.rect.right);
+            bounds.bottom = std::max(bounds.bottom, e.rect.bottom);
+        }
+        float w = std::max(bounds.right - bounds.left, 1.0f);
+        float h = std::max(bounds.bottom - bounds.top, 1.0f);
+        space.cell = std::max(HIT_GRID_CELL, std::sqrt(w * h / HIT_GRID_MAX_CELLS));
+        space.originX = bounds.left;
+        space.originY = bounds.top;
+        space.cols = static_cast<int>(w / space.cell) + 1;
+        space.rows = static_cast<int>(h / space.cell) + 1;
+        space.cells.assign(static_cast<size_t>(space.cols) * space.rows, {});
+        // Descending insertion keeps every list sorted front-most first
+        for (size_t i = space.entries.size(); i-- > 0;) bucket(space, static_cast<uint32_t>(i));
+    }
+
+    /// Pre-order walk; nested Scroll nodes are entries but own their content.
+    void collect(Space &space, skia::SkiaNode *node) {
+        if (indexed && indexed(node)) {
+            space.slots[node] = static_cast<uint32_t>(space.entries.size());
+            space.entries.push_back({node, HitRect::of(node)});
+        }
+        if (node->type == skia::NodeType::Scroll) return;
+        for (auto *child : node->children) collect(space, child);
+    }
+
+    /// Cell range of a rect, or false if it leaves the grid.
+    static bool span(const Space &space, const HitRect &r, int &c0, int &r0, int &c1, int &r1) {
+        c0 = static_cast<int>(std::floor((r.left - space.originX) / space.cell));
+        r0 = static_cast<int>(std::floor((r.top - space.originY) / space.cell));
+        c1 = static_cast<int>(std::floor((r.right - space.originX) / space.cell));
+        r1 = static_cast<int>(std::floor((r.bottom - space.originY) / space.cell));
+        return c0 >= 0 && r0 >= 0 && c1 < space.cols && r1 < space.rows;
+    }
+
+    static void insertSorted(std::vector<uint32_t> &list, uint32_t e) {
+        list.insert(std::upper_bound(list.begin(), list.end(), e, std::greater<uint32_t>()), e);
+    }
+
+    static void eraseFrom(std::vector<uint32_t> &list, uint32_t e) {
+        auto it = std::lower_bound(list.begin(), list.end(), e, std::greater<uint32_t>());
+        if (it != list.end() && *it == e) list.erase(it);
+    }
+
+    bool bucket(Space &space, uint32_t e) {
+        auto &entry = space.entries[e];
+        int c0, r0, c1, r1;
+        if (!span(space, entry.rect, c0, r0, c1, r1)) return false;
+        entry.large = (c1 - c0 + 1) * (r1 - r0 + 1) > HIT_GRID_MAX_SPAN;
+        if (entry.large) {
+            insertSorted(space.large, e);
+            return true;
+        }
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) insertSorted(space.cells[r * space.cols + c], e);
+        }
+        return true;
+    }
+
+    void unbucket(Space &space, uint32_t e) {
+        auto &entry = space.entries[e];
+        if (entry.large) {
+            eraseFrom(space.large, e);
+            return;
+        }
+        int c0, r0, c1, r1;
+        span(space, entry.rect, c0, r0, c1, r1);
+        for (int r = std::max(r0, 0); r <= std::min(r1, space.rows - 1); r++) {
+            for (int c = std::max(c0, 0); c <= std::min(c1, space.cols - 1); c++) {
+                eraseFrom(space.cells[r * space.cols + c], e);
+            }
+        }
+    }
+};
+
+} // namespace gestures
+} // namespace zilol
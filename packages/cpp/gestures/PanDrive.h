@@ -0,0 +1,214 @@
+/**
+ * PanDrive.h — pan translation written straight into node props.
+ *
+ * A PanDrive binds a PanRecognizer to a node: every pan update moves the
+ * node's position (layout x/y) by the pan translation,
+ * clamped or rubber-banded at optional bounds, and the release hands the
+ * finger velocity to an AnimationTicker spring or decay. A draggable card
+ * or bottom sheet then runs without JS on any move or on release.
+ *
+ * Release:
+ *   spring — springs to the rest point (default: where the drag began),
+ *            or to the snap point nearest the projected decay end
+ *   decay  — coasts with the finger velocity; a release past, or
+ *            projected past, a bound springs to that bound instead
+ *   none   — stays where the finger left it
+ *
+ * Every write carries the node's new position into layout.absoluteX/Y
+ * for it and its subtree, and reports each moved node through onMoved,
+ * so hit testing follows the node. Release animations only write x/y;
+ * onFrame() catches the absolutes up after each ticker frame.
+ *
+ * Driven through TouchDispatcher:
+ *   __gestureDrive(gestureId, nodeId, config)
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+#include "gestures/GestureRecognizer.h"
+#include "gestures/ScrollEngine.h"
+#include "animation/AnimationTicker.h"
+#include "animation/NodeProps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace zilol {
+namespace gestures {
+
+// ---------------------------------------------------------------------------
+// PanDriveAxis — one driven prop
+// ---------------------------------------------------------------------------
+
+struct PanDriveAxis {
+    bool enabled = true;
+    animation::PropId prop = animation::PropId::X;
+    float min = -std::numeric_limits<float>::infinity();
+    float max = std::numeric_limits<float>::infinity();
+    bool hasRest = false;
+    float rest = 0;              // spring target; default: drag start
+    std::vector<float> snapPoints;
+
+    // Runtime
+    float start = 0;             // prop value when the drag began
+    int animId = 0;              // running release animation
+
+    float clamp(float v) const { return std::clamp(v, min, std::max(min, max)); }
+};
+
+// ---------------------------------------------------------------------------
+// PanDrive
+// ---------------------------------------------------------------------------
+
+class PanDrive {
+public:
+    enum class Release : uint8_t { Spring, Decay, None };
+
+    skia::SkiaNode *node = nullptr;
+    PanDriveAxis x, y;           // layout x, layout y
+    bool rubberBand = true;      // false = hard clamp at the bounds
+    Release release = Release::Spring;
+
+    // Release drivers
+    float springTension = 170;
+    float springFriction = 26;
+    float springMass = 1;
+    float decayRate = 0.998f;    // per ms
+
+    // Called for the node and each descendant whose absolute position moved
+    std::function<void(skia::SkiaNode *)> onMoved;
+
+    PanDrive() { y.prop = animation::PropId::Y; }
+
+    /// Recognizer observer; `ticker` runs the release.
+    void onGesture(GestureState state, const GestureEvent &e,
+                   animation::AnimationTicker *ticker) {
+        if (!node) return;
+        switch (state) {
+            case GestureState::Began:
+                // Catch a release still in flight where it is
+                begin(x, ticker);
+                begin(y, ticker);
+                move(e);
+                break;
+            case GestureState::Changed:
+                move(e);
+                break;
+            case GestureState::Ended:
+                move(e);
+                // Tracker velocity is px/s; drivers take px/ms
+                finish(x, e.velocityX * 0.001f, ticker);
+                finish(y, e.velocityY * 0.001f, ticker);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /// After the ticker's frame: follow a running release into the
+    /// absolute positions, and forget releases that have settled.
+    void onFrame(animation::AnimationTicker *ticker) {
+        if (!node || (!x.animId && !y.animId)) return;
+        relayout();
+        for (auto *axis : {&x, &y}) {
+            if (axis->animId && !(ticker && ticker->isRunning(axis->animId))) axis->animId = 0;
+        }
+    }
+
+    /// Cancel release animations (the drive is being removed).
+    void stop(animation::AnimationTicker *ticker) {
+        for (auto *axis : {&x, &y}) {
+            if (axis->animId && ticker) ticker->cancel(axis->animId);
+            axis->animId = 0;
+        }
+    }
+
+private:
+    void begin(PanDriveAxis &axis, animation::AnimationTicker *ticker) {
+        if (!axis.enabled) return;
+        if (axis.animId && ticker) ticker->cancel(axis.animId);
+        axis.animId = 0;
+        axis.start = animation::readNodeProp(node, axis.prop);
+    }
+
+    void move(const GestureEvent &e) {
+        if (x.enabled) animation::writeNodeProp(node, x.prop, bounded(x, e.translationX, node->layout.width));
+        if (y.enabled) animation::writeNodeProp(node, y.prop, bounded(y, e.translationY, node->layout.height));
+        relayout();
+    }
+
+    /// Shift the subtree's absolute positions by however far x/y moved
+    /// the node since they were last computed.
+    void relayout() {
+        auto &l = node->layout;
+        float px = node->parent ? node->parent->layout.absoluteX : 0;
+        float py = node->parent ? node->parent->layout.absoluteY : 0;
+        float dx = px + l.x - l.absoluteX;
+        float dy = py + l.y - l.absoluteY;
+        if (dx != 0 || dy != 0) shift(node, dx, dy);
+    }
+
+    void shift(skia::SkiaNode *n, float dx, float dy) {
+        n->layout.absoluteX += dx;
+        n->layout.absoluteY += dy;
+        if (onMoved) onMoved(n);
+        for (auto *child : n->children) shift(child, dx, dy);
+    }
+
+    /// Drag position for `translation`, resisting past the bounds like an
+    /// overscrolled ScrollEngine.
+    float bounded(const PanDriveAxis &axis, float translation, float extent) const {
+        float v = axis.start + translation;
+        float edge = axis.clamp(v);
+        if (!rubberBand || v == edge) return edge;
+        return edge + rubberBandClamp(v - edge, 0, std::max(extent, 1.0f));
+    }
+
+    void finish(PanDriveAxis &axis, float velocity, animation::AnimationTicker *ticker) {
+        if (!axis.enabled || !ticker || release == Release::None) return;
+        float from = animation::readNodeProp(node, axis.prop);
+        // Where a decay from here would come to rest
+        float projected = from + velocity / (1.0f - decayRate);
+
+        animation::Animation anim;
+        anim.node = node;
+        anim.prop = axis.prop;
+        anim.fromValue = from;
+        anim.springTension = springTension;
+        anim.springFriction = springFriction;
+        anim.springMass = springMass;
+        anim.springVelocity = velocity;
+
+        if (!axis.snapPoints.empty()) {
+            anim.driverType = animation::DriverType::Spring;
+            anim.toValue = axis.clamp(nearest(axis.snapPoints, projected));
+        } else if (release == Release::Spring) {
+            anim.driverType = animation::DriverType::Spring;
+            anim.toValue = axis.clamp(axis.hasRest ? axis.rest : axis.start);
+        } else if (axis.clamp(from) != from || axis.clamp(projected) != projected) {
+            // Released past a bound, or would coast past it — land on it
+            anim.driverType = animation::DriverType::Spring;
+            anim.toValue = axis.clamp(axis.clamp(from) != from ? from : projected);
+        } else {
+            anim.driverType = animation::DriverType::Decay;
+            anim.decayVelocity = velocity;
+            anim.decayRate = decayRate;
+        }
+        axis.animId = ticker->start(std::move(anim));
+    }
+
+    static float nearest(const std::vector<float> &points, float v) {
+        float best = points.front();
+        for (float p : points) {
+            if (std::abs(p - v) < std::abs(best - v)) best = p;
+        }
+        return best;
+    }
+};
+
+} // namespace gestures
+} // namespace zilol
@@ -3,31 +3,61 @@
  *
  * Replaces the entire TS scroll pipeline:
  *   - ScrollPhysics.ts (deceleration, rubber-band, spring, snap)
- *   - VelocityTracker.ts (rolling-window velocity estimation)
+ *   - VelocityTracker.ts (rolling-window velocity estimation,
+ *     now gestures/VelocityTracker.h)
  *   - ScrollController.ts (touch lifecycle, animation loop)
  *
  * Scroll runs entirely in C++ during vsync — JS only receives
  * an onScroll/onScrollEnd callback when the offset changes.
+ * onScroll is coalesced to at most one delivery per vsync (further
+ * limited by scrollEventThrottle) and batched across all engines into
+ * a single JS call when a batch dispatcher is registered.
  *
  * Controlled via JSI:
  *   __scrollCreate(nodeId)          → scrollEngineId
+ *   __scrollDestroy(id)             releases the engine and its callbacks
  *   __scrollTouch(id, phase, x, y, timestamp, pointerId)
  *   __scrollTo(id, x, y, animated)
  *   __scrollUpdateBounds(id, vpW, vpH, contentW, contentH)
+ *   __scrollSetItemExtents(id, extents, count?, leadingOffset?)
+ *   __scrollSetItemExtent(id, index, extent)
+ *   __scrollSetWindowCallback(id, overscan, callback)
  *   __scrollSetConfig(id, key, value)
+ *     key: horizontal | bounces | scrollEnabled | pagingEnabled |
+ *          snapToInterval | decelerationRate | velocityEstimator |
+ *          scrollEventThrottle | touchResampling | touchPrediction |
+ *          freeScroll | minimumZoomScale | maximumZoomScale | zoomScale
+ *   __scrollSetBatchDispatcher(fn)   fn([id, x, y, vx, vy, ...])
+ *   __scrollBind(id, nodeId, prop, inputRange, outputRange, extrapolate)
+ *   __scrollUnbind(id, bindingId)
+ *   __scrollSetStickyHeaders(id, childIndices)
+ *   __scrollLink(childId, parentId)  nested scrolling (parentId 0 = unlink)
  *
- * Ticked by the render loop calling ScrollEngine::tick(timestamp).
+ * Ticked by the render loop calling ScrollEngineManager::resampleDrags()
+ * with the frame time on the touch clock, then tickAll(timestamp) and
+ * flushScrollEvents(timestamp) once per frame. While dragging, raw moves
+ * are buffered and applied once per frame at the resampled position.
+ *
+ * A freeScroll engine with maximumZoomScale > minimumZoomScale pinches
+ * to zoom with a second pointer: the content scales about the midpoint
+ * of the two fingers, rubber-bands past the zoom limits and springs
+ * back on release. The scale is written to the node's zoomScale, which
+ * the renderer applies before the scroll offset.
  */
 
 #pragma once
 
 #include "skia/SkiaNodeTree.h"
+#include "gestures/VelocityTracker.h"
+#include "gestures/TouchResampler.h"
+#include "animation/NodeProps.h"
 
 #include <jsi/jsi.h>
 
 #include <cmath>
 #include <vector>
 #include <unordered_map>
+#include <set>
 #include <memory>
 #include <algorithm>
 #include <functional>
@@ -52,15 +82,23 @@ static constexpr float VELOCITY_THRESHOLD = 20.0f;
 // Rubber-band overscroll
 static constexpr float RUBBER_BAND_COEFF = 0.55f;
 
+// Nested scrolling — movement before a nested engine locks its axis (px)
+static constexpr float NESTED_TOUCH_SLOP = 8.0f;
+
 // Bounce-back spring — analytical critically-damped (NEVER diverges)
 static constexpr float SPRING_OMEGA = 20.0f; // natural frequency (rad/sec) — higher = snappier
 static constexpr float SPRING_SETTLE_THRESHOLD = 0.5f;
 static constexpr float SPRING_VELOCITY_THRESHOLD = 20.0f; // px/sec
 
-// Velocity tracking
-static constexpr float HISTORY_WINDOW_MS = 150.0f;
-static constexpr int MAX_SAMPLES = 20;
-static constexpr int MIN_SAMPLES = 3;
+// Pinch-to-zoom — rubber-banding runs on log(zoom), with this span of
+// log-zoom playing the viewport's part in rubberBandClamp
+static constexpr float ZOOM_RUBBER_BAND_EXTENT = 1.0f;
+// Zoom springs in units of 1/1000 scale, so the px-based settle
+// thresholds of springStep stop within 0.0005 of the limit
+static constexpr float ZOOM_SPRING_UNITS = 1000.0f;
+
+// Slots an engine writes into its shared values
+static constexpr int SCROLL_SHARED_SLOTS = 6;
 
 // ---------------------------------------------------------------------------
 // Helpers
@@ -70,67 +108,6 @@ inline float clampf(float v, float lo, float hi) {
     return v < lo ? lo : (v > hi ? hi : v);
 }
 
-// ---------------------------------------------------------------------------
-// VelocityTracker — weighted rolling window, output in px/sec
-// ---------------------------------------------------------------------------
-
-struct VelSample {
-    double timestamp; // ms — must be double to preserve Date.now() precision
-    float position;   // px
-};
-
-class VelocityTracker {
-public:
-    void addPoint(double timestamp, float position) {
-        if (timestamp <= lastTs_ && !samples_.empty()) return;
-        lastTs_ = timestamp;
-        samples_.push_back({timestamp, position});
-        if ((int)samples_.size() > MAX_SAMPLES) {
-            samples_.erase(samples_.begin());
-        }
-    }
-
-    /// Returns velocity in px/sec (positive = increasing position)
-    float getVelocity() {
-        pruneOld();
-        int n = (int)samples_.size();
-        if (n < MIN_SAMPLES) return 0;
-
-        auto &newest = samples_[n - 1];
-        double sumW = 0, sumWV = 0;
-
-        for (int i = 1; i < n; i++) {
-            double dt = samples_[i].timestamp - samples_[i - 1].timestamp;
-            if (dt <= 0.5) continue; // skip duplicate timestamps
-            double vel = (samples_[i].position - samples_[i - 1].position) / dt; // px/ms
-            double age = newest.timestamp - samples_[i].timestamp;
-            double weight = std::max(0.0, 1.0 - age / (double)HISTORY_WINDOW_MS);
-            weight *= weight; // quadratic falloff — recent samples matter more
-            sumW += weight;
-            sumWV += vel * weight;
-        }
-        // Convert px/ms → px/sec
-        return sumW > 0 ? (float)((sumWV / sumW) * 1000.0) : 0;
-    }
-
-    void reset() {
-        samples_.clear();
-        lastTs_ = 0.0;
-    }
-
-private:
-    std::vector<VelSample> samples_;
-    double lastTs_ = 0.0;
-
-    void pruneOld() {
-        if (samples_.empty()) return;
-        double cutoff = samples_.back().timestamp - (double)HISTORY_WINDOW_MS;
-        while (!samples_.empty() && samples_[0].timestamp < cutoff) {
-            samples_.erase(samples_.begin());
-        }
-    }
-};
-
 // ---------------------------------------------------------------------------
 // ScrollPhysics — pure stateless math
 // All velocities in px/sec, times in ms
@@ -236,6 +213,177 @@ inline float findPageTarget(
     return clampf(targetPage * viewportSize, minOff, maxOff);
 }
 
+// ---------------------------------------------------------------------------
+// ContentExtentIndex — incrementally maintained content bounds
+//
+// Tracks each child's right/bottom edge in ordered multisets so the
+// max extent is O(1) to read and O(log n) to update on child insert,
+// remove or layout change. Replaces the per-drag O(n) child scan.
+// ---------------------------------------------------------------------------
+
+class ContentExtentIndex {
+public:
+    /// Insert or update a child's extent (content-space right/bottom).
+    void set(int childId, float right, float bottom) {
+        auto it = entries_.find(childId);
+        if (it != entries_.end()) {
+            if (*it->second.right == right && *it->second.bottom == bottom) return;
+            rights_.erase(it->second.right);
+            bottoms_.erase(it->second.bottom);
+            it->second = {rights_.insert(right), bottoms_.insert(bottom)};
+            return;
+        }
+        entries_.emplace(childId, Entry{rights_.insert(right), bottoms_.insert(bottom)});
+    }
+
+    void remove(int childId) {
+        auto it = entries_.find(childId);
+        if (it == entries_.end()) return;
+        rights_.erase(it->second.right);
+        bottoms_.erase(it->second.bottom);
+        entries_.erase(it);
+    }
+
+    bool contains(int childId) const { return entries_.count(childId) > 0; }
+
+    float maxRight() const { return rights_.empty() ? 0 : std::max(0.0f, *rights_.rbegin()); }
+    float maxBottom() const { return bottoms_.empty() ? 0 : std::max(0.0f, *bottoms_.rbegin()); }
+
+    template <typename Fn>
+    void forEachChild(Fn &&fn) const {
+        for (auto &[childId, entry] : entries_) fn(childId);
+    }
+
+    void clear() {
+        entries_.clear();
+        rights_.clear();
+        bottoms_.clear();
+    }
+
+private:
+    struct Entry {
+        std::multiset<float>::iterator right;
+        std::multiset<float>::iterator bottom;
+    };
+    std::unordered_map<int, Entry> entries_;
+    std::multiset<float> rights_, bottoms_;
+};
+
+// ---------------------------------------------------------------------------
+// ItemExtentIndex — list item extents along the scroll axis
+//
+// Fenwick tree over item sizes: offsetOf(i), indexAt(offset) and
+// setExtent(i) are all O(log n). Used for native list virtualization,
+// where only a window of items is mounted but the full list length
+// defines the content size.
+// ---------------------------------------------------------------------------
+
+class ItemExtentIndex {
+public:
+    /// Reset to `count` items of equal extent.
+    void assign(int count, float extent) {
+        extents_.assign(std::max(0, count), extent);
+        rebuild();
+    }
+
+    /// Reset to explicit per-item extents.
+    void assign(std::vector<float> extents) {
+        extents_ = std::move(extents);
+        rebuild();
+    }
+
+    void setExtent(int index, float extent) {
+        if (index < 0 || index >= count()) return;
+        float delta = extent - extents_[index];
+        if (delta == 0) return;
+        extents_[index] = extent;
+        for (int i = index + 1; i <= count(); i += i & -i) tree_[i] += delta;
+        total_ += delta;
+    }
+
+    int count() const { return (int)extents_.size(); }
+    float total() const { return total_; }
+
+    /// Start offset of item `index` (sum of extents before it).
+    float offsetOf(int index) const {
+        float sum = 0;
+        for (int i = std::min(index, count()); i > 0; i -= i & -i) sum += tree_[i];
+        return sum;
+    }
+
+    /// Index of the item containing `offset` (clamped to [0, count-1]).
+    int indexAt(float offset) const {
+        int n = count();
+        if (n == 0) return -1;
+        if (offset <= 0) return 0;
+        int pos = 0;
+        float remaining = offset;
+        for (int step = highBit_; step > 0; step >>= 1) {
+            int next = pos + step;
+            if (next <= n && tree_[next] <= remaining) {
+                pos = next;
+                remaining -= tree_[next];
+            }
+        }
+        return std::min(pos, n - 1);
+    }
+
+private:
+    std::vector<float> extents_;
+    std::vector<float> tree_; // 1-based Fenwick tree
+    float total_ = 0;
+    int highBit_ = 0;
+
+    void rebuild() {
+        int n = count();
+        tree_.assign(n + 1, 0.0f);
+        total_ = 0;
+        for (int i = 1; i <= n; i++) {
+            tree_[i] += extents_[i - 1];
+            total_ += extents_[i - 1];
+            int parent = i + (i & -i);
+            if (parent <= n) tree_[parent] += tree_[i];
+        }
+        highBit_ = 1;
+        while (highBit_ * 2 <= n) highBit_ *= 2;
+        if (n == 0) highBit_ = 0;
+    }
+};
+
+/// Inclusive item index range. Empty when first > last.
+struct IndexRange {
+    int first = 0;
+    int last = -1;
+    bool empty() const { return first > last; }
+    bool operator==(const IndexRange &o) const {
+        return (empty() && o.empty()) || (first == o.first && last == o.last);
+    }
+    bool operator!=(const IndexRange &o) const { return !(*this == o); }
+};
+
+// ---------------------------------------------------------------------------
+// ScrollBinding — scroll offset → node prop (parallax, collapsing headers)
+// ---------------------------------------------------------------------------
+
+struct ScrollBinding {
+    int id = 0;
+    skia::SkiaNode *node = nullptr;
+    animation::PropId prop = animation::PropId::Unknown;
+    std::vector<float> inputRange;  // scroll offset along the engine axis
+    std::vector<float> outputRange; // prop value
+    animation::Extrapolate extrapolate = animation::Extrapolate::Extend;
+};
+
+// ---------------------------------------------------------------------------
+// StickyHeader — child pinned to the viewport's leading edge
+// ---------------------------------------------------------------------------
+
+struct StickyHeader {
+    skia::SkiaNode *node = nullptr;
+    float naturalPos = 0;   // layout position along the scroll axis (unpinned)
+    float translation = 0;  // current pin offset added to naturalPos
+};
+
 // ---------------------------------------------------------------------------
 // ScrollEngine — per-node scroll controller
 // ---------------------------------------------------------------------------
@@ -244,6 +392,13 @@ enum class ScrollPhase : uint8_t {
     Idle, Dragging, Decelerating, Bouncing, Snapping
 };
 
+/// Which engine in a nested chain owns the current drag.
+enum class NestedAxisLock : uint8_t {
+    Undecided, // inside touch slop, nothing moves yet
+    Self,      // this engine scrolls; overscroll chains to same-axis ancestor
+    Parent     // drag is cross-axis — handed to the parent
+};
+
 class ScrollEngine {
 public:
     int id = 0;
@@ -256,199 +411,797 @@ public:
     bool pagingEnabled = false;
     float snapInterval = 0;
     float decelerationRate = DECELERATION_RATE_NORMAL;
+    float scrollEventThrottle = 0; // min ms between onScroll deliveries (0 = every frame)
+    bool touchResampling = true;   // apply drags once per frame (resampleDrag)
+    bool freeScroll = false;       // scroll both axes together (ignores horizontal)
+    float minZoom = 1, maxZoom = 1; // pinch-to-zoom limits (freeScroll only)
+    float touchPredictionMs = 0;   // ≤ TOUCH_MAX_PREDICTION_MS ahead of the frame
 
     // JS callbacks (set from JS via config)
-    // These are invoked via the runtime's microtask queue
-    std::function<void(float, float)> onScrollCallback;
+    // onScroll/onScrollEnd are deferred to ScrollEngineManager::flushScrollEvents
+    std::function<void(float, float, float, float)> onScrollCallback; // x, y, vx, vy
     std::function<void(float, float)> onScrollEndCallback;
-    std::function<void()> onScrollBeginDragCallback;
-    std::function<void()> onScrollEndDragCallback;
+
+    // Shared value slots (animation/SharedValues.h), written on every
+    // offset commit, tick and phase change: offsetX, offsetY, velocityX,
+    // velocityY, phase, zoomScale
+    float *sharedSlots = nullptr;
+    // Virtualized list: fired only when the rendered window changes.
+    // (window, entered ranges, left ranges)
+    std::function<void(IndexRange, const std::vector<IndexRange> &,
+                       const std::vector<IndexRange> &)> onWindowChangeCallback;
 
     // State
     ScrollPhase phase = ScrollPhase::Idle;
     float offsetX = 0, offsetY = 0;
     float velocityX = 0, velocityY = 0;
     float snapTargetX = 0, snapTargetY = 0;
+    bool springX = false, springY = false; // free scroll: axis springing back
     double lastTimestamp = 0;
 
-    // Bounds
+    // Zoom — content is drawn scaled by zoomScale about the viewport
+    // origin, then offset by the (scaled) scroll offset
+    float zoomScale = 1;
+    float zoomVelocity = 0;       // scale per sec
+    float focalX = 0, focalY = 0; // viewport point the zoom is anchored to
+
+    // Bounds (content unscaled)
     float viewportW = 0, viewportH = 0;
     float contentW = 0, contentH = 0;
 
+    // Content extents of the bound node's children (kept incrementally)
+    ContentExtentIndex extents;
+
+    // Virtualized list items along the scroll axis
+    ItemExtentIndex items;
+    float itemsLeadingOffset = 0; // content before the first item (header)
+    int overscan = 5;             // extra items rendered on each side
+    IndexRange renderedWindow;
+    IndexRange deliveredWindow;   // last window JS was told about
+
+    // Scroll-linked prop bindings, evaluated natively on every commit
+    std::vector<ScrollBinding> bindings;
+
+    // Sticky headers, ordered by natural position
+    std::vector<StickyHeader> stickyHeaders;
+
+    // Coalesced scroll events — drained once per vsync by the manager
+    bool scrollEventPending = false;
+    bool scrollEndPending = false;
+    bool windowPending = false;
+    bool eventQueued = false;
+    double lastScrollEventTs = 0;
+    std::vector<ScrollEngine *> *eventQueue = nullptr;
+
+    // Active set — intrusive slot in the manager's list of non-idle
+    // engines, maintained on phase transitions (see setPhase)
+    std::vector<ScrollEngine *> *activeList = nullptr;
+    int activeSlot = -1;
+
     // Touch tracking
     VelocityTracker trackerX, trackerY;
+    TouchResampler resampler;
+    double lastResampleTime = 0;
     float lastTouchX = 0, lastTouchY = 0;
     int activePointerId = -1;
 
+    // Pinch — the second pointer of a zooming drag; index 0 of the
+    // positions is activePointerId, index 1 pinchPointerId
+    int pinchPointerId = -1;
+    float pinchX[2] = {0, 0}, pinchY[2] = {0, 0};
+    float pinchDistance = 0;
+
+    // Nested scrolling — a child resolves the whole chain for a touch
+    ScrollEngine *parent = nullptr;
+    std::vector<ScrollEngine *> nestedChildren;
+    int delegatedPointerId = -1; // pointer claimed by a nested child
+    float touchSlop = NESTED_TOUCH_SLOP;
+    NestedAxisLock axisLock = NestedAxisLock::Self;
+    float dragStartX = 0, dragStartY = 0;
+    bool chainedThisDrag = false; // an ancestor consumed overscroll
+
     // ── Touch API ─────────────────────────────────────────────
+    //
+    // A pointer claimed by a nested child (delegatedPointerId) is ignored
+    // here: the child forwards whatever this engine should do, so a
+    // bubbled event never moves two engines.
 
     bool onTouchBegan(int pointerId, float x, float y, double timestamp) {
+        if (pointerId == delegatedPointerId) return false;
+        if (pinchPointerId >= 0) return false; // two fingers are enough
+        if (canPinch() && pointerId != activePointerId) {
+            beginPinch(pointerId, x, y);
+            return true;
+        }
+        if (!beginDrag(pointerId, x, y, timestamp)) return false;
+        for (auto *p = parent; p; p = p->parent) {
+            p->cancelAnimation(); // touching the child catches a parent fling
+            p->delegatedPointerId = pointerId;
+        }
+        return true;
+    }
+
+    void onTouchMoved(int pointerId, float x, float y, double timestamp) {
+        if (pointerId == delegatedPointerId) return;
+        if (pinchPointerId >= 0) { pinchMove(pointerId, x, y); return; }
+        dragMove(pointerId, x, y, timestamp);
+    }
+
+    void onTouchEnded(int pointerId, double timestamp) {
+        if (pointerId == delegatedPointerId) return;
+        if (isPinchPointer(pointerId)) { endPinch(pointerId, timestamp); return; }
+        bool wasOwner = pointerId == activePointerId;
+        dragEnd(pointerId, timestamp);
+        if (wasOwner) releaseDelegation(pointerId);
+    }
+
+    void onTouchCancelled(int pointerId) {
+        if (pointerId == delegatedPointerId) return;
+        if (isPinchPointer(pointerId)) {
+            // One finger cancelled cancels the whole gesture
+            pinchPointerId = -1;
+            pointerId = activePointerId;
+        }
+        bool wasOwner = pointerId == activePointerId;
+        dragCancel(pointerId);
+        if (wasOwner) releaseDelegation(pointerId);
+    }
+    // ── Programmatic scroll ───────────────────────────────────
+
+    void scrollTo(float x, float y, bool animated) {
+        cancelAnimation();
+        updateBoundsFromNode();
+        float tx = clampf(x, 0, maxScrollX());
+        float ty = clampf(y, 0, maxScrollY());
+
+        if (!animated) {
+            offsetX = tx; offsetY = ty;
+            commitOffset();
+            fireScrollEnd();
+            return;
+        }
+        snapTargetX = tx; snapTargetY = ty;
+        velocityX = 0; velocityY = 0;
+        setPhase(ScrollPhase::Snapping);
+        lastTimestamp = 0;
+    }
+
+    /// Set the zoom (clamped to the limits) about the viewport center.
+    void zoomTo(float scale) {
+        cancelAnimation();
+        updateBoundsFromNode();
+        zoomVelocity = 0;
+        zoomAround(clampf(scale, minZoom, maxZoom), viewportW / 2, viewportH / 2);
+        offsetX = clampf(offsetX, 0, maxScrollX());
+        offsetY = clampf(offsetY, 0, maxScrollY());
+        commitOffset();
+        fireScrollEnd();
+    }
+
+    // ── Frame tick (called from render loop) ──────────────────
+
+    /// All phase changes go through here so the manager's active list
+    /// stays exact: O(1) insert on leaving Idle, swap-remove on return.
+    void setPhase(ScrollPhase next) {
+        bool changed = next != phase;
+        phase = next;
+        if (changed) publishShared(); // drag begin/end show in the phase slot
+        bool active = next != ScrollPhase::Idle;
+        if (!activeList || active == (activeSlot >= 0)) return;
+        if (active) {
+            activeSlot = static_cast<int>(activeList->size());
+            activeList->push_back(this);
+        } else {
+            auto *last = activeList->back();
+            (*activeList)[activeSlot] = last;
+            last->activeSlot = activeSlot;
+            activeList->pop_back();
+            activeSlot = -1;
+        }
+    }
+
+    bool needsTick() const {
+        return phase != ScrollPhase::Idle && phase != ScrollPhase::Dragging;
+    }
+
+    void tick(double timestamp) {
+        if (!needsTick()) return;
+
+        float dt = lastTimestamp > 0
+            ? (float)std::min(timestamp - lastTimestamp, 32.0)
+            : 16.67f;
+        lastTimestamp = timestamp;
+
+        float maxX = maxScrollX(), maxY = maxScrollY();
+        bool finished = false;
+
+        switch (phase) {
+            case ScrollPhase::Decelerating:
+                finished = stepDeceleration(dt, maxX, maxY);
+                break;
+            case ScrollPhase::Bouncing:
+                finished = stepBounce(dt, maxX, maxY);
+                break;
+            case ScrollPhase::Snapping:
+                finished = stepSnap(dt);
+                break;
+            default:
+                return;
+        }
+
+        commitOffset();
+
+        if (finished) {
+            setPhase(ScrollPhase::Idle);
+            lastTimestamp = 0;
+            fireScrollEnd();
+        }
+    }
+
+    void cancelAnimation() {
+        setPhase(ScrollPhase::Idle);
+        zoomVelocity = 0;
+        lastTimestamp = 0;
+    }
+
+    /// Record a child's current layout in the extent index.
+    void updateChildExtent(skia::SkiaNode *child) {
+        extents.set(child->id,
+                    child->layout.x + child->layout.width,
+                    child->layout.y + child->layout.height);
+    }
+
+    /// Rebuild the extent index from the node's children. O(n) — only
+    /// used once when the engine is bound.
+    void seedExtentsFromNode() {
+        extents.clear();
+        if (!node) return;
+        for (auto *child : node->children) updateChildExtent(child);
+    }
+
+    // ── Touch resampling ──────────────────────────────────────
+
+    /// Apply the drag at the pointer position resampled to `frameTime`
+    /// (touch clock, ms). Called once per frame by the manager so every
+    /// frame moves by one consistent step instead of 0..n raw samples.
+    void resampleDrag(double frameTime) {
+        if (phase != ScrollPhase::Dragging || !touchResampling) return;
+        if (axisLock != NestedAxisLock::Self || pinchPointerId >= 0) return;
+
+        double prediction = clampf(touchPredictionMs, 0, (float)TOUCH_MAX_PREDICTION_MS);
+        double sampleTime = frameTime - TOUCH_RESAMPLE_LATENCY_MS + prediction;
+        if (sampleTime <= lastResampleTime) return;
+        lastResampleTime = sampleTime;
+
+        float x, y;
+        if (resampler.sampleAt(sampleTime, x, y)) applyDragTo(x, y);
+    }
+
+    // ── Nested scrolling ──────────────────────────────────────
+
+    void linkParent(ScrollEngine *p) {
+        unlinkParent();
+        for (auto *a = p; a; a = a->parent) {
+            if (a == this) return; // would create a cycle
+        }
+        parent = p;
+        if (p) p->nestedChildren.push_back(this);
+    }
+
+    void unlinkParent() {
+        if (!parent) return;
+        auto &siblings = parent->nestedChildren;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+        parent = nullptr;
+    }
+
+    /// The parent engine is being destroyed. A drag that was forwarded to
+    /// it ends here; an undecided one falls back to this engine.
+    void onParentRemoved() {
+        parent = nullptr;
+        if (axisLock != NestedAxisLock::Parent) return;
+        axisLock = NestedAxisLock::Self;
+        activePointerId = -1;
+        setPhase(ScrollPhase::Idle);
+    }
+
+    /// Consume as much of `delta` (along this engine's axis) as fits in
+    /// bounds, chaining the rest upward. Returns the unconsumed delta.
+    float consumeNestedDelta(float delta) {
+        if (!scrollEnabled) return delta;
+        updateBoundsFromNode();
+        float cur = horizontal ? offsetX : offsetY;
+        float next = clampf(cur + delta, 0, horizontal ? maxScrollX() : maxScrollY());
+        float leftover = delta - (next - cur);
+        if (next != cur) {
+            if (horizontal) offsetX = next; else offsetY = next;
+            commitOffset();
+        }
+        auto *up = chainParent();
+        return (leftover != 0 && up) ? up->consumeNestedDelta(leftover) : leftover;
+    }
+
+    /// Take over fling velocity handed off by a nested child.
+    void startNestedFling(float velocity) {
+        updateBoundsFromNode();
+        if (horizontal) velocityX = velocity; else velocityY = velocity;
+        if (pagingEnabled) { startSnap(true); return; }
+        if (snapInterval > 0) { startSnap(false); return; }
+        startDeceleration();
+    }
+
+    /// Nearest ancestor scrolling along the same axis (overscroll chain).
+    ScrollEngine *chainParent() const {
+        for (auto *p = parent; p; p = p->parent) {
+            if (p->horizontal == horizontal && p->scrollEnabled) return p;
+        }
+        return nullptr;
+    }
+
+    /// Can this engine (or a same-axis ancestor) still scroll in the
+    /// direction of `delta` without overscrolling?
+    bool canConsume(float delta) {
+        updateBoundsFromNode();
+        float cur = horizontal ? offsetX : offsetY;
+        float maxOff = horizontal ? maxScrollX() : maxScrollY();
+        if ((delta < 0 && cur > 0) || (delta > 0 && cur < maxOff)) return true;
+        auto *up = chainParent();
+        return up && up->canConsume(delta);
+    }
+
+    // ── Virtualization ────────────────────────────────────────
+
+    /// Recompute the visible item window (+overscan) for the current
+    /// offset. A change is only recorded here: with a manager it reaches
+    /// JS from flushScrollEvents, never from inside a tick or a move.
+    void updateRenderedWindow() {
+        if (!onWindowChangeCallback) return;
+
+        IndexRange next;
+        if (items.count() > 0) {
+            float offset = (horizontal ? offsetX : offsetY) - itemsLeadingOffset;
+            float viewport = horizontal ? viewportW : viewportH;
+            int first = items.indexAt(offset);
+            int last = items.indexAt(offset + viewport);
+            next.first = std::max(0, first - overscan);
+            next.last = std::min(items.count() - 1, last + overscan);
+        }
+        if (next == renderedWindow) return;
+        renderedWindow = next;
+
+        if (eventQueue) {
+            windowPending = true;
+            queueEvent();
+        } else {
+            deliverWindow();
+        }
+    }
+
+    /// Report the rendered window to JS if it differs from the last one
+    /// reported. The callback may destroy this engine: nothing touches
+    /// `this` after it.
+    void deliverWindow() {
+        windowPending = false;
+        if (!onWindowChangeCallback || renderedWindow == deliveredWindow) return;
+        std::vector<IndexRange> entered, left;
+        diffRanges(renderedWindow, deliveredWindow, entered);
+        diffRanges(deliveredWindow, renderedWindow, left);
+        deliveredWindow = renderedWindow;
+        auto callback = onWindowChangeCallback;
+        callback(deliveredWindow, entered, left);
+    }
+
+    void resetRenderedWindow() {
+        renderedWindow = IndexRange{};
+        deliveredWindow = IndexRange{};
+        updateRenderedWindow();
+    }
+
+    // ── Scroll-linked bindings ────────────────────────────────
+
+    void addBinding(ScrollBinding binding) {
+        applyBinding(binding);
+        bindings.push_back(std::move(binding));
+    }
+
+    void removeBinding(int bindingId) {
+        bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+            [bindingId](const ScrollBinding &b) { return b.id == bindingId; }),
+            bindings.end());
+    }
+
+    void applyBindings() {
+        for (auto &b : bindings) applyBinding(b);
+    }
+
+    /// Drop bindings whose target is `subtree` or one of its descendants.
+    void removeBindingsUnder(const skia::SkiaNode *subtree) {
+        bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+            [subtree](const ScrollBinding &b) {
+                for (auto *n = b.node; n; n = n->parent) {
+                    if (n == subtree) return true;
+                }
+                return false;
+            }),
+            bindings.end());
+    }
+
+    // ── Sticky headers ────────────────────────────────────────
+
+    /// Pin the children at `indices`. Positions are captured from the
+    /// current layout; re-send after the children change.
+    void setStickyHeaders(const std::vector<int> &indices) {
+        clearStickyHeaders();
+        if (!node) return;
+        for (int idx : indices) {
+            if (idx < 0 || idx >= (int)node->children.size()) continue;
+            auto *child = node->children[idx];
+            stickyHeaders.push_back({child, axisPos(child), 0});
+        }
+        std::sort(stickyHeaders.begin(), stickyHeaders.end(),
+            [](const StickyHeader &a, const StickyHeader &b) {
+                return a.naturalPos < b.naturalPos;
+            });
+        updateStickyHeaders();
+    }
+
+    void clearStickyHeaders() {
+        for (auto &h : stickyHeaders) {
+            if (h.translation != 0) setAxisPos(h.node, h.naturalPos);
+        }
+        stickyHeaders.clear();
+    }
+
+    /// Pin translation of `child` along the scroll axis (0 if not pinned).
+    float stickyTranslationOf(const skia::SkiaNode *child) const {
+        for (auto &h : stickyHeaders) {
+            if (h.node == child) return h.translation;
+        }
+        return 0;
+    }
+
+    /// A sticky header's layout was reset by Yoga — recapture its
+    /// natural position and re-pin.
+    void onStickyHeaderLayout(skia::SkiaNode *child) {
+        for (auto &h : stickyHeaders) {
+            if (h.node != child) continue;
+            h.naturalPos = axisPos(child);
+            h.translation = 0;
+            updateStickyHeaders();
+            return;
+        }
+    }
+
+    void removeStickyHeader(skia::SkiaNode *child) {
+        for (auto &h : stickyHeaders) {
+            if (h.node == child && h.translation != 0) setAxisPos(child, h.naturalPos);
+        }
+        stickyHeaders.erase(std::remove_if(stickyHeaders.begin(), stickyHeaders.end(),
+            [child](const StickyHeader &h) { return h.node == child; }),
+            stickyHeaders.end());
+    }
+
+    /// Velocity reported with onScroll: live tracker estimate while
+    /// dragging, physics velocity otherwise (px/sec).
+    float reportedVelocityX() { return phase == ScrollPhase::Dragging ? -trackerX.getVelocity() : velocityX; }
+    float reportedVelocityY() { return phase == ScrollPhase::Dragging ? -trackerY.getVelocity() : velocityY; }
+
+    void publishShared() {
+        if (!sharedSlots) return;
+        sharedSlots[0] = offsetX;
+        sharedSlots[1] = offsetY;
+        sharedSlots[2] = reportedVelocityX();
+        sharedSlots[3] = reportedVelocityY();
+        sharedSlots[4] = static_cast<float>(phase);
+        sharedSlots[5] = zoomScale;
+    }
+
+    void queueEvent() {
+        if (eventQueued || !eventQueue) return;
+        eventQueued = true;
+        eventQueue->push_back(this);
+    }
+
+    void setVelocityEstimator(VelocityEstimator estimator) {
+        trackerX.estimator = estimator;
+        trackerY.estimator = estimator;
+    }
+
+    void updateBounds(float vpW, float vpH, float cW, float cH) {
+        viewportW = vpW; viewportH = vpH;
+        contentW = cW; contentH = cH;
+    }
+
+    /// O(1): viewport from the node's layout, content from the extent index.
+    void updateBoundsFromNode() {
+        if (!node) return;
+        viewportW = node->layout.width;
+        viewportH = node->layout.height;
+        contentW = extents.maxRight();
+        contentH = extents.maxBottom();
+        // Virtualized lists mount only a window of items — the full
+        // list length comes from the item extent index.
+        if (items.count() > 0) {
+            float listEnd = itemsLeadingOffset + items.total();
+            if (horizontal) contentW = std::max(contentW, listEnd);
+            else contentH = std::max(contentH, listEnd);
+        }
+    }
+
+private:
+    // ── Drag lifecycle (also driven by nested children) ───────
+
+    bool beginDrag(int pointerId, float x, float y, double timestamp) {
         if (!scrollEnabled) return false;
         cancelAnimation();
 
-        phase = ScrollPhase::Dragging;
+        setPhase(ScrollPhase::Dragging);
         activePointerId = pointerId;
         lastTouchX = x;
         lastTouchY = y;
+        dragStartX = x;
+        dragStartY = y;
+        axisLock = parent && !freeScroll ? NestedAxisLock::Undecided : NestedAxisLock::Self;
+        chainedThisDrag = false;
 
         trackerX.reset();
         trackerY.reset();
         trackerX.addPoint(timestamp, x);
         trackerY.addPoint(timestamp, y);
+        resampler.reset();
+        resampler.addSample(timestamp, x, y);
+        lastResampleTime = 0;
 
         updateBoundsFromNode();
-
-        if (onScrollBeginDragCallback) onScrollBeginDragCallback();
         return true;
     }
 
-    void onTouchMoved(int pointerId, float x, float y, double timestamp) {
+    void dragMove(int pointerId, float x, float y, double timestamp) {
         if (phase != ScrollPhase::Dragging) return;
         if (pointerId != activePointerId) return;
 
         trackerX.addPoint(timestamp, x);
         trackerY.addPoint(timestamp, y);
+        resampler.addSample(timestamp, x, y);
+
+        if (axisLock == NestedAxisLock::Undecided) {
+            float tx = x - dragStartX, ty = y - dragStartY;
+            float dist2 = tx * tx + ty * ty;
+            if (dist2 < touchSlop * touchSlop) return;
+            // Track from where the touch left the slop circle, so the slop
+            // itself is never applied as one jump on the first move
+            float k = dist2 > 0 ? touchSlop / std::sqrt(dist2) : 0.0f;
+            float fromX = dragStartX + tx * k, fromY = dragStartY + ty * k;
+            bool alongX = std::abs(tx) > std::abs(ty);
+            if (alongX == horizontal || !parent) {
+                axisLock = NestedAxisLock::Self;
+                lastTouchX = fromX;
+                lastTouchY = fromY;
+            } else {
+                // Cross-axis drag — hand the pointer to the parent, which
+                // may in turn lock or hand off further up the chain.
+                axisLock = NestedAxisLock::Parent;
+                parent->beginDrag(pointerId, fromX, fromY, timestamp);
+            }
+        }
+        if (axisLock == NestedAxisLock::Parent) {
+            parent->dragMove(pointerId, x, y, timestamp);
+            return;
+        }
+        if (!touchResampling) applyDragTo(x, y);
+    }
 
+    /// Move the content so the touch point follows the finger at (x, y).
+    void applyDragTo(float x, float y) {
         float dx = x - lastTouchX;
         float dy = y - lastTouchY;
         lastTouchX = x;
         lastTouchY = y;
 
-        float maxX = maxScrollX(), maxY = maxScrollY();
+        if (freeScroll) {
+            offsetX = applyDelta(offsetX, -dx, 0, maxScrollX(), viewportW);
+            offsetY = applyDelta(offsetY, -dy, 0, maxScrollY(), viewportH);
+            commitOffset();
+            return;
+        }
 
-        if (horizontal) {
-            offsetX = applyDelta(offsetX, -dx, 0, maxX, viewportW);
+        float delta = horizontal ? -dx : -dy;
+        float maxOff = horizontal ? maxScrollX() : maxScrollY();
+        float vpSize = horizontal ? viewportW : viewportH;
+        float cur = horizontal ? offsetX : offsetY;
+        float next = cur + delta;
+
+        // Overscroll chaining: past our edge, a same-axis ancestor consumes
+        // the excess first; only what it cannot take rubber-bands here.
+        auto *up = chainParent();
+        if (up && cur >= 0 && cur <= maxOff && (next < 0 || next > maxOff)) {
+            float edge = clampf(next, 0, maxOff);
+            float leftover = up->consumeNestedDelta(next - edge);
+            if (leftover != next - edge) chainedThisDrag = true;
+            next = leftover != 0 ? applyDelta(edge, leftover, 0, maxOff, vpSize) : edge;
         } else {
-            offsetY = applyDelta(offsetY, -dy, 0, maxY, viewportH);
+            next = applyDelta(cur, delta, 0, maxOff, vpSize);
         }
+        if (horizontal) offsetX = next; else offsetY = next;
         commitOffset();
     }
 
-    void onTouchEnded(int pointerId, double /*timestamp*/) {
+    void dragEnd(int pointerId, double timestamp) {
         if (phase != ScrollPhase::Dragging) return;
         if (pointerId != activePointerId) return;
         activePointerId = -1;
 
-        if (onScrollEndDragCallback) onScrollEndDragCallback();
+        if (axisLock == NestedAxisLock::Parent) {
+            parent->dragEnd(pointerId, timestamp);
+            setPhase(ScrollPhase::Idle);
+            return;
+        }
+        if (axisLock == NestedAxisLock::Undecided) {
+            setPhase(ScrollPhase::Idle); // never left the touch slop
+            return;
+        }
+
+        // Catch up to the final raw position before releasing
+        if (touchResampling && resampler.size() > 0) {
+            applyDragTo(resampler.newest().x, resampler.newest().y);
+        }
 
         velocityX = -trackerX.getVelocity();
         velocityY = -trackerY.getVelocity();
 
-        float maxX = maxScrollX(), maxY = maxScrollY();
+        if (needsBounce()) { startBounce(); return; }
+        if (freeScroll) { startDeceleration(); return; }
 
-        if (horizontal && isOverscrolled(offsetX, 0, maxX)) {
-            startBounce(); return;
-        }
-        if (!horizontal && isOverscrolled(offsetY, 0, maxY)) {
-            startBounce(); return;
+        // The drag moved an ancestor — it owns the release (e.g. a bottom
+        // sheet settling to a detent), this engine stays at its edge.
+        auto *up = chainParent();
+        if (chainedThisDrag && up) {
+            float vel = horizontal ? velocityX : velocityY;
+            velocityX = velocityY = 0;
+            setPhase(ScrollPhase::Idle);
+            fireScrollEnd();
+            up->startNestedFling(vel);
+            return;
         }
+
         if (pagingEnabled) { startSnap(true); return; }
         if (snapInterval > 0) { startSnap(false); return; }
         startDeceleration();
     }
 
-    void onTouchCancelled(int pointerId) {
+    void dragCancel(int pointerId) {
         if (pointerId != activePointerId) return;
         activePointerId = -1;
-        float maxX = maxScrollX(), maxY = maxScrollY();
-        if ((horizontal && isOverscrolled(offsetX, 0, maxX)) ||
-            (!horizontal && isOverscrolled(offsetY, 0, maxY))) {
+        if (axisLock == NestedAxisLock::Parent) {
+            parent->dragCancel(pointerId);
+            setPhase(ScrollPhase::Idle);
+            return;
+        }
+        if (needsBounce()) {
+            velocityX = velocityY = 0;
             startBounce();
         } else {
-            phase = ScrollPhase::Idle;
+            setPhase(ScrollPhase::Idle);
         }
     }
 
-    // ── Programmatic scroll ───────────────────────────────────
-
-    void scrollTo(float x, float y, bool animated) {
-        cancelAnimation();
-        updateBoundsFromNode();
-        float tx = clampf(x, 0, maxScrollX());
-        float ty = clampf(y, 0, maxScrollY());
-
-        if (!animated) {
-            offsetX = tx; offsetY = ty;
-            commitOffset();
-            fireScrollEnd();
-            return;
-        }
-        snapTargetX = tx; snapTargetY = ty;
-        velocityX = 0; velocityY = 0;
-        phase = ScrollPhase::Snapping;
-        lastTimestamp = 0;
+    /// Released past an edge on a scrolling axis, or past a zoom limit?
+    bool needsBounce() {
+        float maxX = maxScrollX(), maxY = maxScrollY();
+        bool overX = isOverscrolled(offsetX, 0, maxX);
+        bool overY = isOverscrolled(offsetY, 0, maxY);
+        if (freeScroll) return overX || overY || isOverscrolled(zoomScale, minZoom, maxZoom);
+        return horizontal ? overX : overY;
     }
 
-    // ── Frame tick (called from render loop) ──────────────────
+    // ── Pinch-to-zoom ─────────────────────────────────────────
 
-    bool needsTick() const {
-        return phase != ScrollPhase::Idle && phase != ScrollPhase::Dragging;
+    /// A second pointer may join a free-scroll drag to pinch.
+    bool canPinch() const {
+        return freeScroll && maxZoom > minZoom && phase == ScrollPhase::Dragging &&
+               axisLock == NestedAxisLock::Self && activePointerId >= 0;
     }
 
-    void tick(double timestamp) {
-        if (!needsTick()) return;
-
-        float dt = lastTimestamp > 0
-            ? (float)std::min(timestamp - lastTimestamp, 32.0)
-            : 16.67f;
-        lastTimestamp = timestamp;
+    bool isPinchPointer(int pointerId) const {
+        return pinchPointerId >= 0 &&
+               (pointerId == pinchPointerId || pointerId == activePointerId);
+    }
 
-        float maxX = maxScrollX(), maxY = maxScrollY();
-        bool finished = false;
+    void beginPinch(int pointerId, float x, float y) {
+        // Catch up to where the first finger is now
+        if (touchResampling && resampler.size() > 0) applyDragTo(resampler.newest().x, resampler.newest().y);
+        pinchPointerId = pointerId;
+        pinchX[0] = lastTouchX; pinchY[0] = lastTouchY;
+        pinchX[1] = x; pinchY[1] = y;
+        pinchDistance = std::hypot(pinchX[1] - pinchX[0], pinchY[1] - pinchY[0]);
+        focalX = (pinchX[0] + pinchX[1]) / 2;
+        focalY = (pinchY[0] + pinchY[1]) / 2;
+    }
 
-        switch (phase) {
-            case ScrollPhase::Decelerating:
-                finished = stepDeceleration(dt, maxX, maxY);
-                break;
-            case ScrollPhase::Bouncing:
-                finished = stepBounce(dt, maxX, maxY);
-                break;
-            case ScrollPhase::Snapping:
-                finished = stepSnap(dt);
-                break;
-            default:
-                return;
+    /// Scale by the change in finger distance about the previous focal
+    /// point, then pan by the focal point's movement. Applied per move:
+    /// a pinch is not resampled.
+    void pinchMove(int pointerId, float x, float y) {
+        int i = pointerId == activePointerId ? 0 : pointerId == pinchPointerId ? 1 : -1;
+        if (i < 0) return;
+        pinchX[i] = x; pinchY[i] = y;
+
+        float distance = std::hypot(pinchX[1] - pinchX[0], pinchY[1] - pinchY[0]);
+        if (distance > 0 && pinchDistance > 0) {
+            float logZoom = applyDelta(std::log(zoomScale), std::log(distance / pinchDistance),
+                                       std::log(minZoom), std::log(maxZoom),
+                                       ZOOM_RUBBER_BAND_EXTENT);
+            zoomAround(std::exp(logZoom), focalX, focalY);
         }
+        pinchDistance = distance;
 
+        float fx = (pinchX[0] + pinchX[1]) / 2, fy = (pinchY[0] + pinchY[1]) / 2;
+        offsetX = applyDelta(offsetX, focalX - fx, 0, maxScrollX(), viewportW);
+        offsetY = applyDelta(offsetY, focalY - fy, 0, maxScrollY(), viewportH);
+        focalX = fx; focalY = fy;
         commitOffset();
+    }
 
-        if (finished) {
-            phase = ScrollPhase::Idle;
-            lastTimestamp = 0;
-            fireScrollEnd();
+    /// One finger lifted: the other carries on as a plain drag, with
+    /// fresh velocity tracking so the pinch is not read as a fling.
+    void endPinch(int pointerId, double timestamp) {
+        int keep = pointerId == activePointerId ? 1 : 0;
+        if (keep == 1) {
+            releaseDelegation(activePointerId);
+            for (auto *p = parent; p; p = p->parent) p->delegatedPointerId = pinchPointerId;
+            activePointerId = pinchPointerId;
         }
+        pinchPointerId = -1;
+        lastTouchX = pinchX[keep];
+        lastTouchY = pinchY[keep];
+        trackerX.reset();
+        trackerY.reset();
+        trackerX.addPoint(timestamp, lastTouchX);
+        trackerY.addPoint(timestamp, lastTouchY);
+        resampler.reset();
+        resampler.addSample(timestamp, lastTouchX, lastTouchY);
+        lastResampleTime = 0;
     }
 
-    void cancelAnimation() {
-        phase = ScrollPhase::Idle;
-        lastTimestamp = 0;
+    /// Set the zoom keeping the content under viewport point (fx, fy) fixed.
+    void zoomAround(float scale, float fx, float fy) {
+        float k = scale / zoomScale;
+        offsetX = (offsetX + fx) * k - fx;
+        offsetY = (offsetY + fy) * k - fy;
+        zoomScale = scale;
     }
 
-    void updateBounds(float vpW, float vpH, float cW, float cH) {
-        viewportW = vpW; viewportH = vpH;
-        contentW = cW; contentH = cH;
+    void releaseDelegation(int pointerId) {
+        for (auto *p = parent; p; p = p->parent) {
+            if (p->delegatedPointerId == pointerId) p->delegatedPointerId = -1;
+        }
     }
 
-private:
     // ── Physics steps ─────────────────────────────────────────
 
     void startDeceleration() {
-        float vel = horizontal ? velocityX : velocityY;
+        float vel = freeScroll ? std::hypot(velocityX, velocityY)
+                               : (horizontal ? velocityX : velocityY);
         if (std::abs(vel) < VELOCITY_THRESHOLD) {
-            phase = ScrollPhase::Idle;
+            setPhase(ScrollPhase::Idle);
             fireScrollEnd();
             return;
         }
-        phase = ScrollPhase::Decelerating;
+        springX = springY = false;
+        setPhase(ScrollPhase::Decelerating);
         lastTimestamp = 0;
     }
 
     bool stepDeceleration(float dt, float maxX, float maxY) {
+        if (freeScroll) return stepFree(dt);
         if (horizontal) {
             auto s = decelerationStep(offsetX, velocityX, dt, decelerationRate, 0, maxX);
             offsetX = s.offset; velocityX = s.velocity;
             if (s.finished) {
-                if (isOverscrolled(offsetX, 0, maxX)) { startBounce(); return false; }
+                if (isOverscrolled(offsetX, 0, maxX)) {
+                    if (handOffFling(offsetX, velocityX, maxX)) return true;
+                    startBounce(); return false;
+                }
                 if (snapInterval > 0) { startSnap(false); return false; }
                 return true;
             }
@@ -456,7 +1209,10 @@ private:
             auto s = decelerationStep(offsetY, velocityY, dt, decelerationRate, 0, maxY);
             offsetY = s.offset; velocityY = s.velocity;
             if (s.finished) {
-                if (isOverscrolled(offsetY, 0, maxY)) { startBounce(); return false; }
+                if (isOverscrolled(offsetY, 0, maxY)) {
+                    if (handOffFling(offsetY, velocityY, maxY)) return true;
+                    startBounce(); return false;
+                }
                 if (snapInterval > 0) { startSnap(false); return false; }
                 return true;
             }
@@ -464,12 +1220,28 @@ private:
         return false;
     }
 
+    /// Fling hit an edge: pin this engine to it and hand the remaining
+    /// velocity to a same-axis ancestor that can still scroll that way.
+    bool handOffFling(float &offset, float &velocity, float maxOff) {
+        auto *up = chainParent();
+        if (!up || velocity == 0 || !up->canConsume(velocity)) return false;
+        float overshoot = offset - clampf(offset, 0, maxOff);
+        offset = clampf(offset, 0, maxOff);
+        float handed = velocity;
+        velocity = 0;
+        up->consumeNestedDelta(overshoot);
+        up->startNestedFling(handed);
+        return true;
+    }
+
     void startBounce() {
-        phase = ScrollPhase::Bouncing;
+        springX = springY = false;
+        setPhase(ScrollPhase::Bouncing);
         lastTimestamp = 0;
     }
 
     bool stepBounce(float dt, float maxX, float maxY) {
+        if (freeScroll) return stepFree(dt);
         if (horizontal) {
             float target = clampf(offsetX, 0, maxX);
             auto s = springStep(offsetX, velocityX, target, dt);
@@ -483,6 +1255,46 @@ private:
         }
     }
 
+    /// Free scroll, decelerating or bouncing: a zoom past its limits
+    /// springs back about the focal point first (moving the bounds), then
+    /// each axis flings while in bounds and springs back once past an
+    /// edge, so one axis bouncing never brakes the other's fling.
+    bool stepFree(float dt) {
+        bool zoomDone = stepZoom(dt);
+        bool doneX = stepFreeAxis(offsetX, velocityX, springX, dt, maxScrollX());
+        bool doneY = stepFreeAxis(offsetY, velocityY, springY, dt, maxScrollY());
+        if (phase == ScrollPhase::Decelerating && (springX || springY || !zoomDone)) {
+            setPhase(ScrollPhase::Bouncing);
+        }
+        return zoomDone && doneX && doneY;
+    }
+
+    bool stepFreeAxis(float &offset, float &velocity, bool &springing, float dt, float maxOff) {
+        if (!springing && isOverscrolled(offset, 0, maxOff)) springing = true;
+        if (springing) {
+            auto s = springStep(offset, velocity, clampf(offset, 0, maxOff), dt);
+            offset = s.offset; velocity = s.velocity;
+            if (s.finished) springing = false;
+            return s.finished;
+        }
+        if (velocity == 0) return true;
+        auto s = decelerationStep(offset, velocity, dt, decelerationRate, 0, maxOff);
+        offset = s.offset; velocity = s.velocity;
+        if (!isOverscrolled(offset, 0, maxOff)) return s.finished;
+        springing = true;
+        return false;
+    }
+
+    bool stepZoom(float dt) {
+        float target = clampf(zoomScale, minZoom, maxZoom);
+        if (zoomScale == target && zoomVelocity == 0) return true;
+        auto s = springStep(zoomScale * ZOOM_SPRING_UNITS, zoomVelocity * ZOOM_SPRING_UNITS,
+                            target * ZOOM_SPRING_UNITS, dt);
+        zoomVelocity = s.velocity / ZOOM_SPRING_UNITS;
+        zoomAround(s.offset / ZOOM_SPRING_UNITS, focalX, focalY);
+        return s.finished;
+    }
+
     void startSnap(bool isPaging) {
         float maxX = maxScrollX(), maxY = maxScrollY();
         if (horizontal) {
@@ -496,7 +1308,7 @@ private:
                 : findSnapTarget(offsetY, velocityY, snapInterval, 0, maxY, decelerationRate);
             snapTargetX = offsetX;
         }
-        phase = ScrollPhase::Snapping;
+        setPhase(ScrollPhase::Snapping);
         lastTimestamp = 0;
     }
 
@@ -533,37 +1345,86 @@ private:
         if (node) {
             node->scrollX = offsetX;
             node->scrollY = offsetY;
+            node->zoomScale = zoomScale;
             node->markDirty();
         }
-        if (onScrollCallback) onScrollCallback(offsetX, offsetY);
+        updateStickyHeaders();
+        applyBindings();
+        updateRenderedWindow();
+        publishShared();
+        if (!onScrollCallback) return;
+        if (eventQueue) {
+            scrollEventPending = true;
+            queueEvent();
+        } else {
+            onScrollCallback(offsetX, offsetY, velocityX, velocityY);
+        }
     }
 
-    void fireScrollEnd() {
-        if (onScrollEndCallback) onScrollEndCallback(offsetX, offsetY);
+    /// Pin each header at the viewport edge once scrolled past, pushed
+    /// off by the next header as it arrives.
+    void updateStickyHeaders() {
+        if (stickyHeaders.empty()) return;
+        float offset = horizontal ? offsetX : offsetY;
+        for (size_t i = 0; i < stickyHeaders.size(); i++) {
+            auto &h = stickyHeaders[i];
+            float pos = std::max(h.naturalPos, offset);
+            if (i + 1 < stickyHeaders.size()) {
+                float size = horizontal ? h.node->layout.width : h.node->layout.height;
+                pos = std::min(pos, stickyHeaders[i + 1].naturalPos - size);
+            }
+            float translation = std::max(0.0f, pos - h.naturalPos);
+            if (translation == h.translation) continue;
+            h.translation = translation;
+            setAxisPos(h.node, h.naturalPos + translation);
+        }
     }
 
-    bool isOverscrolled(float offset, float min, float max) {
-        return offset < min || offset > max;
+    float axisPos(const skia::SkiaNode *child) const {
+        return horizontal ? child->layout.x : child->layout.y;
+    }
+
+    void setAxisPos(skia::SkiaNode *child, float pos) {
+        if (horizontal) child->layout.x = pos;
+        else child->layout.y = pos;
+        child->markDirty();
     }
 
-    float maxScrollX() { return std::max(0.0f, contentW - viewportW); }
-    float maxScrollY() { return std::max(0.0f, contentH - viewportH); }
+    void applyBinding(const ScrollBinding &b) {
+        float input = horizontal ? offsetX : offsetY;
+        animation::writeNodeProp(b.node, b.prop,
+            animation::interpolateRange(input, b.inputRange, b.outputRange,
+                                        b.extrapolate, b.extrapolate));
+    }
 
-    void updateBoundsFromNode() {
-        if (!node) return;
-        viewportW = node->layout.width;
-        viewportH = node->layout.height;
+    /// Append the parts of `a` not covered by `b` (at most two ranges).
+    static void diffRanges(IndexRange a, IndexRange b, std::vector<IndexRange> &out) {
+        if (a.empty()) return;
+        if (b.empty() || b.last < a.first || b.first > a.last) {
+            out.push_back(a);
+            return;
+        }
+        if (a.first < b.first) out.push_back({a.first, b.first - 1});
+        if (a.last > b.last) out.push_back({b.last + 1, a.last});
+    }
 
-        float maxR = 0, maxB = 0;
-        for (auto *child : node->children) {
-            float r = child->layout.x + child->layout.width;
-            float b = child->layout.y + child->layout.height;
-            if (r > maxR) maxR = r;
-            if (b > maxB) maxB = b;
+    void fireScrollEnd() {
+        if (!onScrollEndCallback) return;
+        if (eventQueue) {
+            // Deferred so it is delivered after the final onScroll
+            scrollEndPending = true;
+            queueEvent();
+        } else {
+            onScrollEndCallback(offsetX, offsetY);
         }
-        contentW = maxR;
-        contentH = maxB;
     }
+
+    bool isOverscrolled(float offset, float min, float max) {
+        return offset < min || offset > max;
+    }
+
+    float maxScrollX() { return std::max(0.0f, contentW * zoomScale - viewportW); }
+    float maxScrollY() { return std::max(0.0f, contentH * zoomScale - viewportH); }
 };
 
 // ---------------------------------------------------------------------------
@@ -581,53 +1442,252 @@ public:
         engine->horizontal = node->horizontal;
         engine->bounces = true;
         engine->scrollEnabled = node->scrollEnabled;
+        engine->seedExtentsFromNode();
+        engine->eventQueue = &eventQueue_;
+        engine->activeList = &active_;
         auto *ptr = engine.get();
+        nodeOwner_[node] = ptr;
+        ptr->extents.forEachChild([this, ptr](int childId) {
+            childOwner_[childId] = ptr;
+        });
         engines_[id] = std::move(engine);
         return ptr;
     }
 
+    int nextBindingId() { return nextBindingId_++; }
+
     ScrollEngine *get(int id) {
         auto it = engines_.find(id);
         return it != engines_.end() ? it->second.get() : nullptr;
     }
 
     void remove(int id) {
-        engines_.erase(id);
+        auto it = engines_.find(id);
+        if (it == engines_.end()) return;
+        if (onEngineRemoved) onEngineRemoved(id);
+        it->second->extents.forEachChild([this](int childId) {
+            childOwner_.erase(childId);
+        });
+        auto *removed = it->second.get();
+        removed->setPhase(ScrollPhase::Idle); // leave the active list
+        std::replace(ticking_.begin(), ticking_.end(), removed,
+                     static_cast<ScrollEngine *>(nullptr));
+        auto owner = nodeOwner_.find(removed->node);
+        if (owner != nodeOwner_.end() && owner->second == removed) nodeOwner_.erase(owner);
+        // Ancestors ignore a pointer claimed by this subtree until it lifts
+        for (auto *p = removed->parent; p; p = p->parent) {
+            if (p->delegatedPointerId == removed->activePointerId ||
+                p->delegatedPointerId == removed->delegatedPointerId) {
+                p->delegatedPointerId = -1;
+            }
+        }
+        removed->unlinkParent();
+        for (auto *child : removed->nestedChildren) child->onParentRemoved();
+        if (it->second->eventQueued) {
+            auto *engine = it->second.get();
+            eventQueue_.erase(std::remove(eventQueue_.begin(), eventQueue_.end(), engine),
+                              eventQueue_.end());
+        }
+        engines_.erase(it);
+    }
+
+    // ── Tree mutation hooks (keep content extents incremental) ──
+
+    void onChildInserted(skia::SkiaNode *parent, skia::SkiaNode *child) {
+        // Moved without a remove: the old container must drop its extent
+        auto owned = childOwner_.find(child->id);
+        if (owned != childOwner_.end() && owned->second->node != parent) {
+            releaseChild(owned, child);
+        }
+        auto *engine = findByNode(parent);
+        if (!engine) return;
+        engine->updateChildExtent(child);
+        childOwner_[child->id] = engine;
+    }
+
+    void onChildRemoved(skia::SkiaNode *parent, skia::SkiaNode *child) {
+        // Bindings must not outlive their target: a node taken out of the
+        // tree may be destroyed before the engine that writes to it
+        for (auto &[id, engine] : engines_) {
+            if (!engine->bindings.empty()) engine->removeBindingsUnder(child);
+        }
+        auto it = childOwner_.find(child->id);
+        if (it == childOwner_.end() || it->second->node != parent) return;
+        releaseChild(it, child);
+    }
+
+    void onLayoutChanged(skia::SkiaNode *node) {
+        auto it = childOwner_.find(node->id);
+        if (it == childOwner_.end()) return;
+        it->second->updateChildExtent(node);
+        it->second->onStickyHeaderLayout(node);
     }
 
     /// Tick all active engines. Called from the render loop.
+    /// Cost scales with moving engines, not mounted ones.
     void tickAll(double timestamp) {
-        for (auto &[id, engine] : engines_) {
-            if (engine->needsTick()) {
+        if (active_.empty()) return;
+        // Snapshot: ticks reorder active_ (engines settle or hand a fling
+        // to a parent), and a removed engine is nulled out of ticking_.
+        ticking_.assign(active_.begin(), active_.end());
+        for (size_t i = 0; i < ticking_.size(); i++) {
+            auto *engine = ticking_[i];
+            if (engine && engine->needsTick()) {
                 engine->tick(timestamp);
+                engine->publishShared(); // velocity and phase move without a commit
             }
         }
+        ticking_.clear();
     }
 
-    bool hasActiveEngines() const {
-        for (auto &[id, engine] : engines_) {
-            if (engine->needsTick() || engine->phase == ScrollPhase::Dragging) return true;
+    /// Deliver coalesced onScroll/onScrollEnd events and virtualized
+    /// window changes. Called once per frame after tickAll(): each engine
+    /// delivers at most one onScroll carrying its latest offset and
+    /// velocity, and all of them go to JS in a single batch call when a
+    /// batch dispatcher is registered.
+    void flushScrollEvents(double timestamp) {
+        if (eventQueue_.empty()) return;
+        draining_.swap(eventQueue_);
+
+        batch_.clear();
+        for (auto *engine : draining_) {
+            engine->eventQueued = false;
+            bool ending = engine->scrollEndPending;
+            if (engine->windowPending) windowChanges_.push_back(engine->id);
+
+            if (engine->scrollEventPending) {
+                bool due = ending || engine->scrollEventThrottle <= 0 ||
+                    timestamp - engine->lastScrollEventTs >= engine->scrollEventThrottle;
+                if (!due) {
+                    engine->queueEvent(); // retry next frame
+                    continue;
+                }
+                engine->scrollEventPending = false;
+                engine->lastScrollEventTs = timestamp;
+                batch_.push_back({engine->id, engine->offsetX, engine->offsetY,
+                                  engine->reportedVelocityX(), engine->reportedVelocityY()});
+            }
+            if (ending) {
+                engine->scrollEndPending = false;
+                ending_.push_back(engine->id);
+            }
+        }
+        draining_.clear();
+
+        // Callbacks may re-enter (scrollTo, remove) — look engines up by id.
+        // Window changes go first so items mount before onScroll runs.
+        for (size_t i = 0; i < windowChanges_.size(); i++) {
+            auto *engine = get(windowChanges_[i]);
+            if (engine && engine->windowPending) engine->deliverWindow();
+        }
+        windowChanges_.clear();
+
+        if (!batch_.empty()) {
+            if (onScrollBatchCallback) {
+                onScrollBatchCallback(batch_);
+            } else {
+                for (auto &e : batch_) {
+                    auto *engine = get(e.engineId);
+                    if (engine && engine->onScrollCallback) {
+                        engine->onScrollCallback(e.x, e.y, e.velocityX, e.velocityY);
+                    }
+                }
+            }
+        }
+        for (int id : ending_) {
+            auto *engine = get(id);
+            if (engine && engine->onScrollEndCallback) {
+                engine->onScrollEndCallback(engine->offsetX, engine->offsetY);
+            }
+        }
+        ending_.clear();
+    }
+
+    struct ScrollEvent {
+        int engineId;
+        float x, y;
+        float velocityX, velocityY;
+    };
+
+    // Single JS entry per frame for all engines' onScroll events
+    std::function<void(const std::vector<ScrollEvent> &)> onScrollBatchCallback;
+
+    // Called with an engine's id just before it is destroyed
+    std::function<void(int)> onEngineRemoved;
+
+    /// Any engine dragging or animating (every non-idle phase).
+    bool hasActiveEngines() const { return !active_.empty(); }
+
+    /// Apply buffered drags at the frame's resampled touch position.
+    /// `frameTime` is on the touch-event clock; call before tickAll().
+    void resampleDrags(double frameTime) {
+        for (size_t i = 0; i < active_.size(); i++) {
+            active_[i]->resampleDrag(frameTime);
         }
-        return false;
+    }
+
+    template <typename Fn>
+    void forEachActive(Fn &&fn) {
+        for (auto *engine : active_) fn(engine);
     }
 
     /// Find engine by its bound node pointer.
     ScrollEngine *findByNode(skia::SkiaNode *node) {
-        for (auto &[id, engine] : engines_) {
-            if (engine->node == node) return engine.get();
-        }
-        return nullptr;
+        auto it = nodeOwner_.find(node);
+        return it != nodeOwner_.end() ? it->second : nullptr;
     }
 
 private:
+    void releaseChild(std::unordered_map<int, ScrollEngine *>::iterator owner,
+                      skia::SkiaNode *child) {
+        owner->second->extents.remove(child->id);
+        owner->second->removeStickyHeader(child);
+        childOwner_.erase(owner);
+    }
+
     int nextId_ = 1;
+    int nextBindingId_ = 1;
     std::unordered_map<int, std::unique_ptr<ScrollEngine>> engines_;
+    // Child nodeId → engine whose content extents include it
+    std::unordered_map<int, ScrollEngine *> childOwner_;
+    // Bound node → engine (hit testing, tree hooks)
+    std::unordered_map<skia::SkiaNode *, ScrollEngine *> nodeOwner_;
+    // Non-idle engines (intrusive via ScrollEngine::activeSlot)
+    std::vector<ScrollEngine *> active_, ticking_;
+    // Engines with a pending onScroll/onScrollEnd (reused every frame)
+    std::vector<ScrollEngine *> eventQueue_, draining_;
+    std::vector<ScrollEvent> batch_;
+    std::vector<int> ending_;
+    std::vector<int> windowChanges_;
 };
 
 // ---------------------------------------------------------------------------
 // JSI Registration
 // ---------------------------------------------------------------------------
 
+/// Wrap the SkiaNodeTree host function `name` so `after` runs once the
+/// tree has applied the call. Must run after registerNodeTreeHostFunctions;
+/// hooks stack, each seeing the call after the ones registered before it.
+inline void hookNodeTreeFunction(
+    facebook::jsi::Runtime &rt, const char *name, unsigned int paramCount,
+    std::function<void(const facebook::jsi::Value *, size_t)> after)
+{
+    namespace jsi = facebook::jsi;
+    auto original = rt.global().getProperty(rt, name);
+    if (!original.isObject() || !original.asObject(rt).isFunction(rt)) return;
+    auto fn = std::make_shared<jsi::Function>(
+        original.asObject(rt).asFunction(rt));
+    rt.global().setProperty(rt, name,
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, name), paramCount,
+            [fn, after](jsi::Runtime &rt, const jsi::Value &,
+                        const jsi::Value *args, size_t count) -> jsi::Value {
+                auto result = fn->call(rt, args, count);
+                after(args, count);
+                return result;
+            }));
+}
+
 inline void registerScrollEngineHostFunctions(
     facebook::jsi::Runtime &rt,
     ScrollEngineManager *mgr,
@@ -649,6 +1709,17 @@ inline void registerScrollEngineHostFunctions(
                 return jsi::Value(engine->id);
             }));
 
+    // __scrollDestroy(engineId)
+    rt.global().setProperty(rt, "__scrollDestroy",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollDestroy"), 1,
+            [mgr](jsi::Runtime &, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1) return jsi::Value::undefined();
+                mgr->remove(static_cast<int>(args[0].asNumber()));
+                return jsi::Value::undefined();
+            }));
+
     // __scrollTouch(engineId, phase, x, y, timestamp, pointerId)
     // phase: 0=began, 1=moved, 2=ended, 3=cancelled
     rt.global().setProperty(rt, "__scrollTouch",
@@ -723,6 +1794,9 @@ inline void registerScrollEngineHostFunctions(
 
                 if (key == "horizontal") engine->horizontal = args[2].getBool();
                 else if (key == "bounces") engine->bounces = args[2].getBool();
+                else if (key == "minimumZoomScale") engine->minZoom = std::max(0.01f, static_cast<float>(args[2].asNumber()));
+                else if (key == "maximumZoomScale") engine->maxZoom = static_cast<float>(args[2].asNumber());
+                else if (key == "zoomScale") engine->zoomTo(static_cast<float>(args[2].asNumber()));
                 else if (key == "scrollEnabled") engine->scrollEnabled = args[2].getBool();
                 else if (key == "pagingEnabled") engine->pagingEnabled = args[2].getBool();
                 else if (key == "snapToInterval") engine->snapInterval = static_cast<float>(args[2].asNumber());
@@ -736,10 +1810,247 @@ inline void registerScrollEngineHostFunctions(
                         engine->decelerationRate = static_cast<float>(args[2].asNumber());
                     }
                 }
+                else if (key == "touchResampling") engine->touchResampling = args[2].getBool();
+                else if (key == "freeScroll") engine->freeScroll = args[2].getBool();
+                else if (key == "touchPrediction") {
+                    engine->touchPredictionMs = static_cast<float>(args[2].asNumber());
+                }
+                else if (key == "scrollEventThrottle") {
+                    engine->scrollEventThrottle = static_cast<float>(args[2].asNumber());
+                }
+                else if (key == "velocityEstimator") {
+                    auto val = args[2].asString(rt).utf8(rt);
+                    engine->setVelocityEstimator(val == "leastSquares"
+                        ? VelocityEstimator::LeastSquares
+                        : VelocityEstimator::WeightedDifference);
+                }
+
+                return jsi::Value::undefined();
+            }));
+
+    // __scrollSetItemExtents(engineId, extents, count?, leadingOffset?)
+    // extents: number (uniform, requires count) or number[] (per item)
+    rt.global().setProperty(rt, "__scrollSetItemExtents",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollSetItemExtents"), 4,
+            [mgr](jsi::Runtime &rt, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value::undefined();
+                int id = static_cast<int>(args[0].asNumber());
+                auto *engine = mgr->get(id);
+                if (!engine) return jsi::Value::undefined();
+
+                if (args[1].isNumber()) {
+                    int n = count >= 3 ? static_cast<int>(args[2].asNumber()) : 0;
+                    engine->items.assign(n, static_cast<float>(args[1].asNumber()));
+                } else if (args[1].isObject() && args[1].asObject(rt).isArray(rt)) {
+                    auto arr = args[1].asObject(rt).asArray(rt);
+                    size_t n = arr.size(rt);
+                    std::vector<float> extents(n);
+                    for (size_t i = 0; i < n; i++) {
+                        extents[i] = static_cast<float>(
+                            arr.getValueAtIndex(rt, i).asNumber());
+                    }
+                    engine->items.assign(std::move(extents));
+                }
+                if (count >= 4 && args[3].isNumber()) {
+                    engine->itemsLeadingOffset = static_cast<float>(args[3].asNumber());
+                }
+                engine->updateBoundsFromNode();
+                engine->updateRenderedWindow();
+                return jsi::Value::undefined();
+            }));
+
+    // __scrollSetItemExtent(engineId, index, extent) — e.g. after measuring
+    rt.global().setProperty(rt, "__scrollSetItemExtent",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollSetItemExtent"), 3,
+            [mgr](jsi::Runtime &, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 3) return jsi::Value::undefined();
+                int id = static_cast<int>(args[0].asNumber());
+                auto *engine = mgr->get(id);
+                if (!engine) return jsi::Value::undefined();
+                engine->items.setExtent(static_cast<int>(args[1].asNumber()),
+                                        static_cast<float>(args[2].asNumber()));
+                engine->updateBoundsFromNode(); // list length, max offset
+                engine->updateRenderedWindow();
+                return jsi::Value::undefined();
+            }));
+
+    // __scrollSetWindowCallback(engineId, overscan, callback)
+    // callback(first, last, entered: [first, last][], left: [first, last][])
+    // is called immediately with the initial window, then only on change.
+    rt.global().setProperty(rt, "__scrollSetWindowCallback",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollSetWindowCallback"), 3,
+            [mgr](jsi::Runtime &rt, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 3) return jsi::Value::undefined();
+                int id = static_cast<int>(args[0].asNumber());
+                auto *engine = mgr->get(id);
+                if (!engine) return jsi::Value::undefined();
+
+                engine->overscan = std::max(0, static_cast<int>(args[1].asNumber()));
+                engine->updateBoundsFromNode();
+                if (args[2].isObject() && args[2].asObject(rt).isFunction(rt)) {
+                    auto cb = std::make_shared<jsi::Function>(
+                        args[2].asObject(rt).asFunction(rt));
+                    engine->onWindowChangeCallback = [cb, &rt](
+                        IndexRange window,
+                        const std::vector<IndexRange> &entered,
+                        const std::vector<IndexRange> &left)
+                    {
+                        auto toJSI = [&rt](const std::vector<IndexRange> &ranges) {
+                            jsi::Array arr(rt, ranges.size());
+                            for (size_t i = 0; i < ranges.size(); i++) {
+                                jsi::Array pair(rt, 2);
+                                pair.setValueAtIndex(rt, 0, ranges[i].first);
+                                pair.setValueAtIndex(rt, 1, ranges[i].last);
+                                arr.setValueAtIndex(rt, i, std::move(pair));
+                            }
+                            return arr;
+                        };
+                        cb->call(rt, jsi::Value(window.first), jsi::Value(window.last),
+                                 toJSI(entered), toJSI(left));
+                    };
+                } else {
+                    engine->onWindowChangeCallback = nullptr;
+                }
+                engine->resetRenderedWindow();
+                engine->deliverWindow(); // the initial window, synchronously
+                return jsi::Value::undefined();
+            }));
+
+    // __scrollBind(engineId, nodeId, prop, inputRange, outputRange, extrapolate?)
+    //   → bindingId
+    // Maps the engine's scroll offset (along its axis) through
+    // inputRange → outputRange and writes the result into the node prop
+    // natively after every offset commit. extrapolate: "extend" | "clamp"
+    // | "identity" (default "extend"). The binding is dropped when its
+    // node, or an ancestor of it, is removed from the tree.
+    rt.global().setProperty(rt, "__scrollBind",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollBind"), 6,
+            [mgr, tree](jsi::Runtime &rt, const jsi::Value &,
+                        const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 5) return jsi::Value(-1);
+                auto *engine = mgr->get(static_cast<int>(args[0].asNumber()));
+                auto *node = tree->getNode(static_cast<int>(args[1].asNumber()));
+                if (!engine || !node) return jsi::Value(-1);
+
+                auto readRange = [&rt](const jsi::Value &v) {
+                    std::vector<float> out;
+                    if (!v.isObject() || !v.asObject(rt).isArray(rt)) return out;
+                    auto arr = v.asObject(rt).asArray(rt);
+                    size_t n = arr.size(rt);
+                    out.reserve(n);
+                    for (size_t i = 0; i < n; i++) {
+                        out.push_back(static_cast<float>(
+                            arr.getValueAtIndex(rt, i).asNumber()));
+                    }
+                    return out;
+                };
+
+                ScrollBinding binding;
+                binding.node = node;
+                binding.prop = animation::propIdFromString(args[2].asString(rt).utf8(rt));
+                binding.inputRange = readRange(args[3]);
+                binding.outputRange = readRange(args[4]);
+                if (binding.inputRange.size() < 2 ||
+                    binding.inputRange.size() != binding.outputRange.size()) {
+                    return jsi::Value(-1);
+                }
+                if (count >= 6 && args[5].isString()) {
+                    binding.extrapolate = animation::extrapolateFromString(
+                        args[5].asString(rt).utf8(rt));
+                }
+                binding.id = mgr->nextBindingId();
+                int bindingId = binding.id;
+                engine->addBinding(std::move(binding));
+                return jsi::Value(bindingId);
+            }));
+
+    // __scrollUnbind(engineId, bindingId)
+    rt.global().setProperty(rt, "__scrollUnbind",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollUnbind"), 2,
+            [mgr](jsi::Runtime &, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value::undefined();
+                auto *engine = mgr->get(static_cast<int>(args[0].asNumber()));
+                if (engine) engine->removeBinding(static_cast<int>(args[1].asNumber()));
+                return jsi::Value::undefined();
+            }));
+
+    // __scrollSetStickyHeaders(engineId, childIndices)
+    // Children at these indices pin to the viewport's leading edge and are
+    // pushed off by the next sticky header. Pass [] to clear.
+    rt.global().setProperty(rt, "__scrollSetStickyHeaders",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollSetStickyHeaders"), 2,
+            [mgr](jsi::Runtime &rt, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value::undefined();
+                auto *engine = mgr->get(static_cast<int>(args[0].asNumber()));
+                if (!engine) return jsi::Value::undefined();
+                std::vector<int> indices;
+                if (args[1].isObject() && args[1].asObject(rt).isArray(rt)) {
+                    auto arr = args[1].asObject(rt).asArray(rt);
+                    size_t n = arr.size(rt);
+                    for (size_t i = 0; i < n; i++) {
+                        indices.push_back(static_cast<int>(
+                            arr.getValueAtIndex(rt, i).asNumber()));
+                    }
+                }
+                engine->setStickyHeaders(indices);
+                return jsi::Value::undefined();
+            }));
 
+    // __scrollLink(childEngineId, parentEngineId)
+    // Links nested engines: the child resolves axis locking, overscroll
+    // chaining and fling handoff for the whole chain within each touch
+    // event. parentEngineId 0 unlinks.
+    rt.global().setProperty(rt, "__scrollLink",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollLink"), 2,
+            [mgr](jsi::Runtime &, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value::undefined();
+                auto *child = mgr->get(static_cast<int>(args[0].asNumber()));
+                if (!child) return jsi::Value::undefined();
+                auto *parent = mgr->get(static_cast<int>(args[1].asNumber()));
+                if (parent == child->parent) return jsi::Value::undefined();
+                if (parent) child->linkParent(parent);
+                else child->unlinkParent();
                 return jsi::Value::undefined();
             }));
 
+    // Tree mutation hooks: child insert/remove and layout changes update
+    // content extents after the tree has applied them.
+    hookNodeTreeFunction(rt, "__nodeAppendChild", 2,
+        [mgr, tree](const jsi::Value *args, size_t count) {
+            if (count < 2) return;
+            auto *parent = tree->getNode(static_cast<int>(args[0].asNumber()));
+            auto *child = tree->getNode(static_cast<int>(args[1].asNumber()));
+            if (parent && child) mgr->onChildInserted(parent, child);
+        });
+
+    hookNodeTreeFunction(rt, "__nodeRemoveChild", 2,
+        [mgr, tree](const jsi::Value *args, size_t count) {
+            if (count < 2) return;
+            auto *parent = tree->getNode(static_cast<int>(args[0].asNumber()));
+            auto *child = tree->getNode(static_cast<int>(args[1].asNumber()));
+            if (parent && child) mgr->onChildRemoved(parent, child);
+        });
+
+    hookNodeTreeFunction(rt, "__nodeSetLayout", 7,
+        [mgr, tree](const jsi::Value *args, size_t count) {
+            if (count < 1) return;
+            auto *node = tree->getNode(static_cast<int>(args[0].asNumber()));
+            if (node) mgr->onLayoutChanged(node);
+        });
+
     // __scrollSetCallbacks(engineId, onScroll, onScrollEnd)
     rt.global().setProperty(rt, "__scrollSetCallbacks",
         jsi::Function::createFromHostFunction(rt,
@@ -754,8 +2065,10 @@ inline void registerScrollEngineHostFunctions(
                 if (args[1].isObject() && args[1].asObject(rt).isFunction(rt)) {
                     auto cb = std::make_shared<jsi::Function>(
                         args[1].asObject(rt).asFunction(rt));
-                    engine->onScrollCallback = [cb, &rt](float x, float y) {
-                        cb->call(rt, jsi::Value((double)x), jsi::Value((double)y));
+                    engine->onScrollCallback = [cb, &rt](float x, float y,
+                                                         float vx, float vy) {
+                        cb->call(rt, jsi::Value((double)x), jsi::Value((double)y),
+                                 jsi::Value((double)vx), jsi::Value((double)vy));
                     };
                 }
 
@@ -769,6 +2082,39 @@ inline void registerScrollEngineHostFunctions(
 
                 return jsi::Value::undefined();
             }));
+
+    // __scrollSetBatchDispatcher(fn)
+    // fn(events) where events is a flat array [id, x, y, vx, vy, id, ...]
+    // holding at most one entry per engine. Called once per frame; engines
+    // with an onScroll callback are delivered here instead of individually.
+    rt.global().setProperty(rt, "__scrollSetBatchDispatcher",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__scrollSetBatchDispatcher"), 1,
+            [mgr](jsi::Runtime &rt, const jsi::Value &,
+                  const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 1 || !args[0].isObject() ||
+                    !args[0].asObject(rt).isFunction(rt)) {
+                    mgr->onScrollBatchCallback = nullptr;
+                    return jsi::Value::undefined();
+                }
+                auto cb = std::make_shared<jsi::Function>(
+                    args[0].asObject(rt).asFunction(rt));
+                mgr->onScrollBatchCallback = [cb, &rt](
+                    const std::vector<ScrollEngineManager::ScrollEvent> &events)
+                {
+                    jsi::Array arr(rt, events.size() * 5);
+                    size_t i = 0;
+                    for (auto &e : events) {
+                        arr.setValueAtIndex(rt, i++, e.engineId);
+                        arr.setValueAtIndex(rt, i++, (double)e.x);
+                        arr.setValueAtIndex(rt, i++, (double)e.y);
+                        arr.setValueAtIndex(rt, i++, (double)e.velocityX);
+                        arr.setValueAtIndex(rt, i++, (double)e.velocityY);
+                    }
+                    cb->call(rt, std::move(arr));
+                };
+                return jsi::Value::undefined();
+            }));
 }
 
 } // namespace gestures
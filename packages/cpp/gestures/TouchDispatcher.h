@@ -9,15 +9,27 @@
  * JSI API:
  *   __touchSetCallback(nodeId, event, callback)
  *   event: "onPressIn" | "onPressOut" | "onPress" | "onLongPress"
+ *   __gestureDrive(gestureId, nodeId, config)   pan → node props natively
  *
  * The native layer calls dispatchTouch() which does hit testing
  * in C++ and fires JS callbacks only when needed.
+ *
+ * Hit testing queries a HitTestIndex instead of walking the tree: one
+ * query per touch-began serves both gestures and press handling. The
+ * index follows the node tree through the same host-function hooks the
+ * scroll engines use (layout, props, child insert/remove, root).
+ * scrollChainAt() runs the same query to find the ScrollEngines a touch
+ * bubbles through (trace replay).
  */
 
 #pragma once
 
 #include "skia/SkiaNodeTree.h"
 #include "gestures/GestureRecognizer.h"
+#include "gestures/HitTestIndex.h"
+#include "gestures/PanDrive.h"
+#include "gestures/ScrollEngine.h"
+#include "animation/AnimationTicker.h"
 
 #include <jsi/jsi.h>
 
@@ -48,11 +60,37 @@ struct TouchCallbacks {
 
 class TouchDispatcher {
 public:
+    TouchDispatcher() {
+        hitIndex_.indexed = [this](const skia::SkiaNode *node) {
+            return isHitTarget(node) || node->type == skia::NodeType::Scroll;
+        };
+    }
+
     /// Set the node tree for hit testing.
     void setNodeTree(skia::SkiaNodeTree *tree) {
         tree_ = tree;
+        hitIndex_.invalidate();
+    }
+
+    /// Set the scroll manager — hit testing follows pinned sticky headers.
+    void setScrollManager(ScrollEngineManager *mgr) {
+        scrollManager_ = mgr;
     }
 
+    /// Set the animation ticker — runs PanDrive releases.
+    void setAnimationTicker(animation::AnimationTicker *ticker) {
+        ticker_ = ticker;
+    }
+
+    /// Hit test a standalone node tree (a replay stage) instead of the
+    /// SkiaNodeTree's root.
+    void setRootNode(skia::SkiaNode *root) {
+        root_ = root;
+        hitIndex_.invalidate();
+    }
+
+    skia::SkiaNodeTree *nodeTree() const { return tree_; }
+
     /// Register a touch callback for a node.
     void setCallback(int nodeId, const std::string &event,
                      std::shared_ptr<facebook::jsi::Function> callback) {
@@ -61,6 +99,31 @@ public:
         else if (event == "onPressOut") callbacks_[nodeId].onPressOut = callback;
         else if (event == "onPress") callbacks_[nodeId].onPress = callback;
         else if (event == "onLongPress") callbacks_[nodeId].onLongPress = callback;
+        if (auto *node = tree_ ? tree_->getNode(nodeId) : nullptr) {
+            hitIndex_.onTargetChanged(node);
+        }
+    }
+
+    // ── Hit index upkeep (from node tree hooks) ───────────────
+
+    /// A new root.
+    void invalidateHitIndex() { hitIndex_.invalidate(); }
+
+    /// `child` was inserted under or removed from `parent`.
+    void onNodeChildChanged(skia::SkiaNode *parent, skia::SkiaNode *child) {
+        hitIndex_.onChildChanged(parent, child);
+    }
+
+    void onNodeLayoutChanged(skia::SkiaNode *node) { hitIndex_.onLayoutChanged(node); }
+
+    /// Prop `key` of `node` was set. Only touchability and geometry can
+    /// change the hit index; every other prop is ignored.
+    void onNodePropChanged(skia::SkiaNode *node, const std::string &key) {
+        switch (hitPropEffect(key)) {
+            case HitPropEffect::Target: hitIndex_.onTargetChanged(node); break;
+            case HitPropEffect::Geometry: hitIndex_.onLayoutChanged(node); break;
+            case HitPropEffect::None: break;
+        }
     }
 
     /**
@@ -74,10 +137,12 @@ public:
      */
     void dispatchTouch(int phase, float x, float y, int pointerId,
                        facebook::jsi::Runtime &rt) {
+        // One hit test per began, shared by gestures and press handling
+        skia::SkiaNode *target = phase == 0 ? hitTest(x, y) : nullptr;
+
         // Route to gesture recognizers
         if (phase == 0) {
-            // On began: hit-test and track pointer → node for gestures
-            auto *target = hitTest(x, y);
+            // On began: track pointer → node for gestures
             if (target && nodeGestures_.count(target->id)) {
                 gesturePointers_[pointerId] = target->id;
                 dispatchToGestures(phase, x, y, pointerId, target->id, rt);
@@ -95,7 +160,7 @@ public:
 
         // Route to press callbacks (unchanged)
         switch (phase) {
-            case 0: handleTouchBegan(x, y, pointerId, rt); break;
+            case 0: handleTouchBegan(target, x, y, pointerId, rt); break;
             case 1: handleTouchMoved(x, y, pointerId, rt); break;
             case 2: handleTouchEnded(x, y, pointerId, rt); break;
             case 3: handleTouchCancelled(pointerId, rt); break;
@@ -104,7 +169,13 @@ public:
 
 private:
     skia::SkiaNodeTree *tree_ = nullptr;
+    skia::SkiaNode *root_ = nullptr; // setRootNode: overrides tree_'s root
+    ScrollEngineManager *scrollManager_ = nullptr;
+    animation::AnimationTicker *ticker_ = nullptr;
     std::unordered_map<int, TouchCallbacks> callbacks_;
+    HitTestIndex hitIndex_;
+    // Pan gestureId → native drive
+    std::unordered_map<int, PanDrive> drives_;
 
     // Gesture recognizers: gestureId → recognizer
     std::unordered_map<int, std::unique_ptr<GestureRecognizer>> recognizers_;
@@ -155,6 +226,13 @@ public:
             if (auto *pan = dynamic_cast<PanRecognizer*>(rec)) {
                 pan->activationThreshold = (float)value;
             }
+        } else if (key == "velocityEstimator") {
+            // 0 = weighted difference, 1 = least squares
+            if (auto *pan = dynamic_cast<PanRecognizer*>(rec)) {
+                pan->setVelocityEstimator(value >= 1.0
+                    ? VelocityEstimator::LeastSquares
+                    : VelocityEstimator::WeightedDifference);
+            }
         } else if (key == "maxDistance") {
             if (auto *tap = dynamic_cast<TapRecognizer*>(rec)) {
                 tap->maxDistance = (float)value;
@@ -162,6 +240,53 @@ public:
         }
     }
 
+    /// Drive a node from a pan recognizer natively. Replaces any previous
+    /// drive on the gesture; returns false if it is not a pan.
+    bool setPanDrive(int gestureId, PanDrive drive) {
+        auto it = recognizers_.find(gestureId);
+        if (it == recognizers_.end()) return false;
+        auto *pan = dynamic_cast<PanRecognizer *>(it->second.get());
+        if (!pan) return false;
+        clearPanDrive(gestureId);
+        drive.onMoved = [this](skia::SkiaNode *node) { onNodeLayoutChanged(node); };
+        drives_[gestureId] = std::move(drive);
+        pan->onNative = [this, gestureId](GestureState state, const GestureEvent &e) {
+            auto dit = drives_.find(gestureId);
+            if (dit != drives_.end()) dit->second.onGesture(state, e, ticker_);
+        };
+        return true;
+    }
+
+    /// After the animation tick: move drives' absolute positions and hit
+    /// index entries along with their release animations.
+    void onAnimationFrame() {
+        for (auto &entry : drives_) entry.second.onFrame(ticker_);
+    }
+
+    /// Have a recognizer write GESTURE_SHARED_SLOTS shared values at
+    /// `slots` on every event (nullptr stops it).
+    bool setGestureSharedSlots(int gestureId, float *slots) {
+        auto it = recognizers_.find(gestureId);
+        if (it == recognizers_.end()) return false;
+        it->second->sharedSlots = slots;
+        return true;
+    }
+
+    /// Where a recognizer writes its shared values, or nullptr.
+    float *gestureSharedSlots(int gestureId) const {
+        auto it = recognizers_.find(gestureId);
+        return it != recognizers_.end() ? it->second->sharedSlots : nullptr;
+    }
+
+    void clearPanDrive(int gestureId) {
+        auto dit = drives_.find(gestureId);
+        if (dit == drives_.end()) return;
+        dit->second.stop(ticker_);
+        drives_.erase(dit);
+        auto it = recognizers_.find(gestureId);
+        if (it != recognizers_.end()) it->second->onNative = nullptr;
+    }
+
 private:
     /// Route a touch to all gesture recognizers attached to the hit node.
     void dispatchToGestures(int phase, float x, float y, int pointerId,
@@ -172,6 +297,7 @@ private:
             auto it = recognizers_.find(gid);
             if (it != recognizers_.end()) {
                 it->second->onTouchEvent(phase, x, y, pointerId, rt);
+                it->second->publishState();
             }
         }
     }
@@ -185,20 +311,63 @@ private:
     };
     std::unordered_map<int, ActiveTouch> activeTouches_;
 
+public:
     // ── Hit testing ───────────────────────────────────────────
 
     /**
      * Find the deepest touchable node at (x, y).
-     * Walks children in reverse order (front-to-back).
+     * Visits indexed candidates under the point front-to-back; the first
+     * whose ancestors all contain the point is the target — the node the
+     * recursive walk in hitTestNode would return.
      */
     skia::SkiaNode *hitTest(float x, float y) {
-        if (!tree_) return nullptr;
-        auto *root = tree_->getRoot();
+        auto *root = rootNode();
         if (!root) return nullptr;
-        return hitTestNode(root, x, y);
+        return hitTestSpace(nullptr, root, x, y, nullptr,
+                            [this](skia::SkiaNode *n) { return isHitTarget(n); });
+    }
+
+    /**
+     * Engines of the Scroll nodes a touch at (x, y) bubbles through,
+     * innermost first: the ancestors of the front-most hit target or
+     * scroll container there. Same query as hitTest, so pinned sticky
+     * headers and nested scroll spaces route the same way.
+     */
+    void scrollChainAt(float x, float y, std::vector<ScrollEngine *> &chain) {
+        chain.clear();
+        auto *root = rootNode();
+        if (!root || !scrollManager_) return;
+        auto target = [this](skia::SkiaNode *node) {
+            return isHitTarget(node) || scrollEngineOf(node) != nullptr;
+        };
+        for (auto *n = hitTestSpace(nullptr, root, x, y, nullptr, target); n; n = n->parent) {
+            if (auto *engine = scrollEngineOf(n)) chain.push_back(engine);
+        }
     }
 
+    /// Reference walk over the whole subtree; hitTest must agree with it.
     skia::SkiaNode *hitTestNode(skia::SkiaNode *node, float x, float y) {
+        return hitTestNode(node, x, y,
+                           [this](skia::SkiaNode *n) { return isHitTarget(n); });
+    }
+
+private:
+    skia::SkiaNode *rootNode() const {
+        return root_ ? root_ : tree_ ? tree_->getRoot() : nullptr;
+    }
+
+    bool isHitTarget(const skia::SkiaNode *node) const {
+        return node->touchable || callbacks_.count(node->id);
+    }
+
+    ScrollEngine *scrollEngineOf(skia::SkiaNode *node) const {
+        if (node->type != skia::NodeType::Scroll || !scrollManager_) return nullptr;
+        return scrollManager_->findByNode(node);
+    }
+
+    template <typename IsTarget>
+    skia::SkiaNode *hitTestNode(skia::SkiaNode *node, float x, float y,
+                                const IsTarget &isTarget) {
         if (!node->visible) return nullptr;
         if (node->display == "none") return nullptr;
 
@@ -210,36 +379,97 @@ private:
             return nullptr;
         }
 
-        // Transform touch coordinates for scroll containers:
-        // Children are laid out in content space, but rendered offset by scroll.
-        // Touch comes in viewport space, so we add scroll offset to convert
-        // from viewport → content space for children hit testing.
         float childX = x;
         float childY = y;
+        ScrollEngine *engine = nullptr;
         if (node->type == skia::NodeType::Scroll) {
-            childX += node->scrollX;
-            childY += node->scrollY;
+            if (auto *hit = enterScroll(node, childX, childY, engine, isTarget)) return hit;
         }
 
         // Check children in reverse order (front-most first)
         for (int i = (int)node->children.size() - 1; i >= 0; i--) {
-            auto *hit = hitTestNode(node->children[i], childX, childY);
+            auto *child = node->children[i];
+            if (engine && engine->stickyTranslationOf(child) != 0) continue; // tested above
+            auto *hit = hitTestNode(child, childX, childY, isTarget);
             if (hit) return hit;
         }
 
         // If this node is touchable, it's the target
-        if (node->touchable || callbacks_.count(node->id)) {
+        if (isTarget(node)) {
             return node;
         }
 
         return nullptr;
     }
 
+    /**
+     * Step into a Scroll node: map (x, y) from viewport to content space
+     * and test its pinned sticky headers, which sit above the content.
+     * Returns a header hit, or nullptr with (x, y) mapped and `engine`
+     * set for the content pass.
+     */
+    template <typename IsTarget>
+    skia::SkiaNode *enterScroll(skia::SkiaNode *node, float &x, float &y,
+                                ScrollEngine *&engine, const IsTarget &isTarget) {
+        // Children are laid out in content space, but rendered scaled by
+        // the zoom about the viewport origin and offset by scroll. Touch
+        // comes in viewport space, so undo both.
+        engine = scrollManager_ ? scrollManager_->findByNode(node) : nullptr;
+        float originX = node->layout.absoluteX, originY = node->layout.absoluteY;
+        x = originX + (x - originX + node->scrollX) / node->zoomScale;
+        y = originY + (y - originY + node->scrollY) / node->zoomScale;
+
+        // Pinned headers keep their unpinned absolute layout, so undo the
+        // pin translation before descending.
+        if (engine && !engine->stickyHeaders.empty()) {
+            for (auto &h : engine->stickyHeaders) {
+                if (h.translation == 0) continue;
+                float hx = engine->horizontal ? x - h.translation : x;
+                float hy = engine->horizontal ? y : y - h.translation;
+                if (auto *hit = hitTestNode(h.node, hx, hy, isTarget)) return hit;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Front-most target at (x, y) in the index space of `scroll` (nullptr
+    /// = the top space); (x, y) is already in that space's coordinates.
+    template <typename IsTarget>
+    skia::SkiaNode *hitTestSpace(skia::SkiaNode *scroll, skia::SkiaNode *root,
+                                 float x, float y, ScrollEngine *engine,
+                                 const IsTarget &isTarget) {
+        return hitIndex_.query(scroll, root, x, y,
+            [&](skia::SkiaNode *node) -> skia::SkiaNode * {
+                if (!reachable(node, scroll, x, y, engine)) return nullptr;
+                if (node->type == skia::NodeType::Scroll) {
+                    float cx = x, cy = y;
+                    ScrollEngine *inner = nullptr;
+                    if (auto *hit = enterScroll(node, cx, cy, inner, isTarget)) return hit;
+                    if (auto *hit = hitTestSpace(node, root, cx, cy, inner, isTarget)) return hit;
+                }
+                return isTarget(node) ? node : nullptr;
+            });
+    }
+
+    /// The walk would reach `node`: it and every ancestor below `scroll`
+    /// are shown and contain the point, and it is not under a pinned
+    /// sticky header (those are tested by enterScroll).
+    static bool reachable(const skia::SkiaNode *node, const skia::SkiaNode *scroll,
+                          float x, float y, ScrollEngine *engine) {
+        for (auto *n = node; n != scroll; n = n->parent) {
+            if (!n || !n->visible || n->display == "none") return false;
+            if (!HitRect::of(n).contains(x, y)) return false;
+            if (engine && n->parent == scroll && engine->stickyTranslationOf(n) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // ── Touch handlers ────────────────────────────────────────
 
-    void handleTouchBegan(float x, float y, int pointerId,
+    void handleTouchBegan(skia::SkiaNode *target, float x, float y, int pointerId,
                           facebook::jsi::Runtime &rt) {
-        auto *target = hitTest(x, y);
         if (!target) return;
 
         ActiveTouch touch;
@@ -302,7 +532,7 @@ private:
         }
 
         // Fire onPress or onLongPress if still within bounds
-        auto *node = tree_->getNode(nodeId);
+        auto *node = tree_ ? tree_->getNode(nodeId) : nullptr;
         if (node) {
             auto &l = node->layout;
             if (x >= l.absoluteX && x <= l.absoluteX + l.width &&
@@ -403,6 +633,80 @@ inline void registerTouchDispatcherHostFunctions(
                 return jsi::Value::undefined();
             }));
 
+    // __gestureDrive(gestureId, nodeId, config)
+    // Pan translation moves the node natively; no JS runs per move or on
+    // release. config: {
+    //   axis?: "x" | "y" | "both",
+    //   minX?, maxX?, minY?, maxY?,  rubberBand?: bool (default true),
+    //   release?: "spring" | "decay" | "none",
+    //   restX?, restY?,  snapX?: number[], snapY?: number[],
+    //   tension?, friction?, mass?, rate? }
+    // Pass no config to remove the drive. Returns false if the gesture is
+    // not a pan or the node does not exist.
+    rt.global().setProperty(rt, "__gestureDrive",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__gestureDrive"), 3,
+            [dispatcher](jsi::Runtime &rt, const jsi::Value &,
+                         const jsi::Value *args, size_t count) -> jsi::Value {
+                if (count < 2) return jsi::Value(false);
+                int gestureId = static_cast<int>(args[0].asNumber());
+                if (count < 3 || !args[2].isObject()) {
+                    dispatcher->clearPanDrive(gestureId);
+                    return jsi::Value(true);
+                }
+                auto *tree = dispatcher->nodeTree();
+                auto *node = tree ? tree->getNode(static_cast<int>(args[1].asNumber())) : nullptr;
+                if (!node) return jsi::Value(false);
+
+                auto config = args[2].asObject(rt);
+                auto has = [&](const char *key) { return config.hasProperty(rt, key); };
+                auto number = [&](const char *key) {
+                    return static_cast<float>(config.getProperty(rt, key).asNumber());
+                };
+                auto string = [&](const char *key) {
+                    return config.getProperty(rt, key).asString(rt).utf8(rt);
+                };
+                auto points = [&](const char *key) {
+                    std::vector<float> out;
+                    if (!has(key)) return out;
+                    auto arr = config.getProperty(rt, key).asObject(rt).asArray(rt);
+                    size_t n = arr.size(rt);
+                    for (size_t i = 0; i < n; i++) {
+                        out.push_back(static_cast<float>(arr.getValueAtIndex(rt, i).asNumber()));
+                    }
+                    return out;
+                };
+
+                PanDrive drive;
+                drive.node = node;
+                if (has("axis")) {
+                    auto axis = string("axis");
+                    drive.x.enabled = axis != "y";
+                    drive.y.enabled = axis != "x";
+                }
+                if (has("minX")) drive.x.min = number("minX");
+                if (has("maxX")) drive.x.max = number("maxX");
+                if (has("minY")) drive.y.min = number("minY");
+                if (has("maxY")) drive.y.max = number("maxY");
+                if (has("restX")) { drive.x.hasRest = true; drive.x.rest = number("restX"); }
+                if (has("restY")) { drive.y.hasRest = true; drive.y.rest = number("restY"); }
+                drive.x.snapPoints = points("snapX");
+                drive.y.snapPoints = points("snapY");
+                if (has("rubberBand")) drive.rubberBand = config.getProperty(rt, "rubberBand").getBool();
+                if (has("release")) {
+                    auto release = string("release");
+                    drive.release = release == "decay" ? PanDrive::Release::Decay
+                                  : release == "none" ? PanDrive::Release::None
+                                  : PanDrive::Release::Spring;
+                }
+                if (has("tension")) drive.springTension = number("tension");
+                if (has("friction")) drive.springFriction = number("friction");
+                if (has("mass")) drive.springMass = number("mass");
+                if (has("rate")) drive.decayRate = number("rate");
+
+                return jsi::Value(dispatcher->setPanDrive(gestureId, std::move(drive)));
+            }));
+
     // __gestureSetConfig(gestureId, key, value)
     rt.global().setProperty(rt, "__gestureSetConfig",
         jsi::Function::createFromHostFunction(rt,
@@ -416,6 +720,34 @@ inline void registerTouchDispatcherHostFunctions(
                 dispatcher->setGestureConfig(gestureId, key, value);
                 return jsi::Value::undefined();
             }));
+
+    // Tree mutation hooks: keep the hit index in step with the node tree.
+    auto nodeArg = [dispatcher](const jsi::Value *args, size_t count) -> skia::SkiaNode * {
+        auto *tree = dispatcher->nodeTree();
+        if (count < 1 || !tree || !args[0].isNumber()) return nullptr;
+        return tree->getNode(static_cast<int>(args[0].asNumber()));
+    };
+    auto childChanged = [nodeArg, dispatcher](const jsi::Value *args, size_t count) {
+        if (count < 2) return;
+        auto *parent = nodeArg(args, count);
+        auto *child = nodeArg(args + 1, count - 1);
+        if (parent && child) dispatcher->onNodeChildChanged(parent, child);
+    };
+    hookNodeTreeFunction(rt, "__nodeAppendChild", 2, childChanged);
+    hookNodeTreeFunction(rt, "__nodeRemoveChild", 2, childChanged);
+    hookNodeTreeFunction(rt, "__nodeSetRoot", 1,
+        [dispatcher](const jsi::Value *, size_t) { dispatcher->invalidateHitIndex(); });
+    hookNodeTreeFunction(rt, "__nodeSetLayout", 7,
+        [nodeArg, dispatcher](const jsi::Value *args, size_t count) {
+            if (auto *node = nodeArg(args, count)) dispatcher->onNodeLayoutChanged(node);
+        });
+    hookNodeTreeFunction(rt, "__nodeSetProp", 3,
+        [&rt, nodeArg, dispatcher](const jsi::Value *args, size_t count) {
+            if (count < 2 || !args[1].isString()) return;
+            auto key = args[1].asString(rt).utf8(rt);
+            if (hitPropEffect(key) == HitPropEffect::None) return;
+            if (auto *node = nodeArg(args, count)) dispatcher->onNodePropChanged(node, key);
+        });
 }
 
 } // namespace gestures
@@ -0,0 +1,121 @@
+/**
+ * TouchResampler.h — pointer position at frame presentation time.
+ *
+ * Digitizers report at 60–240 Hz on their own clock, unsynchronised with
+ * vsync, so applying every raw move makes the per-frame delta alternate
+ * between one and two samples — visible judder while dragging. The
+ * resampler buffers the most recent samples and evaluates the pointer at
+ * one time per frame: interpolated between the two samples bracketing it,
+ * or extrapolated from the newest pair by at most a bounded prediction
+ * horizon (never more than half the last sample interval).
+ *
+ * Resampling parameters follow Android's InputConsumer.
+ */
+
+#pragma once
+
+#include <array>
+#include <algorithm>
+
+namespace zilol {
+namespace gestures {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+// Sample this far behind the frame so it usually falls between two samples
+static constexpr double TOUCH_RESAMPLE_LATENCY_MS = 5.0;
+// Upper bound on extrapolation past the newest sample
+static constexpr double TOUCH_MAX_PREDICTION_MS = 8.0;
+// Sample pairs closer / further apart than this are not extrapolated
+static constexpr double TOUCH_MIN_DELTA_MS = 2.0;
+static constexpr double TOUCH_MAX_DELTA_MS = 20.0;
+
+// ---------------------------------------------------------------------------
+// TouchResampler
+// ---------------------------------------------------------------------------
+
+struct TouchSample {
+    double timestamp; // ms
+    float x, y;
+};
+
+class TouchResampler {
+public:
+    void addSample(double timestamp, float x, float y) {
+        if (count_ > 0 && timestamp <= newest().timestamp) {
+            // Same-timestamp batch — keep the latest position
+            if (timestamp == newest().timestamp) slot(count_ - 1) = {timestamp, x, y};
+            return;
+        }
+        if (count_ < CAPACITY) {
+            count_++;
+        } else {
+            head_ = (head_ + 1) % CAPACITY;
+        }
+        slot(count_ - 1) = {timestamp, x, y};
+    }
+
+    /// Pointer position at `time`, extrapolating at most `maxPredictionMs`
+    /// past the newest sample. Returns false when there are no samples.
+    bool sampleAt(double time, float &x, float &y,
+                  double maxPredictionMs = TOUCH_MAX_PREDICTION_MS) const {
+        if (count_ == 0) return false;
+        const auto &last = newest();
+        x = last.x;
+        y = last.y;
+        if (count_ == 1) return true;
+
+        if (time <= last.timestamp) {
+            // Interpolate within the buffered window
+            for (int i = count_ - 1; i > 0; i--) {
+                const auto &a = at(i - 1);
+                const auto &b = at(i);
+                if (time >= a.timestamp) {
+                    lerp(a, b, time, x, y);
+                    return true;
+                }
+            }
+            x = at(0).x;
+            y = at(0).y;
+            return true;
+        }
+
+        // Extrapolate from the newest pair, bounded
+        const auto &prev = at(count_ - 2);
+        double delta = last.timestamp - prev.timestamp;
+        if (delta < TOUCH_MIN_DELTA_MS || delta > TOUCH_MAX_DELTA_MS) return true;
+        double horizon = std::min(maxPredictionMs, delta * 0.5);
+        lerp(prev, last, std::min(time, last.timestamp + horizon), x, y);
+        return true;
+    }
+
+    const TouchSample &newest() const { return at(count_ - 1); }
+    int size() const { return count_; }
+
+    void reset() {
+        head_ = 0;
+        count_ = 0;
+    }
+
+private:
+    static constexpr int CAPACITY = 4;
+    std::array<TouchSample, CAPACITY> samples_{};
+    int head_ = 0;
+    int count_ = 0;
+
+    TouchSample &slot(int i) { return samples_[(head_ + i) % CAPACITY]; }
+    const TouchSample &at(int i) const { return samples_[(head_ + i) % CAPACITY]; }
+
+    static void lerp(const TouchSample &a, const TouchSample &b, double t,
+                     float &x, float &y) {
+        double span = b.timestamp - a.timestamp;
+        float alpha = span > 0 ? static_cast<float>((t - a.timestamp) / span) : 1.0f;
+        x = a.x + (b.x - a.x) * alpha;
+        y = a.y + (b.y - a.y) * alpha;
+    }
+};
+
+} // namespace gestures
+} // namespace zilol
@@ -0,0 +1,590 @@
+/**
+ * TouchTrace.h — record and replay touch streams for scroll physics.
+ *
+ * A trace is the raw input of a scroll session: every touch event
+ * (phase, x, y, timestamp, pointerId) and every vsync timestamp, in
+ * arrival order. Replaying it headlessly against a ScrollEngineManager
+ * reproduces the exact offset/velocity curve the device produced, so a
+ * scroll-feel or jank report becomes a deterministic regression case for
+ * decelerationStep, springStep and snapping.
+ *
+ * Each trace opens with a scene header — the node rects and scroll
+ * engine state captured when recording started, plus the frame rate —
+ * so a replay can rebuild the scene without the app (TouchTraceStage).
+ *
+ * Text format (one record per line, '#' starts a comment):
+ *   F <frameRateHz>                               header: display frame rate
+ *   N <id> <parentId> <flags> <x> <y> <absX> <absY> <w> <h> <scrollX> <scrollY>
+ *                                                 header: node, parents first;
+ *                                                 parentId 0 = root; flags below
+ *   E <nodeId> <flags> <snapInterval> <decelerationRate> <viewportW> <viewportH>
+ *     <contentW> <contentH> <offsetX> <offsetY> <itemsLeadingOffset> <itemCount>
+ *     <itemExtent>...                             header: scroll engine config
+ *                                                 and bounds (one line)
+ *   T <phase> <x> <y> <timestampMs> <pointerId>   phase 0..3 as onTouch
+ *   V <timestampMs> [touchClockMs]                vsync; second field is the
+ *                                                 frame time on the touch clock
+ *                                                 (for resampling), default = first
+ *
+ * JSI API:
+ *   __touchTraceStart()        begin recording (clears the previous trace)
+ *   __touchTraceStop() → text  stop recording, return the trace
+ */
+
+#pragma once
+
+#include "skia/SkiaNodeTree.h"
+#include "gestures/ScrollEngine.h"
+#include "gestures/TouchDispatcher.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zilol {
+namespace gestures {
+
+// ---------------------------------------------------------------------------
+// Trace format
+// ---------------------------------------------------------------------------
+
+struct TouchTraceEvent {
+    enum Kind : uint8_t { Touch, Vsync };
+    Kind kind = Touch;
+    int phase = 0;      // 0=began, 1=moved, 2=ended, 3=cancelled
+    float x = 0, y = 0;
+    double timestamp = 0; // ms
+    int pointerId = 0;
+    double touchClock = 0; // Vsync only: frame time on the touch clock
+};
+
+// Node flags (N records)
+static constexpr uint32_t TRACE_NODE_SCROLL = 1 << 0;
+static constexpr uint32_t TRACE_NODE_VISIBLE = 1 << 1;
+static constexpr uint32_t TRACE_NODE_TOUCHABLE = 1 << 2;
+static constexpr uint32_t TRACE_NODE_HORIZONTAL = 1 << 3;
+static constexpr uint32_t TRACE_NODE_SCROLL_ENABLED = 1 << 4;
+static constexpr uint32_t TRACE_NODE_DISPLAY_NONE = 1 << 5;
+
+// Engine flags (E records)
+static constexpr uint32_t TRACE_ENGINE_HORIZONTAL = 1 << 0;
+static constexpr uint32_t TRACE_ENGINE_BOUNCES = 1 << 1;
+static constexpr uint32_t TRACE_ENGINE_SCROLL_ENABLED = 1 << 2;
+static constexpr uint32_t TRACE_ENGINE_PAGING = 1 << 3;
+static constexpr uint32_t TRACE_ENGINE_FREE_SCROLL = 1 << 4;
+static constexpr uint32_t TRACE_ENGINE_RESAMPLING = 1 << 5;
+
+struct TraceNode {
+    int id = 0, parentId = 0;
+    uint32_t flags = TRACE_NODE_VISIBLE;
+    float x = 0, y = 0, absoluteX = 0, absoluteY = 0, width = 0, height = 0;
+    float scrollX = 0, scrollY = 0;
+};
+
+struct TraceEngine {
+    int nodeId = 0;
+    uint32_t flags = TRACE_ENGINE_BOUNCES | TRACE_ENGINE_SCROLL_ENABLED | TRACE_ENGINE_RESAMPLING;
+    float snapInterval = 0;
+    float decelerationRate = DECELERATION_RATE_NORMAL;
+    float viewportW = 0, viewportH = 0, contentW = 0, contentH = 0;
+    float offsetX = 0, offsetY = 0;
+    float itemsLeadingOffset = 0;
+    std::vector<float> itemExtents;
+};
+
+/// What the touches landed on: node rects and engine state at record start.
+struct TouchTraceScene {
+    float frameRate = 60;
+    std::vector<TraceNode> nodes; // parents before children
+    std::vector<TraceEngine> engines;
+
+    void clear() { frameRate = 60; nodes.clear(); engines.clear(); }
+
+    /// Snapshot the tree under `root` and every engine bound to a node in it.
+    void capture(skia::SkiaNode *root, ScrollEngineManager *mgr) {
+        nodes.clear();
+        engines.clear();
+        if (!root) return;
+        std::vector<skia::SkiaNode *> stack{root};
+        while (!stack.empty()) {
+            auto *node = stack.back();
+            stack.pop_back();
+            captureNode(node);
+            if (auto *engine = mgr ? mgr->findByNode(node) : nullptr) captureEngine(*engine);
+            for (size_t i = node->children.size(); i-- > 0;) stack.push_back(node->children[i]);
+        }
+    }
+
+private:
+    void captureNode(skia::SkiaNode *node) {
+        TraceNode n;
+        n.id = node->id;
+        n.parentId = node->parent ? node->parent->id : 0;
+        n.flags = (node->type == skia::NodeType::Scroll ? TRACE_NODE_SCROLL : 0)
+            | (node->visible ? TRACE_NODE_VISIBLE : 0)
+            | (node->touchable ? TRACE_NODE_TOUCHABLE : 0)
+            | (node->horizontal ? TRACE_NODE_HORIZONTAL : 0)
+            | (node->scrollEnabled ? TRACE_NODE_SCROLL_ENABLED : 0)
+            | (node->display == "none" ? TRACE_NODE_DISPLAY_NONE : 0);
+        auto &l = node->layout;
+        n.x = l.x; n.y = l.y;
+        n.absoluteX = l.absoluteX; n.absoluteY = l.absoluteY;
+        n.width = l.width; n.height = l.height;
+        n.scrollX = node->scrollX; n.scrollY = node->scrollY;
+        nodes.push_back(n);
+    }
+
+    void captureEngine(const ScrollEngine &engine) {
+        TraceEngine e;
+        e.nodeId = engine.node->id;
+        e.flags = (engine.horizontal ? TRACE_ENGINE_HORIZONTAL : 0)
+            | (engine.bounces ? TRACE_ENGINE_BOUNCES : 0)
+            | (engine.scrollEnabled ? TRACE_ENGINE_SCROLL_ENABLED : 0)
+            | (engine.pagingEnabled ? TRACE_ENGINE_PAGING : 0)
+            | (engine.freeScroll ? TRACE_ENGINE_FREE_SCROLL : 0)
+            | (engine.touchResampling ? TRACE_ENGINE_RESAMPLING : 0);
+        e.snapInterval = engine.snapInterval;
+        e.decelerationRate = engine.decelerationRate;
+        e.viewportW = engine.viewportW; e.viewportH = engine.viewportH;
+        e.contentW = engine.contentW; e.contentH = engine.contentH;
+        e.offsetX = engine.offsetX; e.offsetY = engine.offsetY;
+        e.itemsLeadingOffset = engine.itemsLeadingOffset;
+        for (int i = 0; i < engine.items.count(); i++) {
+            e.itemExtents.push_back(engine.items.offsetOf(i + 1) - engine.items.offsetOf(i));
+        }
+        engines.push_back(std::move(e));
+    }
+};
+
+class TouchTrace {
+public:
+    TouchTraceScene scene;
+    std::vector<TouchTraceEvent> events;
+
+    void addTouch(int phase, float x, float y, double timestamp, int pointerId) {
+        events.push_back({TouchTraceEvent::Touch, phase, x, y, timestamp, pointerId});
+    }
+
+    void addVsync(double timestamp, double touchClock) {
+        TouchTraceEvent e;
+        e.kind = TouchTraceEvent::Vsync;
+        e.timestamp = timestamp;
+        e.touchClock = touchClock;
+        events.push_back(e);
+    }
+
+    void clear() { scene.clear(); events.clear(); }
+
+    void write(std::ostream &out) const {
+        out.precision(17); // timestamps are double ms — keep them exact
+        out << "# zilol touch trace v2\n";
+        out << "F " << scene.frameRate << "\n";
+        for (auto &n : scene.nodes) {
+            out << "N " << n.id << " " << n.parentId << " " << n.flags << " "
+                << n.x << " " << n.y << " " << n.absoluteX << " " << n.absoluteY << " "
+                << n.width << " " << n.height << " " << n.scrollX << " " << n.scrollY << "\n";
+        }
+        for (auto &e : scene.engines) {
+            out << "E " << e.nodeId << " " << e.flags << " " << e.snapInterval << " "
+                << e.decelerationRate << " " << e.viewportW << " " << e.viewportH << " "
+                << e.contentW << " " << e.contentH << " " << e.offsetX << " " << e.offsetY << " "
+                << e.itemsLeadingOffset << " " << e.itemExtents.size();
+            for (float extent : e.itemExtents) out << " " << extent;
+            out << "\n";
+        }
+        for (auto &e : events) {
+            if (e.kind == TouchTraceEvent::Vsync) {
+                out << "V " << e.timestamp << " " << e.touchClock << "\n";
+            } else {
+                out << "T " << e.phase << " " << e.x << " " << e.y << " "
+                    << e.timestamp << " " << e.pointerId << "\n";
+            }
+        }
+    }
+
+    std::string toString() const {
+        std::ostringstream out;
+        write(out);
+        return out.str();
+    }
+
+    /// Parse a trace. Malformed lines are skipped; returns false if any were.
+    /// A v1 trace (no header) reads with an empty scene.
+    bool read(std::istream &in) {
+        clear();
+        bool ok = true;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream ls(line);
+            char kind = 0;
+            ls >> kind;
+            TouchTraceEvent e;
+            if (kind == 'V') {
+                e.kind = TouchTraceEvent::Vsync;
+                if (!(ls >> e.timestamp)) { ok = false; continue; }
+                if (!(ls >> e.touchClock)) {
+                    e.touchClock = e.timestamp; // single-clock trace
+                    ls.clear();
+                }
+            } else if (kind == 'T') {
+                ls >> e.phase >> e.x >> e.y >> e.timestamp >> e.pointerId;
+            } else if (kind == 'F') {
+                float rate = 0;
+                if (!(ls >> rate) || rate <= 0) ok = false;
+                else scene.frameRate = rate;
+                continue;
+            } else if (kind == 'N') {
+                TraceNode n;
+                ls >> n.id >> n.parentId >> n.flags >> n.x >> n.y >> n.absoluteX >> n.absoluteY
+                   >> n.width >> n.height >> n.scrollX >> n.scrollY;
+                if (ls.fail()) ok = false;
+                else scene.nodes.push_back(n);
+                continue;
+            } else if (kind == 'E') {
+                TraceEngine en;
+                size_t itemCount = 0;
+                ls >> en.nodeId >> en.flags >> en.snapInterval >> en.decelerationRate
+                   >> en.viewportW >> en.viewportH >> en.contentW >> en.contentH
+                   >> en.offsetX >> en.offsetY >> en.itemsLeadingOffset >> itemCount;
+                en.itemExtents.resize(ls.fail() ? 0 : itemCount);
+                for (auto &extent : en.itemExtents) ls >> extent;
+                if (ls.fail()) ok = false;
+                else scene.engines.push_back(std::move(en));
+                continue;
+            } else {
+                ok = false;
+                continue;
+            }
+            if (ls.fail()) { ok = false; continue; }
+            events.push_back(e);
+        }
+        return ok;
+    }
+
+    static TouchTrace fromString(const std::string &text) {
+        TouchTrace trace;
+        std::istringstream in(text);
+        trace.read(in);
+        return trace;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Recorder — fed from ZilolRuntime's onTouch / onVsync
+// ---------------------------------------------------------------------------
+
+class TouchTraceRecorder {
+public:
+    TouchTraceRecorder(ScrollEngineManager *mgr = nullptr, skia::SkiaNodeTree *tree = nullptr)
+        : mgr_(mgr), tree_(tree) {}
+
+    bool recording = false;
+    TouchTrace trace;
+
+    /// Clears the previous trace and captures the scene header.
+    void start() {
+        trace.clear();
+        if (tree_) trace.scene.capture(tree_->getRoot(), mgr_);
+        recording = true;
+    }
+
+    void stop() {
+        if (recording) trace.scene.frameRate = measureFrameRate(trace.events, trace.scene.frameRate);
+        recording = false;
+    }
+
+    void onTouch(int phase, float x, float y, double timestamp, int pointerId) {
+        if (recording) trace.addTouch(phase, x, y, timestamp, pointerId);
+    }
+
+    void onVsync(double timestamp, double touchClock) {
+        if (recording) trace.addVsync(timestamp, touchClock);
+    }
+
+    /// Median vsync rate (Hz), or `fallback` with fewer than two vsyncs.
+    static float measureFrameRate(const std::vector<TouchTraceEvent> &events, float fallback) {
+        std::vector<double> intervals;
+        double last = -1;
+        for (auto &e : events) {
+            if (e.kind != TouchTraceEvent::Vsync) continue;
+            if (last >= 0 && e.timestamp > last) intervals.push_back(e.timestamp - last);
+            last = e.timestamp;
+        }
+        if (intervals.empty()) return fallback;
+        auto mid = intervals.begin() + intervals.size() / 2;
+        std::nth_element(intervals.begin(), mid, intervals.end());
+        return static_cast<float>(1000.0 / *mid);
+    }
+
+private:
+    ScrollEngineManager *mgr_;
+    skia::SkiaNodeTree *tree_;
+};
+
+// ---------------------------------------------------------------------------
+// Stage — a trace's scene rebuilt for headless replay
+// ---------------------------------------------------------------------------
+
+/**
+ * Owns the nodes and scroll engines described by a trace's scene header,
+ * and a TouchDispatcher over them. The nodes stand alone (no
+ * SkiaNodeTree); the dispatcher hit tests them from root().
+ */
+class TouchTraceStage {
+public:
+    explicit TouchTraceStage(const TouchTraceScene &scene) : frameRate(scene.frameRate) {
+        for (auto &n : scene.nodes) {
+            auto node = std::make_unique<skia::SkiaNode>();
+            node->id = n.id;
+            node->type = (n.flags & TRACE_NODE_SCROLL) ? skia::NodeType::Scroll : skia::NodeType::View;
+            node->visible = (n.flags & TRACE_NODE_VISIBLE) != 0;
+            node->touchable = (n.flags & TRACE_NODE_TOUCHABLE) != 0;
+            node->horizontal = (n.flags & TRACE_NODE_HORIZONTAL) != 0;
+            node->scrollEnabled = (n.flags & TRACE_NODE_SCROLL_ENABLED) != 0;
+            if (n.flags & TRACE_NODE_DISPLAY_NONE) node->display = "none";
+            node->layout.x = n.x;
+            node->layout.y = n.y;
+            node->layout.absoluteX = n.absoluteX;
+            node->layout.absoluteY = n.absoluteY;
+            node->layout.width = n.width;
+            node->layout.height = n.height;
+            node->scrollX = n.scrollX;
+            node->scrollY = n.scrollY;
+            auto parent = byId_.find(n.parentId);
+            if (parent != byId_.end()) {
+                node->parent = parent->second;
+                parent->second->children.push_back(node.get());
+            } else if (!root_) {
+                root_ = node.get();
+            }
+            byId_[n.id] = node.get();
+            nodes_.push_back(std::move(node));
+        }
+        for (auto &e : scene.engines) restoreEngine(e);
+        dispatcher_.setRootNode(root_);
+        dispatcher_.setScrollManager(&mgr_);
+    }
+
+    const float frameRate;
+
+    skia::SkiaNode *root() const { return root_; }
+
+    skia::SkiaNode *node(int id) const {
+        auto it = byId_.find(id);
+        return it != byId_.end() ? it->second : nullptr;
+    }
+
+    ScrollEngineManager &manager() { return mgr_; }
+    TouchDispatcher &dispatcher() { return dispatcher_; }
+
+    /// The engine restored for the Scroll node `nodeId`, if any.
+    ScrollEngine *engineFor(int nodeId) {
+        auto *n = node(nodeId);
+        return n ? mgr_.findByNode(n) : nullptr;
+    }
+
+private:
+    ScrollEngineManager mgr_;
+    TouchDispatcher dispatcher_;
+    std::vector<std::unique_ptr<skia::SkiaNode>> nodes_;
+    std::unordered_map<int, skia::SkiaNode *> byId_;
+    skia::SkiaNode *root_ = nullptr;
+
+    void restoreEngine(const TraceEngine &e) {
+        auto *n = node(e.nodeId);
+        if (!n) return;
+        auto *engine = mgr_.create(n);
+        engine->horizontal = (e.flags & TRACE_ENGINE_HORIZONTAL) != 0;
+        engine->bounces = (e.flags & TRACE_ENGINE_BOUNCES) != 0;
+        engine->scrollEnabled = (e.flags & TRACE_ENGINE_SCROLL_ENABLED) != 0;
+        engine->pagingEnabled = (e.flags & TRACE_ENGINE_PAGING) != 0;
+        engine->freeScroll = (e.flags & TRACE_ENGINE_FREE_SCROLL) != 0;
+        engine->touchResampling = (e.flags & TRACE_ENGINE_RESAMPLING) != 0;
+        engine->snapInterval = e.snapInterval;
+        engine->decelerationRate = e.decelerationRate;
+        engine->itemsLeadingOffset = e.itemsLeadingOffset;
+        if (!e.itemExtents.empty()) engine->items.assign(e.itemExtents);
+        engine->updateBounds(e.viewportW, e.viewportH, e.contentW, e.contentH);
+        engine->offsetX = e.offsetX;
+        engine->offsetY = e.offsetY;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Replayer — drives ScrollEngines headlessly from a trace
+// ---------------------------------------------------------------------------
+
+/// One engine's state after a replayed vsync.
+struct TraceFrame {
+    double timestamp;
+    int engineId;
+    float offsetX, offsetY;
+    float velocityX, velocityY;
+    ScrollPhase phase;
+    double tickCpuUs; // tickAll + flushScrollEvents for the whole frame
+};
+
+/**
+ * Replays a trace the way the live app routes it: every touch goes
+ * through the TouchDispatcher (gesture recognizers, press handling), and
+ * each began takes the dispatcher's scroll chain at that point — the
+ * ScrollEngines from the innermost Scroll node outward, the order JS
+ * bubbling produces — which gets the touch until the pointer ends.
+ * Vsyncs run resampleDrags(), tickAll() and flushScrollEvents() and
+ * record one TraceFrame per active engine (or only `watchEngineId` when
+ * set).
+ *
+ * The began target is also reported through onHit, so a trace can
+ * assert which node a tap landed on. JS callbacks run on `rt`.
+ */
+class TouchTraceReplayer {
+public:
+    TouchTraceReplayer(ScrollEngineManager *mgr, TouchDispatcher *dispatcher,
+                       facebook::jsi::Runtime &rt)
+        : mgr_(mgr), dispatcher_(dispatcher), rt_(rt) {}
+
+    /// Replay against a scene restored from a trace header.
+    TouchTraceReplayer(TouchTraceStage &stage, facebook::jsi::Runtime &rt)
+        : mgr_(&stage.manager()), dispatcher_(&stage.dispatcher()), rt_(rt),
+          frameRate_(stage.frameRate) {}
+
+    int watchEngineId = 0; // 0 = record every active engine
+    std::function<void(int pointerId, skia::SkiaNode *hit)> onHit;
+
+    /// A trace without vsync records (e.g. written by hand) is ticked at
+    /// the scene's frame rate until every engine settles.
+    std::vector<TraceFrame> replay(const TouchTrace &trace) {
+        frames_.clear();
+        chains_.clear();
+        bool hasVsync = std::any_of(trace.events.begin(), trace.events.end(),
+            [](const TouchTraceEvent &e) { return e.kind == TouchTraceEvent::Vsync; });
+        if (!hasVsync) return replaySynthesized(trace, trace.scene.frameRate);
+        for (auto &e : trace.events) {
+            if (e.kind == TouchTraceEvent::Vsync) vsync(e.timestamp, e.touchClock);
+            else touch(e);
+        }
+        return frames_;
+    }
+
+    /// Write frames as CSV (one row per engine per vsync).
+    static void writeCsv(const std::vector<TraceFrame> &frames, std::ostream &out) {
+        out << "timestamp,engine,offsetX,offsetY,velocityX,velocityY,phase,tickCpuUs\n";
+        for (auto &f : frames) {
+            out << f.timestamp << "," << f.engineId << ","
+                << f.offsetX << "," << f.offsetY << ","
+                << f.velocityX << "," << f.velocityY << ","
+                << static_cast<int>(f.phase) << "," << f.tickCpuUs << "\n";
+        }
+    }
+
+private:
+    // Cap on synthesized frames after the last touch
+    static constexpr int MAX_SETTLE_FRAMES = 600;
+
+    ScrollEngineManager *mgr_;
+    TouchDispatcher *dispatcher_;
+    facebook::jsi::Runtime &rt_;
+    float frameRate_ = 60;
+    std::vector<TraceFrame> frames_;
+    // Pointer → engines under it at began, innermost first
+    std::unordered_map<int, std::vector<ScrollEngine *>> chains_;
+
+    void touch(const TouchTraceEvent &e) {
+        if (e.phase == 0) {
+            dispatcher_->scrollChainAt(e.x, e.y, chains_[e.pointerId]);
+            if (onHit) onHit(e.pointerId, dispatcher_->hitTest(e.x, e.y));
+        }
+        dispatcher_->dispatchTouch(e.phase, e.x, e.y, e.pointerId, rt_);
+        auto it = chains_.find(e.pointerId);
+        if (it == chains_.end()) return;
+        for (auto *engine : it->second) {
+            switch (e.phase) {
+                case 0: engine->onTouchBegan(e.pointerId, e.x, e.y, e.timestamp); break;
+                case 1: engine->onTouchMoved(e.pointerId, e.x, e.y, e.timestamp); break;
+                case 2: engine->onTouchEnded(e.pointerId, e.timestamp); break;
+                case 3: engine->onTouchCancelled(e.pointerId); break;
+            }
+        }
+        if (e.phase == 2 || e.phase == 3) chains_.erase(it);
+    }
+
+    void vsync(double timestamp, double touchClock) {
+        auto t0 = std::chrono::steady_clock::now();
+        mgr_->resampleDrags(touchClock);
+        mgr_->tickAll(timestamp);
+        mgr_->flushScrollEvents(timestamp);
+        double cpuUs = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - t0).count();
+
+        auto record = [&](ScrollEngine *engine) {
+            frames_.push_back({timestamp, engine->id, engine->offsetX, engine->offsetY,
+                               engine->reportedVelocityX(), engine->reportedVelocityY(),
+                               engine->phase, cpuUs});
+        };
+        if (watchEngineId) {
+            if (auto *engine = mgr_->get(watchEngineId)) record(engine);
+        } else {
+            mgr_->forEachActive(record);
+        }
+    }
+
+    std::vector<TraceFrame> replaySynthesized(const TouchTrace &trace, float rate) {
+        double frameMs = 1000.0 / (rate > 0 ? rate : frameRate_);
+        double t = trace.events.empty() ? 0 : trace.events.front().timestamp;
+        for (auto &e : trace.events) {
+            for (; t + frameMs <= e.timestamp; t += frameMs) vsync(t, t);
+            touch(e);
+        }
+        for (int i = 0; i < MAX_SETTLE_FRAMES; i++, t += frameMs) {
+            bool moving = false;
+            mgr_->forEachActive([&](ScrollEngine *) { moving = true; });
+            if (!moving) break;
+            vsync(t, t);
+        }
+        return frames_;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// JSI Registration
+// ---------------------------------------------------------------------------
+
+inline void registerTouchTraceHostFunctions(
+    facebook::jsi::Runtime &rt,
+    TouchTraceRecorder *recorder)
+{
+    namespace jsi = facebook::jsi;
+
+    // __touchTraceStart()
+    rt.global().setProperty(rt, "__touchTraceStart",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__touchTraceStart"), 0,
+            [recorder](jsi::Runtime &, const jsi::Value &,
+                       const jsi::Value *, size_t) -> jsi::Value {
+                recorder->start();
+                return jsi::Value::undefined();
+            }));
+
+    // __touchTraceStop() → trace text
+    rt.global().setProperty(rt, "__touchTraceStop",
+        jsi::Function::createFromHostFunction(rt,
+            jsi::PropNameID::forAscii(rt, "__touchTraceStop"), 0,
+            [recorder](jsi::Runtime &rt, const jsi::Value &,
+                       const jsi::Value *, size_t) -> jsi::Value {
+                recorder->stop();
+                return jsi::String::createFromUtf8(rt, recorder->trace.toString());
+            }));
+}
+
+} // namespace gestures
+} // namespace zilol
@@ -0,0 +1,178 @@
+/**
+ * VelocityTracker.h — touch velocity estimation.
+ *
+ * Fixed-capacity ring buffer of (timestamp, position) samples — no
+ * allocation and no shifting on the touch-move path. Shared by
+ * ScrollEngine (fling velocity) and PanRecognizer (gesture velocity).
+ *
+ * Two estimators:
+ *   - WeightedDifference: weighted mean of per-sample slopes, quadratic
+ *     age falloff (the original ScrollEngine behaviour)
+ *   - LeastSquares: polynomial fit x(t) = a + b·t + c·t² over the window,
+ *     velocity = b at the newest sample. Less sensitive to a single
+ *     noisy digitizer sample at 120 Hz.
+ *
+ * Output is always px/sec.
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace zilol {
+namespace gestures {
+
+// ---------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------
+
+static constexpr float HISTORY_WINDOW_MS = 150.0f;
+static constexpr int MAX_SAMPLES = 20;
+static constexpr int MIN_SAMPLES = 3;
+
+// ---------------------------------------------------------------------------
+// VelocityTracker
+// ---------------------------------------------------------------------------
+
+struct VelSample {
+    double timestamp; // ms — must be double to preserve Date.now() precision
+    float position;   // px
+};
+
+enum class VelocityEstimator : uint8_t {
+    WeightedDifference, LeastSquares
+};
+
+class VelocityTracker {
+public:
+    VelocityEstimator estimator = VelocityEstimator::WeightedDifference;
+    int lsqDegree = 2; // 1 = linear, 2 = quadratic
+
+    void addPoint(double timestamp, float position) {
+        if (timestamp <= lastTs_ && count_ > 0) return;
+        lastTs_ = timestamp;
+        int slot = (head_ + count_) % MAX_SAMPLES;
+        samples_[slot] = {timestamp, position};
+        if (count_ < MAX_SAMPLES) {
+            count_++;
+        } else {
+            head_ = (head_ + 1) % MAX_SAMPLES; // overwrite oldest
+        }
+    }
+
+    /// Returns velocity in px/sec (positive = increasing position)
+    float getVelocity() {
+        pruneOld();
+        return estimator == VelocityEstimator::LeastSquares
+            ? leastSquaresVelocity()
+            : weightedVelocity();
+    }
+
+    void reset() {
+        head_ = 0;
+        count_ = 0;
+        lastTs_ = 0.0;
+    }
+
+    int size() const { return count_; }
+
+private:
+    std::array<VelSample, MAX_SAMPLES> samples_{};
+    int head_ = 0;  // index of oldest sample
+    int count_ = 0;
+    double lastTs_ = 0.0;
+
+    const VelSample &at(int i) const {
+        return samples_[(head_ + i) % MAX_SAMPLES];
+    }
+
+    void pruneOld() {
+        if (count_ == 0) return;
+        double cutoff = at(count_ - 1).timestamp - (double)HISTORY_WINDOW_MS;
+        while (count_ > 0 && at(0).timestamp < cutoff) {
+            head_ = (head_ + 1) % MAX_SAMPLES;
+            count_--;
+        }
+    }
+
+    float weightedVelocity() const {
+        int n = count_;
+        if (n < MIN_SAMPLES) return 0;
+
+        double newestTs = at(n - 1).timestamp;
+        double sumW = 0, sumWV = 0;
+
+        for (int i = 1; i < n; i++) {
+            const auto &prev = at(i - 1);
+            const auto &cur = at(i);
+            double dt = cur.timestamp - prev.timestamp;
+            if (dt <= 0.5) continue; // skip duplicate timestamps
+            double vel = (cur.position - prev.position) / dt; // px/ms
+            double age = newestTs - cur.timestamp;
+            double weight = std::max(0.0, 1.0 - age / (double)HISTORY_WINDOW_MS);
+            weight *= weight; // quadratic falloff — recent samples matter more
+            sumW += weight;
+            sumWV += vel * weight;
+        }
+        // Convert px/ms → px/sec
+        return sumW > 0 ? (float)((sumWV / sumW) * 1000.0) : 0;
+    }
+
+    /// Least-squares polynomial fit, solved via the normal equations.
+    /// Time is measured relative to the newest sample (t ≤ 0) so the
+    /// linear coefficient is the instantaneous velocity at lift-off.
+    float leastSquaresVelocity() const {
+        int n = count_;
+        if (n < 2) return 0;
+
+        int degree = std::max(1, std::min(lsqDegree, n - 1));
+        degree = std::min(degree, 2);
+
+        double newestTs = at(n - 1).timestamp;
+        double newestPos = at(n - 1).position;
+
+        // Power sums S[k] = Σ t^k (k = 0..4), T[k] = Σ x·t^k (k = 0..2)
+        double S[5] = {0, 0, 0, 0, 0};
+        double T[3] = {0, 0, 0};
+        for (int i = 0; i < n; i++) {
+            const auto &s = at(i);
+            double t = s.timestamp - newestTs;
+            double x = s.position - newestPos;
+            double tk = 1.0;
+            for (int k = 0; k <= 2 * degree; k++) {
+                S[k] += tk;
+                if (k <= degree) T[k] += x * tk;
+                tk *= t;
+            }
+        }
+
+        double b = 0;
+        if (degree == 2) {
+            // | S0 S1 S2 | |a|   |T0|
+            // | S1 S2 S3 | |b| = |T1|
+            // | S2 S3 S4 | |c|   |T2|
+            double det = S[0] * (S[2] * S[4] - S[3] * S[3])
+                       - S[1] * (S[1] * S[4] - S[3] * S[2])
+                       + S[2] * (S[1] * S[3] - S[2] * S[2]);
+            if (std::abs(det) > 1e-9) {
+                double detB = S[0] * (T[1] * S[4] - S[3] * T[2])
+                            - T[0] * (S[1] * S[4] - S[3] * S[2])
+                            + S[2] * (S[1] * T[2] - T[1] * S[2]);
+                b = detB / det;
+                return (float)(b * 1000.0);
+            }
+            // Degenerate (e.g. coincident timestamps) — fall back to linear
+        }
+
+        double det = S[0] * S[2] - S[1] * S[1];
+        if (std::abs(det) <= 1e-9) return 0;
+        b = (S[0] * T[1] - S[1] * T[0]) / det;
+        return (float)(b * 1000.0);
+    }
+};
+
+} // namespace gestures
+} // namespace zilol
@@ -17,7 +17,11 @@
 #include "skia/SkiaNodeRenderer.h"
 #include "gestures/ScrollEngine.h"
 #include "gestures/TouchDispatcher.h"
+#include "gestures/TouchTrace.h"
 #include "animation/AnimationTicker.h"
+#include "animation/ValueGraph.h"
+#include "animation/AnimationTimeline.h"
+#include "animation/SharedValues.h"
 #include "platform/PlatformHostFunctions.h"
 
 // Hermes
@@ -50,7 +54,11 @@ static std::unique_ptr<skia::SkiaNodeTree> sNodeTree;
 static std::unique_ptr<skia::SkiaNodeRenderer> sNodeRenderer;
 static std::unique_ptr<gestures::ScrollEngineManager> sScrollManager;
 static std::unique_ptr<animation::AnimationTicker> sAnimTicker;
+static std::unique_ptr<animation::ValueGraphRunner> sValueGraphs;
+static std::unique_ptr<animation::AnimationTimelineSession> sAnimTimeline;
+static std::unique_ptr<animation::SharedValueStore> sSharedValues;
 static std::unique_ptr<gestures::TouchDispatcher> sTouchDispatcher;
+static std::unique_ptr<gestures::TouchTraceRecorder> sTouchTrace;
 
 // Frame callbacks: map of ID → JS callback
 static std::mutex sFrameMutex;
@@ -84,6 +92,13 @@ static double currentTimeMs() {
     return std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
 }
 
+// Touch events reach the scroll engines stamped with JS Date.now(), so
+// touch resampling needs each frame's time on that clock.
+static double wallClockMs() {
+    auto now = std::chrono::system_clock::now();
+    return std::chrono::duration<double, std::milli>(now.time_since_epoch()).count();
+}
+
 // Microtask queue (for async callbacks from background threads)
 static std::mutex sMicrotaskMutex;
 static std::vector<std::function<void(jsi::Runtime&)>> sMicrotasks;
@@ -126,12 +141,34 @@ void initialize(std::unique_ptr<skia::SkiaRenderer> renderer) {
     // 2e. Create animation ticker, register JSI API
     sAnimTicker = std::make_unique<animation::AnimationTicker>();
     animation::registerAnimationHostFunctions(rt, sAnimTicker.get(), sNodeTree.get());
+    sValueGraphs = std::make_unique<animation::ValueGraphRunner>(
+        sScrollManager.get(), sAnimTicker.get());
+    animation::registerValueGraphHostFunctions(rt, sValueGraphs.get(), sNodeTree.get());
+    sAnimTimeline = std::make_unique<animation::AnimationTimelineSession>(
+        sAnimTicker.get(), sScrollManager.get());
+    animation::registerAnimationTimelineHostFunctions(rt, sAnimTimeline.get(), sNodeTree.get());
 
     // 2f. Create touch dispatcher, register JSI API
     sTouchDispatcher = std::make_unique<gestures::TouchDispatcher>();
     sTouchDispatcher->setNodeTree(sNodeTree.get());
+    sTouchDispatcher->setScrollManager(sScrollManager.get());
+    sTouchDispatcher->setAnimationTicker(sAnimTicker.get());
     gestures::registerTouchDispatcherHostFunctions(rt, sTouchDispatcher.get());
 
+    // Shared values — written by animations, scroll engines and gestures
+    sSharedValues = std::make_unique<animation::SharedValueStore>(
+        sAnimTicker.get(), sScrollManager.get(), sTouchDispatcher.get());
+    sValueGraphs->setSharedValues(sSharedValues.get());
+    sScrollManager->onEngineRemoved = [](int engineId) {
+        if (sSharedValues) sSharedValues->onScrollRemoved(engineId);
+    };
+    animation::registerSharedValueHostFunctions(rt, sSharedValues.get());
+
+    // 2g. Touch trace recorder (replayed headlessly by TouchTraceReplayer)
+    sTouchTrace = std::make_unique<gestures::TouchTraceRecorder>(
+        sScrollManager.get(), sNodeTree.get());
+    gestures::registerTouchTraceHostFunctions(rt, sTouchTrace.get());
+
     // 2b. Register console object (Hermes doesn't provide it)
     {
         auto console = jsi::Object(rt);
@@ -394,6 +431,8 @@ void evaluateJSFile(const std::string &path) {
 
 void onVsync(double timestampMs) {
     if (!sRuntime) return;
+    double touchClockMs = wallClockMs();
+    if (sTouchTrace) sTouchTrace->onVsync(timestampMs, touchClockMs);
 
     // Track vsync ticks (always counted, even when not rendering)
     sVsyncTickCount++;
@@ -492,13 +531,29 @@ void onVsync(double timestampMs) {
 
     // ── C++ SCROLL ENGINE TICK ───────────────────────────────
     if (sScrollManager) {
+        sScrollManager->resampleDrags(touchClockMs);
         sScrollManager->tickAll(timestampMs);
+        // Coalesced onScroll delivery — one batched JS call per frame
+        sScrollManager->flushScrollEvents(timestampMs);
     }
 
     // ── C++ ANIMATION TICK ─────────────────────────────────
-    if (sAnimTicker && sAnimTicker->hasActive()) {
+    // Paused while a recorded timeline is being scrubbed
+    bool live = !sAnimTimeline || sAnimTimeline->beginFrame(timestampMs);
+    if (sAnimTicker && sAnimTicker->hasActive() && live) {
         sAnimTicker->tickAll(static_cast<float>(timestampMs), sRuntime.get());
     }
+    // Pan drive releases moved nodes — keep hit testing on them
+    if (sTouchDispatcher) sTouchDispatcher->onAnimationFrame();
+
+    // ── DERIVED VALUES ─────────────────────────────────────
+    // After both ticks, so graphs read this frame's offsets and values
+    if (sValueGraphs && !sValueGraphs->empty()) {
+        sValueGraphs->evaluateAll();
+    }
+
+    // ── ANIMATION TIMELINE ─────────────────────────────────
+    if (sAnimTimeline) sAnimTimeline->recorder.onFrame(timestampMs);
 
     // ── C++ NODE TREE RENDERING ──────────────────────────────
     if (sNodeTree && sNodeRenderer) {
@@ -527,6 +582,7 @@ void onVsync(double timestampMs) {
 
 void onTouch(int phase, float x, float y, int pointerId) {
     if (!sRuntime) return;
+    if (sTouchTrace) sTouchTrace->onTouch(phase, x, y, wallClockMs(), pointerId);
 
     // Dispatch to C++ TouchDispatcher (hit testing + press callbacks)
     if (sTouchDispatcher) {